@@ -22,6 +22,26 @@ unsigned g_ColorCount = 7;
 ViewRect g_ViewRect = { 0, 0, 0, 0 };
 bool g_InitializedViewRect = false;
 
+// Reads the time and state of a solution file written with element type T,
+// converting them to FP.
+template <class T>
+void ReadElements(std::istream& in, FP& t, Vec<FP>& y) {
+	T tt;
+	long size;
+	in.read((char*)&tt, sizeof(tt));
+	in.read((char*)&size, sizeof(size));
+	if( !in || size < 0 )
+		throw Exception() << "Corrupt solution file.";
+
+	std::vector<T> data(size);
+	in.read((char*)data.data(), sizeof(T)*size);
+
+	t = tt;
+	y.Resize(size);
+	for( long i = 0; i < size; i++ )
+		y[i] = data[i];
+}
+
 void ReadFile(std::string filename, SolutionPoint& solutionPoint, Hash<ParamValue>& params) {
 	ParamValue* pv;
 	long offset = 0; if( (pv = params.Get("solution offset")) ) offset = pv->GetLong();
@@ -33,11 +53,28 @@ void ReadFile(std::string filename, SolutionPoint& solutionPoint, Hash<ParamValu
 	
 	if( !file.is_open() )
 		throw Exception() << "Unable to open " << filename << ".";
-    
-	file.read((char*)&solutionPoint.t, sizeof(solutionPoint.t));
+
+	char magic[SOLUTION_MAGIC_LENGTH];
+	char tag = 'd';
+	file.read(magic, SOLUTION_MAGIC_LENGTH);
+	if( file && memcmp(magic, SOLUTION_MAGIC, SOLUTION_MAGIC_LENGTH) == 0 )
+		file.read(&tag, sizeof(tag));
+	else {
+		file.clear();
+		file.seekg(0);
+	}
 
 	Vec<FP> tempVec;
-	file >> tempVec;
+	switch( tag ) {
+	case 'f': ReadElements<float>(file, solutionPoint.t, tempVec); break;
+	case 'd': ReadElements<double>(file, solutionPoint.t, tempVec); break;
+	case 'l': ReadElements<long double>(file, solutionPoint.t, tempVec); break;
+#ifdef __SIZEOF_FLOAT128__
+	case 'q': ReadElements<__float128>(file, solutionPoint.t, tempVec); break;
+#endif
+	default:
+		throw Exception() << filename << " has unsupported element type '" << tag << "'.";
+	}
 	file.close();
 
 	if( count < 0 ) count = ceil(FP(tempVec.Size()-offset)/stride);
@@ -1,6 +1,12 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+// The quad overloads must be declared before <complex> is parsed.
+#ifdef FP_QUAD
+	#include <core/quad.h>
+	#define FP_TYPE __float128
+#endif
+
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
@@ -20,7 +26,31 @@
 #include <sys/time.h>
 #include <unistd.h>
 
-typedef double FP;
+// The scalar type is chosen at build time (see the build script's precision
+// options). Everything else is written against FP.
+#ifndef FP_TYPE
+	#define FP_TYPE double
+#endif
+
+typedef FP_TYPE FP;
+
+// Pull the float and long double overloads of the math library into the
+// global namespace so unqualified calls do not silently round to double.
+using std::fabs;
+using std::sqrt;
+using std::exp;
+using std::log;
+using std::pow;
+using std::sin;
+using std::cos;
+using std::sinh;
+using std::cosh;
+using std::acos;
+using std::acosh;
+using std::atan2;
+using std::fmax;
+using std::fmin;
+using std::fmod;
 typedef std::complex<FP> CFP;
 
 inline void clamp(FP& v, FP mi, FP ma) {
@@ -0,0 +1,64 @@
+#ifndef FIXED_MAT_H
+#define FIXED_MAT_H
+
+#include <core/common.h>
+#include <core/fixedvec.h>
+
+// Dense N x N matrix on the stack with an in-place LU factorization, for the
+// Newton iterations of implicit methods on small systems.
+template <class T, long N>
+class FixedMat {
+	T _elements[N][N];
+	long _pivot[N];
+
+public:
+	inline const T operator()(long i, long j) const { return _elements[i][j]; }
+	inline T& operator()(long i, long j) { return _elements[i][j]; }
+
+	void Zero() {
+		for( long i = 0; i < N; i++ )
+			for( long j = 0; j < N; j++ )
+				_elements[i][j] = 0;
+	}
+
+	// LU with partial pivoting, overwriting the matrix
+	void Factor() {
+		for( long k = 0; k < N; k++ ) {
+			long p = k;
+			for( long i = k+1; i < N; i++ )
+				if( fabs(_elements[i][k]) > fabs(_elements[p][k]) )
+					p = i;
+			_pivot[k] = p;
+
+			if( p != k )
+				for( long j = 0; j < N; j++ )
+					std::swap(_elements[k][j], _elements[p][j]);
+
+			for( long i = k+1; i < N; i++ ) {
+				T l = _elements[i][k] /= _elements[k][k];
+				for( long j = k+1; j < N; j++ )
+					_elements[i][j] -= l*_elements[k][j];
+			}
+		}
+	}
+
+	// Solves with the factors computed by Factor()
+	void Solve(const FixedVec<T,N>& b, FixedVec<T,N>& x) const {
+		x = b;
+		for( long k = 0; k < N; k++ )
+			if( _pivot[k] != k )
+				std::swap(x[k], x[_pivot[k]]);
+
+		for( long i = 1; i < N; i++ )
+			for( long j = 0; j < i; j++ )
+				x[i] -= _elements[i][j]*x[j];
+
+		for( long i = N-1; i >= 0; i-- ) {
+			for( long j = i+1; j < N; j++ )
+				x[i] -= _elements[i][j]*x[j];
+			x[i] /= _elements[i][i];
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef FIXED_VEC_H
+#define FIXED_VEC_H
+
+#include <core/common.h>
+#include <core/vec.h>
+
+// A vector whose size is known at compile time. It lives on the stack, has no
+// virtual functions and every loop has a constant trip count, so for the small
+// systems it is meant for the compiler unrolls the loops completely. The
+// interface mirrors the parts of Vec<T> used by IVP kernels, so templated RHS
+// functions can be instantiated on either.
+template <class T, long N>
+class FixedVec {
+	T _elements[N];
+
+public:
+	FixedVec() { }
+
+	// Size argument for interchangeability with Vec<T>
+	explicit FixedVec(long size) { }
+
+	FixedVec(const Vec<T>& v) {
+		for( long i = 0; i < N; i++ )
+			_elements[i] = v[i];
+	}
+
+	long Size() const {
+		return N;
+	}
+
+	void Zero() {
+		for( long i = 0; i < N; i++ )
+			_elements[i] = 0;
+	}
+
+	void CopyTo(Vec<T>& v) const {
+		for( long i = 0; i < N; i++ )
+			v[i] = _elements[i];
+	}
+
+	inline const T operator[](long i) const { return _elements[i]; }
+	inline T& operator[](long i) { return _elements[i]; }
+	inline const T operator()(long i) const { return _elements[i]; }
+	inline T& operator()(long i) { return _elements[i]; }
+
+	FixedVec& operator+=(const FixedVec& v) {
+		for( long i = 0; i < N; i++ )
+			_elements[i] += v._elements[i];
+		return *this;
+	}
+
+	FixedVec& operator-=(const FixedVec& v) {
+		for( long i = 0; i < N; i++ )
+			_elements[i] -= v._elements[i];
+		return *this;
+	}
+
+	FixedVec& operator*=(const T& c) {
+		for( long i = 0; i < N; i++ )
+			_elements[i] *= c;
+		return *this;
+	}
+
+	FixedVec& operator/=(const T& c) {
+		for( long i = 0; i < N; i++ )
+			_elements[i] /= c;
+		return *this;
+	}
+
+	void AddScaled(T s, const FixedVec& v) {
+		for( long i = 0; i < N; i++ )
+			_elements[i] += s*v._elements[i];
+	}
+
+	T InfNorm() const {
+		T norm = 0;
+		for( long i = 0; i < N; i++ ) {
+			T temp = fabs(_elements[i]);
+			if( temp > norm )
+				norm = temp;
+		}
+		return norm;
+	}
+
+	bool IsNan() const {
+		for( long i = 0; i < N; i++ )
+			if( _elements[i] != _elements[i] )
+				return true;
+		return false;
+	}
+};
+
+#endif
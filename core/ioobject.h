@@ -5,6 +5,20 @@
 
 #define UID_LENGTH 8
 
+// Solution files start with this magic followed by a one character tag naming
+// the element type they were written with, so that a build of any precision
+// can read them. Files without the magic are the original double layout.
+#define SOLUTION_MAGIC "PODE"
+#define SOLUTION_MAGIC_LENGTH 4
+
+template <class T> struct ElementTag;
+template <> struct ElementTag<float> { static char Value() { return 'f'; } };
+template <> struct ElementTag<double> { static char Value() { return 'd'; } };
+template <> struct ElementTag<long double> { static char Value() { return 'l'; } };
+#ifdef FP_QUAD
+template <> struct ElementTag<__float128> { static char Value() { return 'q'; } };
+#endif
+
 class IOObject {
 protected:
 	virtual void Dump(std::ostream &out) const = 0;
@@ -0,0 +1,178 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <core/common.h>
+
+// Number of ensemble members packed into one lane vector. Wider lanes only pay
+// off when the compiler is allowed to use matching vector registers, so this
+// is left as a build flag (e.g. -DENSEMBLE_WIDTH=8 together with -march=native).
+#ifndef ENSEMBLE_WIDTH
+	#define ENSEMBLE_WIDTH 4
+#endif
+
+template <int W>
+class LaneMask {
+	bool _v[W];
+
+public:
+	LaneMask() { }
+	LaneMask(bool b) {
+		for( int l = 0; l < W; l++ ) _v[l] = b;
+	}
+
+	inline bool operator[](int l) const { return _v[l]; }
+	inline bool& operator[](int l) { return _v[l]; }
+
+	friend LaneMask operator&(const LaneMask& a, const LaneMask& b) {
+		LaneMask r;
+		for( int l = 0; l < W; l++ ) r._v[l] = a._v[l] && b._v[l];
+		return r;
+	}
+
+	friend LaneMask operator|(const LaneMask& a, const LaneMask& b) {
+		LaneMask r;
+		for( int l = 0; l < W; l++ ) r._v[l] = a._v[l] || b._v[l];
+		return r;
+	}
+
+	friend LaneMask operator!(const LaneMask& a) {
+		LaneMask r;
+		for( int l = 0; l < W; l++ ) r._v[l] = !a._v[l];
+		return r;
+	}
+
+	friend bool AllOf(const LaneMask& a) {
+		for( int l = 0; l < W; l++ )
+			if( !a._v[l] ) return false;
+		return true;
+	}
+
+	friend bool AnyOf(const LaneMask& a) {
+		for( int l = 0; l < W; l++ )
+			if( a._v[l] ) return true;
+		return false;
+	}
+};
+
+// A fixed number of scalars evaluated in lock step. IVP kernels written as
+// templates on their scalar type can be instantiated on Lanes to evaluate
+// several independent problems with one call. All loops have a compile time
+// trip count, so the compiler is free to map them onto vector instructions.
+template <class T, int W>
+class Lanes {
+	T _v[W];
+
+public:
+	typedef LaneMask<W> Mask;
+	static const int Width = W;
+
+	Lanes() { }
+	Lanes(const T& s) {
+		for( int l = 0; l < W; l++ ) _v[l] = s;
+	}
+
+	inline T operator[](int l) const { return _v[l]; }
+	inline T& operator[](int l) { return _v[l]; }
+
+#define LANES_ASSIGN_OP(op) \
+	Lanes& operator op(const Lanes& b) { \
+		for( int l = 0; l < W; l++ ) _v[l] op b._v[l]; \
+		return *this; \
+	}
+	LANES_ASSIGN_OP(+=)
+	LANES_ASSIGN_OP(-=)
+	LANES_ASSIGN_OP(*=)
+	LANES_ASSIGN_OP(/=)
+#undef LANES_ASSIGN_OP
+
+	friend Lanes operator-(const Lanes& a) {
+		Lanes r;
+		for( int l = 0; l < W; l++ ) r._v[l] = -a._v[l];
+		return r;
+	}
+
+#define LANES_BINARY_OP(op) \
+	friend Lanes operator op(const Lanes& a, const Lanes& b) { \
+		Lanes r; \
+		for( int l = 0; l < W; l++ ) r._v[l] = a._v[l] op b._v[l]; \
+		return r; \
+	}
+	LANES_BINARY_OP(+)
+	LANES_BINARY_OP(-)
+	LANES_BINARY_OP(*)
+	LANES_BINARY_OP(/)
+#undef LANES_BINARY_OP
+
+#define LANES_COMPARE_OP(op) \
+	friend Mask operator op(const Lanes& a, const Lanes& b) { \
+		Mask r; \
+		for( int l = 0; l < W; l++ ) r[l] = a._v[l] op b._v[l]; \
+		return r; \
+	}
+	LANES_COMPARE_OP(<)
+	LANES_COMPARE_OP(<=)
+	LANES_COMPARE_OP(>)
+	LANES_COMPARE_OP(>=)
+	LANES_COMPARE_OP(==)
+	LANES_COMPARE_OP(!=)
+#undef LANES_COMPARE_OP
+
+#define LANES_UNARY_FUNC(func) \
+	friend Lanes func(const Lanes& a) { \
+		Lanes r; \
+		for( int l = 0; l < W; l++ ) r._v[l] = std::func(a._v[l]); \
+		return r; \
+	}
+	LANES_UNARY_FUNC(fabs)
+	LANES_UNARY_FUNC(sqrt)
+	LANES_UNARY_FUNC(exp)
+	LANES_UNARY_FUNC(log)
+	LANES_UNARY_FUNC(sin)
+	LANES_UNARY_FUNC(cos)
+	LANES_UNARY_FUNC(tan)
+	LANES_UNARY_FUNC(sinh)
+	LANES_UNARY_FUNC(cosh)
+	LANES_UNARY_FUNC(tanh)
+	LANES_UNARY_FUNC(floor)
+	LANES_UNARY_FUNC(ceil)
+#undef LANES_UNARY_FUNC
+
+#define LANES_BINARY_FUNC(func) \
+	friend Lanes func(const Lanes& a, const Lanes& b) { \
+		Lanes r; \
+		for( int l = 0; l < W; l++ ) r._v[l] = std::func(a._v[l], b._v[l]); \
+		return r; \
+	}
+	LANES_BINARY_FUNC(pow)
+	LANES_BINARY_FUNC(fmax)
+	LANES_BINARY_FUNC(fmin)
+	LANES_BINARY_FUNC(atan2)
+	LANES_BINARY_FUNC(fmod)
+#undef LANES_BINARY_FUNC
+
+	friend Lanes Select(const Mask& m, const Lanes& a, const Lanes& b) {
+		Lanes r;
+		for( int l = 0; l < W; l++ ) r._v[l] = m[l] ? a._v[l] : b._v[l];
+		return r;
+	}
+
+	friend std::ostream& operator<<(std::ostream& out, const Lanes& a) {
+		out << "(";
+		for( int l = 0; l < W; l++ )
+			out << (l ? "," : "") << a._v[l];
+		return out << ")";
+	}
+};
+
+typedef Lanes<FP,ENSEMBLE_WIDTH> LFP;
+
+// Scalar counterparts, so that a kernel written against the lane interface
+// still compiles when it is instantiated on FP.
+template <class T> struct MaskOf { typedef bool Type; };
+template <class T, int W> struct MaskOf< Lanes<T,W> > { typedef LaneMask<W> Type; };
+
+inline FP Select(bool m, FP a, FP b) { return m ? a : b; }
+inline bool AllOf(bool m) { return m; }
+inline bool AnyOf(bool m) { return m; }
+
+#endif
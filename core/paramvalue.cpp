@@ -81,7 +81,7 @@ FP ParamValue::GetFP() {
 const char* ParamValue::GetString() {
 	if( !_strValue ) {
 		char buf[128];
-		long len = snprintf(buf,sizeof(buf),"%f",_floatValue);
+		long len = snprintf(buf,sizeof(buf),"%f",(double)_floatValue);
 		_strValue = new char[len+1];
 		strcpy(_strValue,buf);
 	}
@@ -162,6 +162,6 @@ const char* SetDefaultString(Hash<ParamValue>& params, const char* name, const c
 const char* GetDefaultString(Hash<ParamValue>& params, const char* name, const char* d) {
 	ParamValue* pv = params.Get(name);
 	if( pv ) return pv->GetString();
-	return params[name].GetString();
+	return d;
 }
 
@@ -0,0 +1,100 @@
+#ifndef QUAD_H
+#define QUAD_H
+
+// Support for building with FP = __float128. libstdc++ provides neither the
+// math overloads, numeric_limits nor stream operators for the quad type, so
+// they are supplied here on top of libquadmath. They live in namespace std so
+// that std::complex<__float128> and qualified calls find them as well.
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <quadmath.h>
+
+namespace std {
+	inline __float128 fabs(__float128 x) { return fabsq(x); }
+	inline __float128 sqrt(__float128 x) { return sqrtq(x); }
+	inline __float128 exp(__float128 x) { return expq(x); }
+	inline __float128 log(__float128 x) { return logq(x); }
+	inline __float128 pow(__float128 x, __float128 y) { return powq(x,y); }
+	inline __float128 sin(__float128 x) { return sinq(x); }
+	inline __float128 cos(__float128 x) { return cosq(x); }
+	inline __float128 tan(__float128 x) { return tanq(x); }
+	inline __float128 sinh(__float128 x) { return sinhq(x); }
+	inline __float128 cosh(__float128 x) { return coshq(x); }
+	inline __float128 tanh(__float128 x) { return tanhq(x); }
+	inline __float128 acos(__float128 x) { return acosq(x); }
+	inline __float128 acosh(__float128 x) { return acoshq(x); }
+	inline __float128 atan(__float128 x) { return atanq(x); }
+	inline __float128 atan2(__float128 y, __float128 x) { return atan2q(y,x); }
+	inline __float128 hypot(__float128 x, __float128 y) { return hypotq(x,y); }
+	inline __float128 fmax(__float128 x, __float128 y) { return fmaxq(x,y); }
+	inline __float128 fmin(__float128 x, __float128 y) { return fminq(x,y); }
+	inline __float128 floor(__float128 x) { return floorq(x); }
+	inline __float128 ceil(__float128 x) { return ceilq(x); }
+	inline __float128 copysign(__float128 x, __float128 y) { return copysignq(x,y); }
+	inline __float128 fmod(__float128 x, __float128 y) { return fmodq(x,y); }
+
+	// Mixed calls such as pow(y, 0.5) would otherwise be ambiguous between the
+	// double, long double and quad overloads.
+	template <class U>
+	struct QuadPromote : enable_if<is_arithmetic<U>::value && !is_same<U,__float128>::value, __float128> { };
+
+	template <class U> inline typename QuadPromote<U>::type pow(__float128 x, U y) { return powq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type pow(U x, __float128 y) { return powq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type fmax(__float128 x, U y) { return fmaxq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type fmax(U x, __float128 y) { return fmaxq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type fmin(__float128 x, U y) { return fminq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type fmin(U x, __float128 y) { return fminq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type atan2(__float128 y, U x) { return atan2q(y,x); }
+	template <class U> inline typename QuadPromote<U>::type atan2(U y, __float128 x) { return atan2q(y,x); }
+	template <class U> inline typename QuadPromote<U>::type fmod(__float128 x, U y) { return fmodq(x,y); }
+	template <class U> inline typename QuadPromote<U>::type fmod(U x, __float128 y) { return fmodq(x,y); }
+
+	inline __float128 scalbn(__float128 x, int n) { return scalbnq(x,n); }
+	inline int ilogb(__float128 x) { return ilogbq(x); }
+	inline bool isnan(__float128 x) { return isnanq(x); }
+	inline bool isinf(__float128 x) { return isinfq(x); }
+
+	template <> struct numeric_limits<__float128> {
+		static const bool is_specialized = true;
+		static const bool is_signed = true;
+		static const bool is_integer = false;
+		static const bool is_exact = false;
+		static const bool has_infinity = true;
+		static const bool has_quiet_NaN = true;
+		static const int digits = FLT128_MANT_DIG;
+		static const int digits10 = FLT128_DIG;
+		static const int max_digits10 = 36;
+		static const int radix = 2;
+		static __float128 min() { return FLT128_MIN; }
+		static __float128 max() { return FLT128_MAX; }
+		static __float128 lowest() { return -FLT128_MAX; }
+		static __float128 epsilon() { return FLT128_EPSILON; }
+		static __float128 infinity() { return __builtin_infq(); }
+		static __float128 quiet_NaN() { return nanq(""); }
+	};
+
+	inline ostream& operator<<(ostream& out, __float128 x) {
+		char buf[128];
+		char fmt[32];
+		if( out.flags() & ios::fixed )
+			snprintf(fmt, sizeof(fmt), "%%.%dQf", (int)out.precision());
+		else
+			snprintf(fmt, sizeof(fmt), "%%.%dQg", (int)out.precision());
+		quadmath_snprintf(buf, sizeof(buf), fmt, x);
+		return out << buf;
+	}
+
+	inline istream& operator>>(istream& in, __float128& x) {
+		string s;
+		if( in >> s )
+			x = strtoflt128(s.c_str(), 0);
+		return in;
+	}
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include <core/exception.h>
+#include <core/threadpool.h>
+
+ThreadPool::ThreadPool(long threads) : _body(0), _count(0), _next(0), _busy(0), _generation(0), _shutdown(false), _failed(false) {
+	if( threads <= 0 )
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for( long i = 1; i < threads; i++ )
+		_workers.push_back(std::thread(&ThreadPool::Worker, this));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_shutdown = true;
+	}
+	_wake.notify_all();
+
+	for( size_t i = 0; i < _workers.size(); i++ )
+		_workers[i].join();
+}
+
+long ThreadPool::Size() const {
+	return _workers.size() + 1;
+}
+
+void ThreadPool::Drain() {
+	for( long i = _next++; i < _count; i = _next++ ) {
+		try {
+			(*_body)(i);
+		} catch(Exception e) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if( !_failed ) {
+				_failed = true;
+				_error = e.operator std::string();
+			}
+			_next = _count;
+		} catch(std::exception& e) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if( !_failed ) {
+				_failed = true;
+				_error = e.what();
+			}
+			_next = _count;
+		}
+	}
+}
+
+void ThreadPool::Worker() {
+	unsigned long seen = 0;
+	for( ;; ) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while( !_shutdown && seen == _generation )
+				_wake.wait(lock);
+			if( _shutdown )
+				return;
+			seen = _generation;
+		}
+
+		Drain();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if( --_busy == 0 )
+			_done.notify_all();
+	}
+}
+
+void ThreadPool::ParallelFor(long n, const std::function<void(long)>& body) {
+	if( _workers.empty() ) {
+		for( long i = 0; i < n; i++ )
+			body(i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_body = &body;
+		_count = n;
+		_next = 0;
+		_busy = _workers.size();
+		_failed = false;
+		_generation++;
+	}
+	_wake.notify_all();
+
+	Drain();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	while( _busy )
+		_done.wait(lock);
+	_body = 0;
+
+	if( _failed )
+		throw Exception() << _error;
+}
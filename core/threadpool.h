@@ -0,0 +1,42 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <core/common.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// A fixed set of worker threads that execute the iterations of a loop. The
+// calling thread takes part in the work, so a pool of size one runs serially
+// without any synchronization. ParallelFor is not reentrant.
+class ThreadPool {
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+
+	const std::function<void(long)>* _body;
+	long _count;
+	std::atomic<long> _next;
+	long _busy;
+	unsigned long _generation;
+	bool _shutdown;
+
+	bool _failed;
+	std::string _error;
+
+	void Worker();
+	void Drain();
+
+public:
+	ThreadPool(long threads = 0);
+	~ThreadPool();
+
+	long Size() const;
+	void ParallelFor(long n, const std::function<void(long)>& body);
+};
+
+#endif
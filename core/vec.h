@@ -403,6 +403,22 @@ public:
 			_elements[i] += s*v._elements[i];
 	}
 
+	// this = a[0] v[0] + ... + a[N-1] v[N-1] in one pass, so this may be one of v
+	template <int N>
+	void Combine(const T* a, const Vec<T>* const* v) {
+#ifdef DEBUGBUILD
+		for( int k = 0; k < N; k++ )
+			if( _size != v[k]->Size() )
+				throw Exception() << "Combining vectors of incompatible size.";
+#endif
+		for( long i = 0; i < _size; i++ ) {
+			T sum = a[0]*v[0]->_elements[i];
+			for( int k = 1; k < N; k++ )
+				sum += a[k]*v[k]->_elements[i];
+			_elements[i] = sum;
+		}
+	}
+
 	// Input/ Output
 	virtual void PrintMatlab(std::ostream &out = std::cout) const {
 		out << "[" << std::endl;
@@ -191,7 +191,7 @@ public:
 		{
 			for(long j = 0; j < N; j++)
 			{
-				_initialCondition[N * i + j] = exactSolution(delta * (j + 1),
+				_initialCondition[N * i + j] = exactSolution<FP>(delta * (j + 1),
 					delta * (i + 1), 0.);
 			}
 		}
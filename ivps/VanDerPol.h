@@ -39,8 +39,8 @@ protected:
 		}
 	}
 
-	template <class T>
-	void Split1Internal(const T t, const Vec<T>& y, Vec<T>& yp)
+	template <class T, class V>
+	void Split1Internal(const T t, const V& y, V& yp)
 	{
 		T Y = y[0];
 		T Z = y[1];
@@ -48,13 +48,25 @@ protected:
 		yp[1] = ((1 - Y * Y) * Z - Y) / epsilon;
 	}
 
-	template <class T>
-	void Split2Internal(const T t, const Vec<T>& y, Vec<T>& yp)
+	template <class T, class V>
+	void Split2Internal(const T t, const V& y, V& yp)
 	{
 		yp[0] = y[1];
 		yp[1] = 0;
 	}
 
+	// Unsplit right-hand side for FixedSolver
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp)
+	{
+		V split2(y.Size());
+		Split1Internal(t, y, yp);
+		Split2Internal(t, y, split2);
+		yp += split2;
+	}
+
+	FIXED_KERNEL
+
 public:
 	VanDerPol(Hash<ParamValue>& params) : TwoSplittingIVP(params)
 	{
@@ -65,6 +77,8 @@ public:
 	}
 
 	LINK_TWOSPLIT
+	LINK_TWOSPLIT_LANES
+	THREAD_SAFE_RHS
 	IVP_NAME("Van der Pol Equation")
 };
 
@@ -60,22 +60,22 @@ protected:
 			if(split == 0 || split == 2)
 			{
 				if(i <= N - 1)
-					d = exactSolution(delta * (i + 1), 0., t);
+					d = exactSolution<FP>(delta * (i + 1), 0., t);
 				else
 					d = y[i - N];
 
 				if(i % N == 0)
-					l = exactSolution(0., delta * (i / N + 1), t);
+					l = exactSolution<FP>(0., delta * (i / N + 1), t);
 				else
 					l = y[i - 1];
 
 				if(i % N == N - 1)
-					r = exactSolution(0.5, delta * (i / N + 1), t);
+					r = exactSolution<FP>(0.5, delta * (i / N + 1), t);
 				else
 					r = y[i + 1];
 
 				if(i >= N * N - N)
-					u = exactSolution(delta * (i % N + 1), 0.5, t);
+					u = exactSolution<FP>(delta * (i % N + 1), 0.5, t);
 				else
 					u = y[i + N];
 
@@ -204,7 +204,7 @@ public:
 		{
 			for(long j = 0; j < N; j++)
 			{
-				_initialCondition[N * i + j] = exactSolution(delta * (j + 1),
+				_initialCondition[N * i + j] = exactSolution<FP>(delta * (j + 1),
 					delta * (i + 1), 0.);
 			}
 		}
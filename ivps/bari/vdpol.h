@@ -12,11 +12,17 @@ protected:
 		jac(1,1) = (1-sqr(y(0)))/_param;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp(0) = y(1);
 		yp(1) = ((1-sqr(y(0)))*y(1)-y(0))/_param;
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	VDPOL(Hash<ParamValue>& params) : BaseIVP(params), _param(1e-6) {
 		params["tf"].SetFP(2);
@@ -35,7 +35,7 @@ void BaseIVP::JacForward(unsigned short split, const FP t, const Vec<FP>& y, Mat
 	
 	Vec<FP> offset = y;
 	for( long j = 0; j < y.Size(); j++ ) {
-		FP delta = sqrt(eps*std::max(_jacDelta, fabs(y[j])));
+		FP delta = sqrt(eps*std::max<FP>(_jacDelta, fabs(y[j])));
 		// Perturb index
 		offset(j) += delta;
 		(*this)(t, offset, f2, split);
@@ -53,7 +53,7 @@ void BaseIVP::JacCentred(unsigned short split, const FP t, const Vec<FP>& y, Mat
 	Vec<FP> offset1 = y;
 	Vec<FP> offset2 = y;
 	for( long j = 0; j < y.Size(); j++ ) {
-		FP delta = sqrt(eps*std::max(_jacDelta, fabs(y[j])));
+		FP delta = sqrt(eps*std::max<FP>(_jacDelta, fabs(y[j])));
 		// Perturb indices
 		offset1(j) -= delta;
 		offset2(j) += delta;
@@ -81,7 +81,7 @@ void BaseIVP::DtAutodiff(unsigned short split, const FP t, const Vec<FP>& y, Vec
 
 void BaseIVP::DtForward(unsigned short split, const FP t, const Vec<FP>& y, Vec<FP>& pfpt) {
 	FP eps = std::numeric_limits<FP>().epsilon();
-	FP delta = sqrt(eps*std::max(_dtDelta, fabs(t)));
+	FP delta = sqrt(eps*std::max<FP>(_dtDelta, fabs(t)));
 
 	Vec<FP> f1(y.Size());
 	(*this)(t, y, f1, split);
@@ -92,7 +92,7 @@ void BaseIVP::DtForward(unsigned short split, const FP t, const Vec<FP>& y, Vec<
 
 void BaseIVP::DtCentred(unsigned short split, const FP t, const Vec<FP>& y, Vec<FP>& pfpt) {
 	FP eps = std::numeric_limits<FP>().epsilon();
-	FP delta = sqrt(eps*std::max(_dtDelta, fabs(t)));
+	FP delta = sqrt(eps*std::max<FP>(_dtDelta, fabs(t)));
 
 	Vec<FP> f1(y.Size());
 	(*this)(t-delta, y, f1, split);
@@ -195,6 +195,10 @@ void BaseIVP::PhysicalSplit(unsigned short split, const adouble t, const Vec<ado
 }
 #endif
 
+void BaseIVP::RHS(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp) {
+	throw Exception() << GetName() << " does not implement RHS for ensembles.";
+}
+
 BaseIVP::BaseIVP(Hash<ParamValue>& params, unsigned short splitting) : _initialTime(0), _finalTime(0), _dtDelta(1e-5), _dtType(D_FORWARD), _jacDelta(1e-5), _jacType(D_FORWARD), _jacFrozen(false), _jacSplitting(false), _jacScaling(1.), _splitCount(splitting), _fdorder(2) {
 	ParamValue* pv;
 	if( (pv = params.Get("jacobian splitting")) )
@@ -238,6 +242,11 @@ BaseIVP::BaseIVP(Hash<ParamValue>& params, unsigned short splitting) : _initialT
 	if( (pv = params.Get("fdorder")) )
 		_fdorder = pv->GetLong();
 
+	_eventComponent = GetDefaultLong(params, "event component", -1);
+	_eventValue = GetDefaultFP(params, "event value", 0);
+	_eventDirection = (int)GetDefaultLong(params, "event direction", 0);
+	_eventStop = (bool)GetDefaultLong(params, "event stop", 0);
+
 	if( _jacSplitting )
 		_splitCount = 0;
 
@@ -301,6 +310,14 @@ bool BaseIVP::JacobianSplitting() const {
 	return _jacSplitting;
 }
 
+bool BaseIVP::ThreadSafeRHS() const {
+	return false;
+}
+
+FP BaseIVP::SpectralRadiusBound(unsigned short split) const {
+	return 0;
+}
+
 void BaseIVP::operator()(const FP t, const Vec<FP>& y, Vec<FP>& yp, unsigned short split) {
 	// No splitting is an easy case
 	if( split == 0 ) {
@@ -334,6 +351,10 @@ void BaseIVP::operator()(const FP t, const Vec<FP>& y, Vec<FP>& yp, unsigned sho
 	throw Exception() << "Jacobian splitting is two-splitting";
 }
 
+void BaseIVP::operator()(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp) {
+	RHS(t, y, yp);
+}
+
 void BaseIVP::RHSTimeDt(const FP t, const Vec<FP>& y, Vec<FP>& pfpt, unsigned short split) {
 	switch( _dtType ) {
 	case D_ANALYTIC:
@@ -460,6 +481,24 @@ const BaseMat<FP>* BaseIVP::JacSparse(const FP t, const Vec<FP>& y, unsigned sho
 	return _splitJacs[split];
 }
 
+long BaseIVP::EventCount() const {
+	return _eventComponent >= 0 ? 1 : 0;
+}
+
+void BaseIVP::Events(const FP t, const Vec<FP>& y, Vec<FP>& g) {
+	if( _eventComponent >= y.Size() )
+		throw Exception() << "event component " << _eventComponent << " is out of range.";
+	g(0) = y(_eventComponent) - _eventValue;
+}
+
+int BaseIVP::EventDirection(long e) const {
+	return _eventDirection;
+}
+
+bool BaseIVP::EventStop(long e) const {
+	return _eventStop;
+}
+
 void BaseIVP::GetStats(Hash<ParamValue>& params) const {
 }
 
@@ -29,6 +29,7 @@
 
 #include <core/common.h>
 #include <core/hash.h>
+#include <core/lanes.h>
 #include <core/paramvalue.h>
 #include <core/vec.h>
 #include <core/mat.h>
@@ -42,6 +43,9 @@
 
 #define IVP_NAME(name) virtual const char* GetName() { return name; } 
 #define SPLIT_FP(fname,target) void fname(const FP t, const Vec<FP>& y, Vec<FP>& yp) { target(t,y,yp); }
+#define FIXED_KERNEL template <class I, long N> friend class FixedSolver;
+#define SPLIT_LANES(fname,target) void fname(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp) { target(t,y,yp); }
+#define THREAD_SAFE_RHS virtual bool ThreadSafeRHS() const { return true; }
 
 #ifdef USE_ADOL_C
 	#define SPLIT_ADOLC(fname,target) void fname(const adouble t, const Vec<adouble>& y, Vec<adouble>& yp) { target(t,y,yp); }
@@ -83,6 +87,12 @@ protected:
 	// Finite difference order
 	long _fdorder;
 
+	// Default event: component _eventComponent of y crossing _eventValue
+	long _eventComponent;
+	FP _eventValue;
+	int _eventDirection;
+	bool _eventStop;
+
 	virtual void JacAnalytic(unsigned short split, const FP t, const Vec<FP>& y, Mat<FP>& jac);
 
 	void JacAutodiff(unsigned short split, const FP t, const Vec<FP>& y, Mat<FP>& jac);
@@ -111,6 +121,10 @@ protected:
 	virtual void PhysicalSplit(unsigned short split, const adouble t, const Vec<adouble>& y, Vec<adouble>& yp);
 #endif
 
+	// Evaluates ENSEMBLE_WIDTH independent instances at once. It may be called
+	// from several threads at the same time, so it must not modify the IVP.
+	virtual void RHS(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp);
+
 public:
 	BaseIVP(Hash<ParamValue>& params, unsigned short splitting = 0);
 	virtual ~BaseIVP();
@@ -122,7 +136,19 @@ public:
 	void FreezeJacobian(bool jf);
 	bool JacobianSplitting() const;
 
+	// Whether operator() may be called from several threads at once, which
+	// methods with a threads parameter check before using more than one. IVPs
+	// declare it with THREAD_SAFE_RHS when their right hand side (and splits)
+	// only read the IVP.
+	virtual bool ThreadSafeRHS() const;
+
+	// A constant bound on the spectral radius of the Jacobian of a split, for
+	// IVPs whose split is a linear operator such as a diffusion stencil, or 0
+	// when there is none
+	virtual FP SpectralRadiusBound(unsigned short split) const;
+
 	void operator()(const FP t, const Vec<FP>& y, Vec<FP>& yp, unsigned short split = 0);
+	void operator()(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp);
 	void RHSTimeDt(const FP t, const Vec<FP>& y, Vec<FP>& pfpt, unsigned short split = 0);
 
 	const BaseMat<FP>* SplitMat(const FP t, const Vec<FP>& y, unsigned short split);
@@ -130,6 +156,14 @@ public:
 	const BaseMat<FP>* SplitMatSparse(const FP t, const Vec<FP>& y, unsigned short split);
 	const BaseMat<FP>* JacSparse(const FP t, const Vec<FP>& y, unsigned short split = 0);
 
+	// Event functions g(t,y), checked by the solvers after every accepted step.
+	// An event occurs where g changes sign in the given direction (1 rising,
+	// -1 falling, 0 either) and either ends the integration or is recorded.
+	virtual long EventCount() const;
+	virtual void Events(const FP t, const Vec<FP>& y, Vec<FP>& g);
+	virtual int EventDirection(long e) const;
+	virtual bool EventStop(long e) const;
+
 	virtual void GetStats(Hash<ParamValue>& params) const;
 	virtual void PrintStats() const;
 	
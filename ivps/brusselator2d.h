@@ -217,6 +217,11 @@ public:
 		}
 	}
 
+	// Gershgorin bound of the five point Laplacian
+	virtual FP SpectralRadiusBound(unsigned short split) const {
+		return split == 1 ? 8*_coeff : 0;
+	}
+
 	LINK_TWOSPLIT
 	IVP_NAME("2D Brusselator")
 };
@@ -11,78 +11,92 @@ class CellModel : public BaseIVP {
 	FP _kNa, _kK, _kCl;
 	Vec<FP> _P;
 
-	void CalculateCurrents(const FP t, const Vec<FP>& y, FP Ua, FP Ub, Vec<FP>& J) {
-		FP expUa = exp(-Ua);
-		FP expUb = exp(-Ub);
+	template <class T, class V>
+	void CalculateCurrents(const T t, const V& y, T Ua, T Ub, T* J) {
+		T expUa = exp(-Ua);
+		T expUb = exp(-Ub);
 
 		// Single ion channels
-		J(0) = _P(0) * Ua * (_bNa - y(0)*expUa) / (1-expUa);
-		J(1) = _P(1) * Ua * (_bK  - y(1)*expUa) / (1-expUa);
-		J(2) = _P(2) * Ua * (_bCl*expUa - y(2)) / (expUa-1);
-		J(3) = _P(3) * Ub * (_bK  - y(1)*expUb) / (1-expUb);
+		J[0] = _P(0) * Ua * (_bNa - y(0)*expUa) / (1-expUa);
+		J[1] = _P(1) * Ua * (_bK  - y(1)*expUa) / (1-expUa);
+		J[2] = _P(2) * Ua * (_bCl*expUa - y(2)) / (expUa-1);
+		J[3] = _P(3) * Ub * (_bK  - y(1)*expUb) / (1-expUb);
 
 		// 3Na/2K ATPase
-		FP b = 1 - 6e-3*Ub;
-		J(4) = _P(4) * pow(y(0)/(y(0)+_kNa), 3) * pow(_bK/(_bK+_kK), 2) * (6e-3*Ub + b);
+		T b = 1 - 6e-3*Ub;
+		J[4] = _P(4) * pow(y(0)/(y(0)+_kNa), 3) * pow(_bK/(_bK+_kK), 2) * (6e-3*Ub + b);
 
 		// Na/K/2Cl Cotransporter
-		J(5) = _P(5) * (_bNa*_bK*sqr(_bCl) - y(0)*y(1)*sqr(y(2))) / ( (y(0)/_kNa+1) * (y(1)/_kK+1) * sqr(y(2)/_kCl+1) );
+		J[5] = _P(5) * (_bNa*_bK*sqr(_bCl) - y(0)*y(1)*sqr(y(2))) / ( (y(0)/_kNa+1) * (y(1)/_kK+1) * sqr(y(2)/_kCl+1) );
 
 		// Na/Cl Cotransporter
-		J(6) = _P(6) * (_bNa*_bCl - y(0)*y(2)) / ( (y(0)/_kNa+1) * (y(2)/_kCl+1) );
+		J[6] = _P(6) * (_bNa*_bCl - y(0)*y(2)) / ( (y(0)/_kNa+1) * (y(2)/_kCl+1) );
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		typedef typename MaskOf<T>::Type Mask;
+
 		yp.Zero();
 
 		FP Va = -46;
 		//FP Vb = -46;
 
-		FP Ua = 1e-3 * Va * _F/(_R*_T);
+		T Ua = 1e-3 * Va * _F/(_R*_T);
 		//FP Ub = 1e-3 * Vb * _F/(_R*_T);
 
 		// Epsilon for jacobian	
 		FP eps = std::numeric_limits<FP>().epsilon();
 
-		Vec<FP> J(7);
+		// Lanes that have converged keep the currents of their last iterate
+		T J[7], Jdelta[7], Jcurrent[7];
+		Mask converged(false);
 		for( short i = 0; ;i++ ) {
 			// Begin Jacobian calcs
-			FP delta = sqrt(eps*std::max(1e-5, fabs(Ua)));
-			CalculateCurrents(t, y, Ua+delta, Ua+delta, J);
-			FP jac = (J(0) + J(1) - J(2)) - (J(4) - J(3));
+			T delta = sqrt(eps*fmax(T(1e-5), fabs(Ua)));
+			CalculateCurrents(t, y, Ua+delta, Ua+delta, Jdelta);
+			T jac = (Jdelta[0] + Jdelta[1] - Jdelta[2]) - (Jdelta[4] - Jdelta[3]);
 			
 			// Current evaluation
-			CalculateCurrents(t, y, Ua, Ua, J);
-			FP Ia = J(0) + J(1) - J(2);
-			FP Ib = J(4) - J(3);
-			FP I = Ia - Ib;
+			CalculateCurrents(t, y, Ua, Ua, Jcurrent);
+			T Ia = Jcurrent[0] + Jcurrent[1] - Jcurrent[2];
+			T Ib = Jcurrent[4] - Jcurrent[3];
+			T I = Ia - Ib;
+			for( short k = 0; k < 7; k++ )
+				J[k] = Select(converged, J[k], Jcurrent[k]);
 			
 			// Finish calculating Jacobian
 			jac -= I;
 			jac /= delta;
 
 			// Newton update
-			Ua -= I/jac;
+			Ua = Select(converged, Ua, Ua - I/jac);
 			
-			FP absI = fabs(I);
-			if( absI < 1e-5 ) {
+			T absI = fabs(I);
+			converged = converged | (absI < 1e-5);
+			if( AllOf(converged) ) {
 				//std::cout << "Newton method converged after " << i << " iterations.\n";
 				break;
 			}
 
-			if( absI > 1e20 )
+			if( AnyOf(absI > 1e20) )
 				throw Exception() << "Newton method blew up.";
 			
 			if( i > 15 )
 				throw Exception() << "Newton method failed to converge.";
 		}
 
-		yp(0) = J(0) - 3*J(4) + J(5) + J(6);
-		yp(1) = J(1) + J(3) + 2*J(4) + J(5);
-		yp(2) = J(2) + 2*J(5) + J(6);
+		yp(0) = J[0] - 3*J[4] + J[5] + J[6];
+		yp(1) = J[1] + J[3] + 2*J[4] + J[5];
+		yp(2) = J[2] + 2*J[5] + J[6];
 		yp /= _cV;
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	CellModel(Hash<ParamValue>& params) : BaseIVP(params) {
 		// Cell volume
@@ -146,6 +146,10 @@ public:
 		_sigma = 10.;
 		_L = 1;
 
+		// Arrival of the front at a point x
+		if( (pv = params.Get("event x")) )
+			_eventComponent = std::min(_n-1, std::max(0L, (long)floor((pv->GetFP()-_xmin)/_dx + 0.5)));
+
 		_initialCondition.Resize(_n);
 		for( long i = 0; i < _n; i++ ) {
 			FP x = _xmin + i*_dx;
@@ -293,6 +293,11 @@ public:
 		else _iMix = 3;
 
 		BuildConcreteParameters();
+
+		// Arrival of the wetting front at a depth, seen in the water content
+		if( (param = params.Get("event depth")) )
+			_eventComponent = std::min(_N-1, (long)(param->GetFP()/_hx));
+
 		Vec<FP> theta0(_N);
 		for( long i = 0; i < theta0.Size(); i++ )
 			theta0[i] = _hx*(i+0.5) < _Xfront0 ? _theta_max : _theta_min;	
@@ -113,6 +113,11 @@ public:
 			_initialCondition[i] = 25+273.15;
 	}
 
+	// Gershgorin bound of the diffusion stencil, including its outflow rows
+	virtual FP SpectralRadiusBound(unsigned short split) const {
+		return split == 1 ? _d*(4/sqr(_dx) + 4/sqr(_dy)) : 0;
+	}
+
 	LINK_TWOSPLIT
 	IVP_NAME("Heat Transfer Equation");
 };
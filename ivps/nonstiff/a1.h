@@ -7,10 +7,16 @@ protected:
 		jac(0,0) = -1;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp(0) = -y(0);
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffA1(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
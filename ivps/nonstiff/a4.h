@@ -6,9 +6,15 @@ class NonstiffA4 : public BaseIVP {
 		jac(0,0) = (10-y(0))/40;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp(0) = (y(0)/4) * (1 - y(0)/20);
 	}
+
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
 	
 public:
 	NonstiffA4(Hash<ParamValue>& params) : BaseIVP(params) {
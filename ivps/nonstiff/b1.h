@@ -8,10 +8,16 @@ protected:
 		jac(1,0) = y[1];         jac(1,1) = -1 - y[0];
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] =  2*(y[0] - y[0]*y[1]);
 		yp[1] =	-1*(y[1] - y[0]*y[1]);
 	}
+
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
 	
 public:
 	NonstiffB1(Hash<ParamValue>& params) : BaseIVP(params) {
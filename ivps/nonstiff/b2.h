@@ -9,11 +9,17 @@ protected:
 		jac(2,0) =  0; jac(2,1) =  1; jac(2,2) = -1;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = -y[0] + y[1];
 		yp[1] = y[0] - 2*y[1] + y[2];
 		yp[2] = y[1] - y[2];
 	}
+
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
 	
 public:
 	NonstiffB2(Hash<ParamValue>& params) : BaseIVP(params) {
@@ -9,12 +9,18 @@ protected:
 		jac(2,0) =  0; jac(2,1) =  2*y[1]; jac(2,2) = 0;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = -y[0];
 		yp[1] = y[0] - y[1]*y[1];
 		yp[2] = y[1]*y[1];
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffB3(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
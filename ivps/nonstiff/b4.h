@@ -21,13 +21,19 @@ protected:
 		jac(2,2) = 0;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		FP root = sqrt(y[0]*y[0] + y[1]*y[1]);
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		T root = sqrt(y[0]*y[0] + y[1]*y[1]);
 		yp[0] = -y[1] - y[0]*y[2]/root;
 		yp[1] =  y[0] - y[1]*y[2]/root;
 		yp[2] =  y[0]/root;
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffB4(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
@@ -13,7 +13,8 @@ protected:
 		jac(9,8) = 1;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = -y[0];
 		yp[1] = y[0] - y[1];
 		yp[2] = y[1] - y[2];
@@ -26,6 +27,11 @@ protected:
 		yp[9] = y[8];
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffC1(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
@@ -16,13 +16,19 @@ protected:
 		jac(50,50) = -2;
 	}   
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = -2*y[0] + y[1];
 		for( long i = 1; i < 50; i++ )
 			yp[i] = y[i-1] - 2*y[i] + y[i+1];
 		yp[50] = y[49] - 2*y[50];	
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffC4(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
@@ -7,13 +7,14 @@ protected:
 	FP _m0;
 	FP _m[5];
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		FP ypos[3][5];
-		FP ypp[3][5];
-		FP rSquared[5];
-		FP rCubed[5];
-		FP dSquared[5][5];
-		FP dCubed[5][5];
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		T ypos[3][5];
+		T ypp[3][5];
+		T rSquared[5];
+		T rCubed[5];
+		T dSquared[5][5];
+		T dCubed[5][5];
 
 		for( short j = 0; j < 5; j++ )
 			for( short i = 0; i < 3; i++ )
@@ -49,6 +50,11 @@ protected:
 				yp[15+j+k*3] = ypp[j][k];
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffC5(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
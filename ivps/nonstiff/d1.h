@@ -17,8 +17,9 @@ protected:
 		jac(3,1) = (2*y3s-y2s)   * denom;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		FP denom = pow(sqr(y[0]) + sqr(y[1]), -1.5);
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		T denom = pow(sqr(y[0]) + sqr(y[1]), -1.5);
 
 		yp[0] = y[2];
 		yp[1] = y[3];
@@ -26,6 +27,11 @@ protected:
 		yp[3] = -y[1]*denom;
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffD1(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
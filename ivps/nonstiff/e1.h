@@ -12,13 +12,19 @@ protected:
 		jac(1,1) = -1/tp1;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		FP tp1 = t+1;
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		T tp1 = t+1;
 
 		yp[0] = y[1];
 		yp[1] = -(y[1]/tp1 + (1-0.25/sqr(tp1))*y[0]); 
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffE1(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
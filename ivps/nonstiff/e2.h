@@ -10,11 +10,17 @@ protected:
 		jac(0,1) = 1-sqr(y[0]);
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = y[1];
 		yp[1] = (1-sqr(y[0]))*y[1] - y[0];
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffE2(Hash<ParamValue>& params) : BaseIVP(params) {
         params["tf"].SetFP(20);
@@ -10,11 +10,17 @@ protected:
 		jac(1,1) = 0;
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = y[1];
 		yp[1] = pow(y[0],3)/6 - y[0] + 2*sin(2.78535*t);
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffE3(Hash<ParamValue>& params) : BaseIVP(params) {
         params["tf"].SetFP(20);
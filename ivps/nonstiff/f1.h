@@ -5,14 +5,21 @@ class NonstiffF1 : public BaseIVP {
 protected:
 	FP _a;
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		FP pi2 = M_PI*M_PI;
 		FP a2 = _a*_a;
 
+		// +1 on intervals where int(t) is even, -1 where it is odd
 		yp[0] = y[1];
-		yp[1] = 2*_a*y[1] - (pi2+a2)*y[0] + (int(t)%2==0 ? 1 : -1);
+		yp[1] = 2*_a*y[1] - (pi2+a2)*y[0] + Select(fabs(fmod(t,2)) < 1, T(1), T(-1));
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffF1(Hash<ParamValue>& params) : BaseIVP(params), _a(0.1) {
 		params["tf"].SetFP(20);
@@ -3,10 +3,16 @@
 
 class NonstiffF2 : public BaseIVP {
 protected:
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		yp[0] = 55 - (int(t)%2==0?3:1)*y[0]/2;
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		yp[0] = 55 - Select(fabs(fmod(t,2)) < 1, T(3), T(1))*y[0]/2;
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffF2(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
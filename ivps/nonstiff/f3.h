@@ -3,11 +3,17 @@
 
 class NonstiffF3 : public BaseIVP {
 protected:
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		yp[0] = y[1];
 		yp[1] = 0.01*y[1]*(1-sqr(y[0])) - y[0] - fabs(sin(M_PI*t));
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffF3(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
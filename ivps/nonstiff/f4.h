@@ -3,13 +3,16 @@
 
 class NonstiffF4 : public BaseIVP {
 protected:
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		if( t <= 10 )
-			yp[0] = -2./21 - 120*(t-5)/(1 + 4*sqr(t-5));
-		else
-			yp[0] = -2*y[0];
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		yp[0] = Select(t <= 10, -2./21 - 120*(t-5)/(1 + 4*sqr(t-5)), -2*y[0]);
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffF4(Hash<ParamValue>& params) : BaseIVP(params) {
 		params["tf"].SetFP(20);
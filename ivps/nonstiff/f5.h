@@ -5,16 +5,21 @@ class NonstiffF5 : public BaseIVP {
 protected:
 	FP _c;
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-		FP pprime = 0;
-		for( long i = 1; i < 20; i++ ) {
-			CFP e = pow(CFP(t-i), 1./3);
-			pprime += (t-i<0?-1:1)*(sqr(e.real())+sqr(e.imag()));
-		}
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
+		// |(t-i)^(1/3)|^2 with the sign of t-i
+		T pprime = 0;
+		for( long i = 1; i < 20; i++ )
+			pprime += Select(t-i < 0, T(-1), T(1))*pow(fabs(t-i), (FP)2/3);
 
 		yp[0] = (4/(3*_c) * pprime * y[0]);
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+	FIXED_KERNEL
+
 public:
 	NonstiffF5(Hash<ParamValue>& params) : BaseIVP(params), _c(0) {
 		for( long i = 0; i < 20; i++ )
@@ -5,7 +5,8 @@ class PLATE : public BaseIVP {
 	FP _omega;
 	FP _sigma;
 
-	FP GetU(const Vec<FP>& y, long i, long j) {
+	template <class T>
+	T GetU(const Vec<T>& y, long i, long j) {
 		if( i < 1 ) return 0;
 		if( i > 8 ) return 0;
 		if( j < 1 ) return 0;
@@ -13,17 +14,18 @@ class PLATE : public BaseIVP {
 		return y[8*(j-1)+i-1];
 	}
 
-	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	template <class T, class V>
+	void RHSInternal(const T t, const V& y, V& yp) {
 		for( long i = 0; i < 40; i++ )
 			yp[40+i] = y[40];
 
 		for( int i = 1; i <= 8; i++ ) {
 			for( int j = 1; j <= 5; j++ ) {
-				FP plate = 20*GetU(y,i,j) - 8*(GetU(y,i+1,j)+GetU(y,i-1,j)+GetU(y,i,j+1)+GetU(y,i,j-1))
+				T plate = 20*GetU(y,i,j) - 8*(GetU(y,i+1,j)+GetU(y,i-1,j)+GetU(y,i,j+1)+GetU(y,i,j-1))
 						   + 2*(GetU(y,i+1,j+1) + GetU(y,i-1,j-1) + GetU(y,i+1,j-1) + GetU(y,i-1,j+1))
 						   + GetU(y,i+2,j) + GetU(y,i-2,j) + GetU(y,i,j+2) + GetU(y,i,j-2);
 				plate /= 16./6561.;
-				FP f;
+				T f;
 				FP x = 2*i/9.;
 				switch( j ) {
 				case 2:
@@ -39,6 +41,10 @@ class PLATE : public BaseIVP {
 	
 	}
 
+	SPLIT_FP(RHS, RHSInternal)
+	SPLIT_LANES(RHS, RHSInternal)
+	THREAD_SAFE_RHS
+
 public:
 	PLATE(Hash<ParamValue>& params) : BaseIVP(params) {
 		_omega = 1e3;
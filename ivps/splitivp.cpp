@@ -31,16 +31,20 @@ adouble TwoSplittingIVP::ProcessConditional(adouble c, adouble t, adouble f) {
 #endif
 
 void TwoSplittingIVP::RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
-	CalculateCommon(t,y);
-	FreezeCommon(true);
+	bool common = !ThreadSafeRHS();
+	if( common ) {
+		CalculateCommon(t,y);
+		FreezeCommon(true);
+	}
 
-	Split1(t, y, yp);;
+	Split1(t, y, yp);
 
 	Vec<FP> split2(y.Size());
 	Split2(t, y, split2);
 	yp += split2;
 
-	FreezeCommon(false);
+	if( common )
+		FreezeCommon(false);
 
 	_fEvals++;
 	_gEvals++;
@@ -98,6 +102,22 @@ void TwoSplittingIVP::PhysicalSplit(unsigned short split, const adouble t, const
 }
 #endif
 
+void TwoSplittingIVP::RHS(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp) {
+	Split1(t, y, yp);
+
+	Vec<LFP> split2(y.Size());
+	Split2(t, y, split2);
+	yp += split2;
+}
+
+void TwoSplittingIVP::Split1(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp) {
+	throw Exception() << GetName() << " does not implement a split term 1 for ensembles.";
+}
+
+void TwoSplittingIVP::Split2(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp) {
+	throw Exception() << GetName() << " does not implement a split term 2 for ensembles.";
+}
+
 void TwoSplittingIVP::SplitMat1(const FP t, const Vec<FP>& y, Mat<FP>& mat) {
 	throw Exception() << GetName() << " does not implement a matrix for the first split component.";
 }
@@ -140,8 +160,8 @@ TwoSplittingIVP::TwoSplittingIVP(Hash<ParamValue>& params) : BaseIVP(params,2),
 
 void TwoSplittingIVP::GetStats(Hash<ParamValue>& params) const {
 	BaseIVP::GetStats(params);
-	params["f evaluations"] = _fEvals;
-	params["g evaluations"] = _gEvals;
+	params["f evaluations"] = _fEvals.load();
+	params["g evaluations"] = _gEvals.load();
 }
 
 void TwoSplittingIVP::PrintStats() const {
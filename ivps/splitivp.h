@@ -3,15 +3,23 @@
 
 #include <ivps/baseivp.h>
 
+#include <atomic>
+
 #define LINK_TWOSPLIT SPLIT_FP(Split1, Split1Internal) \
 					  SPLIT_FP(Split2, Split2Internal) \
 					  SPLIT_ADOLC(Split1, Split1Internal) \
 					  SPLIT_ADOLC(Split2, Split2Internal)
 
+#define LINK_TWOSPLIT_LANES SPLIT_LANES(Split1, Split1Internal) \
+							SPLIT_LANES(Split2, Split2Internal)
+
 class TwoSplittingIVP : public BaseIVP {
 protected:
-	long _fEvals;
-	long _gEvals;
+	// Counted atomically, as thread-safe IVPs may be evaluated from several
+	// threads at once. Such IVPs have no common state, so CalculateCommon and
+	// FreezeCommon are only used by the others.
+	std::atomic<long> _fEvals;
+	std::atomic<long> _gEvals;
 	bool _freezeCommon;
 
 	void FreezeCommon(bool fc);
@@ -33,6 +41,12 @@ protected:
 	void PhysicalSplit(unsigned short split, const adouble t, const Vec<adouble>& y, Vec<adouble>& yp);
 #endif
 
+	// Ensemble evaluation does not update the evaluation counters, since it
+	// may run on several threads at once.
+	void RHS(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp);
+	virtual void Split1(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp);
+	virtual void Split2(const LFP t, const Vec<LFP>& y, Vec<LFP>& yp);
+
 	virtual void SplitMat1(const FP t, const Vec<FP>& y, Mat<FP>& mat);
 	virtual void SplitMat2(const FP t, const Vec<FP>& y, Mat<FP>& mat);
 	
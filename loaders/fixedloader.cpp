@@ -0,0 +1,26 @@
+#include <ivps/baseivp.h>
+#include <ivps/splitivp.h>
+#include <ivps/nonstiff.h>
+#include <ivps/bari.h>
+#include <ivps/cellmodel.h>
+#include <ivps/VanDerPol.h>
+#include <solvers/fixed.h>
+
+#define FIXEDCASE(ivpclass,n) if( ivpName == #ivpclass ) return new FixedSolver<ivpclass,n>(params,method,ivp);
+
+BaseSolver* AllocFixedSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) {
+	std::string ivpName = params["ivp"].GetString();
+
+	FIXEDCASE(NonstiffA1,1) FIXEDCASE(NonstiffA2,1) FIXEDCASE(NonstiffA3,1) FIXEDCASE(NonstiffA4,1) FIXEDCASE(NonstiffA5,1)
+	FIXEDCASE(NonstiffB1,2) FIXEDCASE(NonstiffB2,3) FIXEDCASE(NonstiffB3,3) FIXEDCASE(NonstiffB4,3) FIXEDCASE(NonstiffB5,3)
+	FIXEDCASE(NonstiffC1,10) FIXEDCASE(NonstiffC2,10) FIXEDCASE(NonstiffC3,10) FIXEDCASE(NonstiffC4,51) FIXEDCASE(NonstiffC5,30)
+	FIXEDCASE(NonstiffD1,4) FIXEDCASE(NonstiffD2,4) FIXEDCASE(NonstiffD3,4) FIXEDCASE(NonstiffD4,4) FIXEDCASE(NonstiffD5,4)
+	FIXEDCASE(NonstiffE1,2) FIXEDCASE(NonstiffE2,2) FIXEDCASE(NonstiffE3,2) FIXEDCASE(NonstiffE4,2) FIXEDCASE(NonstiffE5,2)
+	FIXEDCASE(NonstiffF1,2) FIXEDCASE(NonstiffF2,1) FIXEDCASE(NonstiffF3,2) FIXEDCASE(NonstiffF4,1) FIXEDCASE(NonstiffF5,1)
+
+	FIXEDCASE(VDPOL,2)
+	FIXEDCASE(VanDerPol,2)
+	FIXEDCASE(CellModel,3)
+
+	throw Exception() << "IVP " << ivpName << " has no fixed size instantiation.";
+}
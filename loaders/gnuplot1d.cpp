@@ -55,7 +55,7 @@ void SetupPlot(Hash<ParamValue>& params) {
 			xsize = ysize*11/8.5;
 	}
 
-	EchoPrint("set terminal pdf size %.2f,%.2f\n", xsize, ysize);
+	EchoPrint("set terminal pdf size %.2f,%.2f\n", (double)xsize, (double)ysize);
 	EchoPrint("set termopt enhanced\n");
 	EchoPrint("set output '%s'\n", params["plotfile"].GetString());
 	EchoPrint("set key t rm\n");
@@ -104,7 +104,7 @@ void CUSPPlot(Hash<ParamValue>& params) {
 
 	for( long s = 0; s < sl._points[0].y.Size(); s += 3 ) {
 		for( long l = 0; l < sl._points.size(); l++ )
-			EchoPrint("%g %g %g\n", sl._points[l].y[s+1], sl._points[l].y[s+2], sl._points[l].y[s]);
+			EchoPrint("%g %g %g\n", (double)sl._points[l].y[s+1], (double)sl._points[l].y[s+2], (double)sl._points[l].y[s]);
 		EchoPrint("e\n");
 	}
 }
@@ -163,7 +163,7 @@ void Plot2D(Hash<ParamValue>& params) {
 
 		for( long e = 0; e < sl._points[0].y.Size(); e++ ) {
 			for( unsigned j = 0; j < sl._points.size(); j++ )
-				EchoPrint("%g %g\n", sl._points[j].t, sl._points[j].y[e]);
+				EchoPrint("%g %g\n", (double)sl._points[j].t, (double)sl._points[j].y[e]);
 			EchoPrint("e\n");
 		}
 	}
@@ -179,7 +179,7 @@ void PlotSurface(Hash<ParamValue>& params) {
 	EchoPrint("unset key\n");
 
 	SolutionLine& sl = g_SolutionLines[0];
-	EchoPrint("set xrange [%.3f:%.3f] reverse\n", sl._points[0].t, sl._points[sl._points.size()-1].t);
+	EchoPrint("set xrange [%.3f:%.3f] reverse\n", (double)sl._points[0].t, (double)sl._points[sl._points.size()-1].t);
 
 	// Setup units for the solution vector
 	FP ymin = 0;
@@ -189,13 +189,13 @@ void PlotSurface(Hash<ParamValue>& params) {
 	FP dy = (ymax-ymin)/sl._points[0].y.Size();
 
 	if( params.Get("ytics") )
-		EchoPrint("set ytics %.4f\n", params["ytics"].GetFP());
+		EchoPrint("set ytics %.4f\n", (double)params["ytics"].GetFP());
 
 	EchoPrint("splot '-' with lines\n");
 	for( long t = 0; t < (long)sl._points.size(); t++ ) {
 		SolutionPoint& sp = sl._points[t];
 		for( long x = 0; x < sp.y.Size(); x++ ) {
-			EchoPrint("%.3f %.3f %.3f\n", sp.t, dy*x, sp.y[x]);
+			EchoPrint("%.3f %.3f %.3f\n", (double)sp.t, (double)(dy*x), (double)sp.y[x]);
 		}
 		EchoPrint("\n");
 	}
@@ -209,19 +209,19 @@ void ColorPlot(Hash<ParamValue>& params) {
 	SolutionPoint& sp = sl._points[0];
 
 	if( params.Get("cbmin") && params.Get("cbmax") )
-		EchoPrint("set cbrange [%.3f:%.3f]\n", params["cbmin"].GetFP(), params["cbmax"].GetFP());
+		EchoPrint("set cbrange [%.3f:%.3f]\n", (double)params["cbmin"].GetFP(), (double)params["cbmax"].GetFP());
 
 	long xdim = params["xdim"].GetLong();
 	long ydim = params["ydim"].GetLong();
 
-	EchoPrint("set xrange [%.3f:%.3f]\n", 0., (FP)(xdim-1));
-	EchoPrint("set yrange [%.3f:%.3f]\n", 0., (FP)(ydim-1));
+	EchoPrint("set xrange [%.3f:%.3f]\n", 0., (double)(xdim-1));
+	EchoPrint("set yrange [%.3f:%.3f]\n", 0., (double)(ydim-1));
 	EchoPrint("unset key\n");
 
 	EchoPrint("plot '-' with image\n");
 	for( long x = 0; x < xdim; x++ ) {
 		for( long y = 0; y < ydim; y++ ) {
-			EchoPrint("%.3f %.3f %.3f\n", (FP)x, (FP)y, sp.y[y*xdim+x]);	
+			EchoPrint("%.3f %.3f %.3f\n", (double)x, (double)y, (double)sp.y[y*xdim+x]);	
 		}
 	}
 	EchoPrint("e\n");
@@ -2,7 +2,17 @@
 #include <methods/irk.h>
 #include <methods/ark.h>
 #include <methods/rkc.h>
+#include <methods/rock.h>
+#include <methods/lowstorage.h>
 #include <methods/exprk.h>
+#include <methods/exprb.h>
+#include <methods/bdf.h>
+#include <methods/adams.h>
+#include <methods/extrapolation.h>
+#include <methods/sdc.h>
+#include <methods/pdirk.h>
+#include <methods/mri.h>
+#include <methods/splitting.h>
 
 #define METHODCASE(methodclass) if( method == #methodclass ) return new methodclass(params,ivp);
 
@@ -24,22 +34,46 @@ BaseMethod* AllocMethod(Hash<ParamValue>& params, BaseIVP* ivp) {
 	METHODCASE(Merson43)
 	METHODCASE(Zonneveld43)
 	METHODCASE(Verner65)
+	METHODCASE(Williamson3)
+	METHODCASE(CarpenterKennedy4)
+	METHODCASE(RK46NL)
+	METHODCASE(BogackiShampine3)
 	METHODCASE(RKC1)
 	METHODCASE(RKC2)
 	METHODCASE(PRKC)
 	METHODCASE(IRKC)
+	METHODCASE(ROCK2)
+	METHODCASE(ROCK4)
 	METHODCASE(ARK1)
 	METHODCASE(ARK3)
 	METHODCASE(ARK4)
 	METHODCASE(ARK5)
 	METHODCASE(Radau5)
+	METHODCASE(RadauIIA)
 	METHODCASE(RODAS)
 	METHODCASE(DIRKCF1)
 	METHODCASE(DIRKCF2)
 	METHODCASE(DIRKCF3)
+	METHODCASE(Exprb32)
+	METHODCASE(Exprb43)
+	METHODCASE(EPIRK4s3)
 	METHODCASE(ERKCF2)
 	METHODCASE(BS23)
 	METHODCASE(BS54)
+	METHODCASE(BDF)
+	METHODCASE(Adams)
+	METHODCASE(GBS)
+	METHODCASE(LIEuler)
+	METHODCASE(ExplicitSDC)
+	METHODCASE(ImplicitSDC)
+	METHODCASE(IMEXSDC)
+	METHODCASE(PDIRK)
+	METHODCASE(MRIGARK22a)
+	METHODCASE(MRIGARK22b)
+	METHODCASE(MRIGARK33a)
+	METHODCASE(LieSplitting)
+	METHODCASE(StrangSplitting)
+	METHODCASE(YoshidaSplitting)
 
 	throw Exception() << "Method " << method << " has not been defined.";
 }
@@ -1,16 +1,27 @@
 #include <solvers/constant.h>
 #include <solvers/embedded.h>
+#include <solvers/ensemble.h>
+#include <solvers/extrapolation.h>
+#include <solvers/multistep.h>
+#include <solvers/parareal.h>
 #include <solvers/stepdoubling.h>
 
 #define SOLVERCASE(solverclass) if( solver == #solverclass ) return new solverclass(params,method,ivp);
 
 BaseIVP* AllocIVP(Hash<ParamValue>& params);
 BaseMethod* AllocMethod(Hash<ParamValue>& params, BaseIVP* ivp);
+BaseSolver* AllocFixedSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+
 BaseSolver* AllocSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) {
 	std::string solver = params["solver"].GetString();
 	SOLVERCASE(ConstantSolver)
 	SOLVERCASE(EmbeddedSolver)
+	SOLVERCASE(EnsembleSolver)
 	SOLVERCASE(StepDoublingSolver)
+	SOLVERCASE(MultistepSolver)
+	SOLVERCASE(ExtrapolationSolver)
+	SOLVERCASE(PararealSolver)
+	if( solver == "FixedSolver" ) return AllocFixedSolver(params,method,ivp);
 	throw Exception() << "Solver " << solver << " has not been defined.";
 }
 
@@ -0,0 +1,99 @@
+#include <core/exception.h>
+#include <methods/adams.h>
+
+Adams::Adams(Hash<ParamValue>& params, BaseIVP* ivp) : NordsieckMethod(params, ivp, ADAMS_MAX_ORDER) {
+	_correctorIterations = GetDefaultLong(params, "corrector iterations", 3);
+	if( _correctorIterations < 1 )
+		throw Exception() << "corrector iterations must be at least one.";
+
+	// Error constants of the Adams-Moulton methods,
+	// sum_{j=0}^{k} gamma*_j/(k+1-j) = 0 with gamma*_0 = 1
+	_gammaStar[0] = 1;
+	for( long k = 1; k < NORDSIECK_MAX_ORDER+2; k++ ) {
+		FP s = 0;
+		for( long j = 0; j < k; j++ )
+			s += _gammaStar[j]/(k+1-j);
+		_gammaStar[k] = -s;
+	}
+
+	SetCoefficients();
+
+	_statCorrectorIterations = 0;
+	_statCorrectorFailures = 0;
+}
+
+// Corrector coefficients of order q: l(x) = int_{-1}^{x} prod_{i=1}^{q-1} (1 + u/i) du
+void Adams::SetCoefficients() {
+	FP p[NORDSIECK_MAX_ORDER+1];
+	for( long j = 0; j <= NORDSIECK_MAX_ORDER; j++ )
+		p[j] = 0;
+	p[0] = 1;
+
+	for( long i = 1; i < _q; i++ )
+		for( long j = i; j > 0; j-- )
+			p[j] += p[j-1]/i;
+
+	_l[0] = 0;
+	for( long j = 0; j < _q; j++ ) {
+		_l[j+1] = p[j]/(j+1);
+		_l[0] += (j % 2 ? -1 : 1)*_l[j+1];
+	}
+	for( long j = _q+1; j <= NORDSIECK_MAX_ORDER; j++ )
+		_l[j] = 0;
+}
+
+// Functional iteration on acor = h f(t, z0 + l0 acor) - z1
+bool Adams::Correct(FP t) {
+	long n = _acor.Size();
+	Vec<FP> y(n), f(n), delta(n);
+	FP errConst = ErrorConstant(_q);
+
+	_acor.Zero();
+	y = _zn[0];
+	_crate = 1;
+
+	FP delp = 0;
+	for( long m = 0; m < _correctorIterations; m++ ) {
+		(*_ivp)(t, y, f);
+		_rhsEvals++;
+		_statCorrectorIterations++;
+
+		delta = f;
+		delta *= _h;
+		delta -= _zn[1];
+		delta -= _acor;
+
+		_acor += delta;
+		y = _zn[0];
+		y.AddScaled(_l[0], _acor);
+
+		FP del = (delta/_tol).RMS();
+		if( m > 0 )
+			_crate = std::max(FP(0.3)*_crate, del/delp);
+
+		if( del*std::min(FP(1), _crate)*errConst <= 0.1 )
+			return true;
+
+		if( del != del || (m > 0 && del > 2*delp) )
+			break;
+		delp = del;
+	}
+
+	_statCorrectorFailures++;
+	return false;
+}
+
+// The local error of Adams-Moulton of order k is gamma*_k h^(k+1) y^(k+1)
+FP Adams::ErrorConstant(long order) const {
+	return fabs(_gammaStar[order]);
+}
+
+void Adams::GetStats(Hash<ParamValue>& params) const {
+	NordsieckMethod::GetStats(params);
+	params["corrector iterations"].SetLong(_statCorrectorIterations);
+	params["corrector failures"].SetLong(_statCorrectorFailures);
+}
+
+const char* Adams::GetName() const {
+	return "Adams";
+}
@@ -0,0 +1,35 @@
+#ifndef ADAMS_H
+#define ADAMS_H
+
+#include <core/common.h>
+#include <methods/nordsieck.h>
+
+#define ADAMS_MAX_ORDER 12
+
+// Variable order Adams-Bashforth-Moulton predictor-corrector for nonstiff
+// problems with expensive right hand sides. The Pascal triangle prediction is
+// the Adams-Bashforth step and the corrector is iterated by evaluating the
+// right hand side at the corrected value until the change is well below the
+// error estimate, which usually takes two evaluations per step (PECE).
+class Adams : public NordsieckMethod {
+protected:
+	FP _gammaStar[NORDSIECK_MAX_ORDER+2];
+	long _correctorIterations;
+
+	// Stats
+	long _statCorrectorIterations;
+	long _statCorrectorFailures;
+
+	virtual void SetCoefficients();
+	virtual bool Correct(FP t);
+	virtual FP ErrorConstant(long order) const;
+
+public:
+	Adams(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -1,16 +1,25 @@
 #ifndef ARK1_H
 #define ARK1_H
 
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class ARK1 : public IMEX {
-public:
-	ARK1(Hash<ParamValue>& params, BaseIVP* ivp) : IMEX(params, ivp, 1) {
-		_a(0,0) = 1.;
-		_b(0) = _b2(0) = 1.;
+struct ARK1Tableau {
+	static constexpr long Stages = 1;
+	static constexpr FP A[Stages][Stages] = {
+		{ 1 }
+	};
+	static constexpr FP A2[Stages][Stages] = {
+		{ 0 }
+	};
+	static constexpr FP B[Stages] = { 1 };
+	static constexpr const FP (&B2)[Stages] = B;
+	static constexpr FP BAux[Stages] = { 0 };
+	static constexpr const FP (&BAux2)[Stages] = BAux;
+};
 
-		FillC();
-		FillC2();
+class ARK1 : public TableauIMEX<ARK1Tableau> {
+public:
+	ARK1(Hash<ParamValue>& params, BaseIVP* ivp) : TableauIMEX<ARK1Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
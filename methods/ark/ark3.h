@@ -1,40 +1,31 @@
 #ifndef ARK3_H
 #define ARK3_H
 
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class ARK3 : public IMEX {
-public:
-	ARK3(Hash<ParamValue>& params, BaseIVP* ivp) : IMEX(params, ivp, 4) {
-		_a(1,0) = 1767732205903.0/4055673282236.0;
-		_a(1,1) = _a(1,0);
-		_a(2,0) = 2746238789719.0/10658868560708.0;
-		_a(2,1) = -640167445237.0/6845629431997.0;
-		_a(2,2) = _a(1,0);
-		_a(3,0) = 1471266399579.0/7840856788654.0;
-		_a(3,1) = -4482444167858.0/7529755066697.0;
-		_a(3,2) = 11266239266428.0/11593286722821.0;
-		_a(3,3) = _a(1,0);
-
-		_a2(1,0) = 1767732205903.0/2027836641118.0;
-		_a2(2,0) = 5535828885825.0/10492691773637.0;
-		_a2(2,1) = 788022342437.0/10882634858940.0;
-		_a2(3,0) = 6485989280629.0/16251701735622.0;
-		_a2(3,1) = -4246266847089.0/9704473918619.0;
-		_a2(3,2) = 10755448449292.0/10357097424841.0;
+struct ARK3Tableau {
+	static constexpr long Stages = 4;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0 },
+		{ FP(1767732205903)/4055673282236, FP(1767732205903)/4055673282236, 0, 0 },
+		{ FP(2746238789719)/10658868560708, -FP(640167445237)/6845629431997, FP(1767732205903)/4055673282236, 0 },
+		{ FP(1471266399579)/7840856788654, -FP(4482444167858)/7529755066697, FP(11266239266428)/11593286722821, FP(1767732205903)/4055673282236 }
+	};
+	static constexpr FP A2[Stages][Stages] = {
+		{ 0, 0, 0, 0 },
+		{ FP(1767732205903)/2027836641118, 0, 0, 0 },
+		{ FP(5535828885825)/10492691773637, FP(788022342437)/10882634858940, 0, 0 },
+		{ FP(6485989280629)/16251701735622, -FP(4246266847089)/9704473918619, FP(10755448449292)/10357097424841, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1471266399579)/7840856788654, -FP(4482444167858)/7529755066697, FP(11266239266428)/11593286722821, FP(1767732205903)/4055673282236 };
+	static constexpr const FP (&B2)[Stages] = B;
+	static constexpr FP BAux[Stages] = { FP(2756255671327)/12835298489170, -FP(10771552573575)/22201958757719, FP(9247589265047)/10645013368117, FP(2193209047091)/5459859503100 };
+	static constexpr const FP (&BAux2)[Stages] = BAux;
+};
 
-		_b(0) = _b2(0) = 1471266399579.0/7840856788654.0;
-		_b(1) = _b2(1) = -4482444167858.0/7529755066697.0;
-		_b(2) = _b2(2) = 11266239266428.0/11593286722821.0;
-		_b(3) = _b2(3) = 1767732205903.0/4055673282236.0;
-		
-		_baux(0) = _baux2(0) = 2756255671327.0/12835298489170.0;
-		_baux(1) = _baux2(1) = -10771552573575.0/22201958757719.0;
-		_baux(2) = _baux2(2) = 9247589265047.0/10645013368117.0;
-		_baux(3) = _baux2(3) = 2193209047091.0/5459859503100.0;
-	
-		FillC();
-		FillC2();
+class ARK3 : public TableauIMEX<ARK3Tableau> {
+public:
+	ARK3(Hash<ParamValue>& params, BaseIVP* ivp) : TableauIMEX<ARK3Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
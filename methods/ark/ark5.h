@@ -1,74 +1,52 @@
 #ifndef ARK5_H
 #define ARK5_H
 
-#include <methods/rk.h>
+#include <methods/tableau.h>
+
+struct ARK5Tableau {
+	static constexpr long Stages = 8;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(41)/200, FP(41)/200, 0, 0, 0, 0, 0, 0 },
+		{ FP(41)/400, -FP(567603406766)/11931857230679, FP(41)/200, 0, 0, 0, 0, 0 },
+		{ FP(683785636431)/9252920307686, 0, -FP(110385047103)/1367015193373, FP(41)/200, 0, 0, 0, 0 },
+		{ FP(3016520224154)/10081342136671, 0, FP(30586259806659)/12414158314087, -FP(22760509404356)/11113319521817, FP(41)/200, 0, 0, 0 },
+		{ FP(218866479029)/1489978393911, 0, FP(638256894668)/5436446318841, -FP(1179710474555)/5321154724896, -FP(60928119172)/8023461067671, FP(41)/200, 0, 0 },
+		{ FP(1020004230633)/5715676835656, 0, FP(25762820946817)/25263940353407, -FP(2161375909145)/9755907335909, -FP(211217309593)/5846859502534, -FP(4269925059573)/7827059040749, FP(41)/200, 0 },
+		{ -FP(872700587467)/9133579230613, 0, 0, FP(22348218063261)/9555858737531, -FP(1143369518992)/8141816002931, -FP(39379526789629)/19018526304540, FP(32727382324388)/42900044865799, FP(41)/200 }
+	};
+	static constexpr FP A2[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(41)/100, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(367902744464)/2072280473677, FP(677623207551)/8224143866563, 0, 0, 0, 0, 0, 0 },
+		{ FP(1268023523408)/10340822734521, 0, FP(1029933939417)/13636558850479, 0, 0, 0, 0, 0 },
+		{ FP(14463281900351)/6315353703477, 0, FP(66114435211212)/5879490589093, -FP(54053170152839)/4284798021562, 0, 0, 0, 0 },
+		{ FP(14090043504691)/34967701212078, 0, FP(15191511035443)/11219624916014, -FP(18461159152457)/12425892160975, -FP(281667163811)/9011619295870, 0, 0, 0 },
+		{ FP(19230459214898)/13134317526959, 0, FP(21275331358303)/2942455364971, -FP(38145345988419)/4862620318723, -FP(1)/8, -FP(1)/8, 0, 0 },
+		{ -FP(19977161125411)/11928030595625, 0, -FP(40795976796054)/6384907823539, FP(177454434618887)/12078138498510, FP(782672205425)/8267701900261, -FP(69563011059811)/9646580694205, FP(7356628210526)/4942186776405, 0 }
+	};
+	static constexpr FP B[Stages] = { -FP(872700587467)/9133579230613, 0, 0, FP(22348218063261)/9555858737531, -FP(1143369518992)/8141816002931, -FP(39379526789629)/19018526304540, FP(32727382324388)/42900044865799, FP(41)/200 };
+	static constexpr const FP (&B2)[Stages] = B;
+	static constexpr FP BAux[Stages] = { -FP(975461918565)/9796059967033, 0, 0, FP(78070527104295)/32432590147079, -FP(548382580838)/3424219808633, -FP(33438840321285)/15594753105479, FP(3629800801594)/4656183773603, FP(4035322873751)/18575991585200 };
+	static constexpr const FP (&BAux2)[Stages] = BAux;
+};
 
-class ARK5 : public IMEX {
+class ARK5 : public TableauIMEX<ARK5Tableau> {
 public:
-	ARK5(Hash<ParamValue>& params, BaseIVP* ivp) : IMEX(params, ivp, 8) {
-		_a(1,0) = 41.0/200.0; _a(1,1) = 41.0/200.0;
-		_a(2,0) = 41.0/400.0; _a(2,1) = -567603406766.0/11931857230679.0; _a(2,2) = 41.0/200.0;
-		_a(3,0) = 683785636431.0/9252920307686.0; _a(3,2) = -110385047103.0/1367015193373.0; _a(3,3) = 41.0/200.0;
-
-		_a(4,0) = 3016520224154.0/10081342136671.0; _a(4,2) = 30586259806659.0/12414158314087.0;
-		_a(4,3) = -22760509404356.0/11113319521817.0; _a(4,4) = 41.0/200.0;
-
-		_a(5,0) = 218866479029.0/1489978393911.0; _a(5,2) = 638256894668.0/5436446318841.0;
-		_a(5,3) = -1179710474555.0/5321154724896.0; _a(5,4) = -60928119172.0/8023461067671.0; _a(5,5) = 41.0/200.0;
-
-		_a(6,0) = 1020004230633.0/5715676835656.0; _a(6,2) = 25762820946817.0/25263940353407.0; _a(6,3) = -2161375909145.0/9755907335909.0;
-		_a(6,4) = -211217309593.0/5846859502534.0; _a(6,5) = -4269925059573.0/7827059040749.0; _a(6,6) = 41.0/200.0;
-
-		_a(7,0) = -872700587467.0/9133579230613.0; _a(7,3) = 22348218063261.0/9555858737531.0; _a(7,4) = -1143369518992.0/8141816002931.0;
-		_a(7,5) = -39379526789629.0/19018526304540.0; _a(7,6) = 32727382324388.0/42900044865799.0; _a(7,7) = 41.0/200.0;
-		
-		_a2(1,0) = 41.0/100.0;
-		_a2(2,0) = 367902744464.0/2072280473677.0; _a2(2,1) = 677623207551.0/8224143866563.0;
-
-		_a2(3,0) = 1268023523408.0/10340822734521.0; _a2(3,2) = 1029933939417.0/13636558850479.0;
-
-		_a2(4,0) = 14463281900351.0/6315353703477.0; _a2(4,2) = 66114435211212.0/5879490589093.0;
-		_a2(4,3) = -54053170152839.0/4284798021562.0;
-
-		_a2(5,0) = 14090043504691.0/34967701212078.0; _a2(5,2) = 15191511035443.0/11219624916014.0;
-		_a2(5,3) = -18461159152457.0/12425892160975.0; _a2(5,4) = -281667163811.0/9011619295870.0;
-
-		_a2(6,0) = 19230459214898.0/13134317526959.0; _a2(6,2) = 21275331358303.0/2942455364971.0;
-		_a2(6,3) = -38145345988419.0/4862620318723.0; _a2(6,4) = -1.0/8.0; _a2(6,5) = -1.0/8.0;
-
-		_a2(7,0) = -19977161125411.0/11928030595625.0; _a2(7,2) = -40795976796054.0/6384907823539.0;
-		_a2(7,3) = 177454434618887.0/12078138498510.0; _a2(7,4) = 782672205425.0/8267701900261.0;
-		_a2(7,5) = -69563011059811.0/9646580694205.0; _a2(7,6) = 7356628210526.0/4942186776405.0;
-
-		_b(0) = _b2(0) = -872700587467.0/9133579230613.0;
-		_b(3) = _b2(3) = 22348218063261.0/9555858737531.0;
-		_b(4) = _b2(4) = -1143369518992.0/8141816002931.0;
-		_b(5) = _b2(5) = -39379526789629.0/19018526304540.0;
-		_b(6) = _b2(6) = 32727382324388.0/42900044865799.0;
-		_b(7) = _b2(7) = 41.0/200.0;
-
-		_baux(0) = _baux2(0) = -975461918565.0/9796059967033.0;
-		_baux(3) = _baux2(3) = 78070527104295.0/32432590147079.0;
-		_baux(4) = _baux2(4) = -548382580838.0/3424219808633.0;
-		_baux(5) = _baux2(5) = -33438840321285.0/15594753105479.0;
-		_baux(6) = _baux2(6) = 3629800801594.0/4656183773603.0;
-		_baux(7) = _baux2(7) = 4035322873751.0/18575991585200.0;
-
-		FillC();
-		FillC2();
-	}   
+	ARK5(Hash<ParamValue>& params, BaseIVP* ivp) : TableauIMEX<ARK5Tableau>(params, ivp) {
+	}
 
 	virtual const char* GetName() const {
 		return "ARK 5(4)";
-	}   
+	}
 
 	virtual long GetOrder() const {
 		return 5;
-	}   
+	}
 
 	virtual long GetAuxOrder() const {
 		return 4;
-	}   
+	}
 };
 
 #endif
@@ -4,9 +4,9 @@
 BaseMethod::BaseMethod(Hash<ParamValue>& params, BaseIVP* ivp) : _ivp(ivp) {
 	_acceptedSteps = 0;
 	_dtOld = 0;
+	_solverATol = 0;
+	_solverRTol = 0;
 
-	_newtonFail = GetDefaultFP(params, "newton fail", 1e20);
-	_newtonTol = GetDefaultFP(params, "newton tol", 1e-8);
 	_sparse = (bool)GetDefaultLong(params, "sparse", 0);
 	_benchmark = (bool)GetDefaultLong(params, "benchmark", 0);
 }
@@ -19,6 +19,11 @@ void BaseMethod::SetSolverVariables(long* acceptedSteps, FP* dtold) {
 	_dtOld = dtold;
 }
 
+void BaseMethod::SetTolerances(FP atol, FP rtol) {
+	_solverATol = atol;
+	_solverRTol = rtol;
+}
+
 void BaseMethod::SetAccept(bool accept) {
 	_accept = accept;
 }
@@ -36,6 +41,49 @@ void BaseMethod::PostStep(const FP tn, FP& dt, Vec<FP>& yn) {
 void BaseMethod::UpdateTimestep() {
 }
 
+void BaseMethod::Restart() {
+}
+
+// Cubic Hermite interpolation between the end points of the step. Derivatives
+// the method already has are passed in, the rest are evaluated here.
+void BaseMethod::HermiteStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew,
+							 const Vec<FP>* fn, const Vec<FP>* fnew) {
+	_denseT = tn;
+	_denseDt = dt;
+	_denseY0 = yn;
+	_denseY1 = ynew;
+
+	if( fn ) {
+		_denseF0 = *fn;
+	} else {
+		_denseF0.Resize(yn.Size());
+		(*_ivp)(tn, yn, _denseF0);
+	}
+
+	if( fnew ) {
+		_denseF1 = *fnew;
+	} else {
+		_denseF1.Resize(yn.Size());
+		(*_ivp)(tn + dt, ynew, _denseF1);
+	}
+}
+
+void BaseMethod::DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+	HermiteStep(tn, dt, yn, ynew);
+}
+
+void BaseMethod::Interpolate(FP t, Vec<FP>& y) const {
+	FP theta = (t - _denseT)/_denseDt;
+	FP theta1 = theta - 1;
+
+	y.Resize(_denseY0.Size());
+	for( long i = 0; i < y.Size(); i++ ) {
+		FP diff = _denseY1[i] - _denseY0[i];
+		y[i] = _denseY0[i] + theta*diff
+			 + theta*theta1*((1-2*theta)*diff + _denseDt*(theta1*_denseF0[i] + theta*_denseF1[i]));
+	}
+}
+
 FP BaseMethod::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
 	throw Exception() << "Error calculation is not implemented for " << GetName() << ".";
 }
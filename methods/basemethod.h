@@ -17,8 +17,21 @@ protected:
 	bool _sparse;
 	bool _benchmark;
 	
-	FP _newtonFail;
-	FP _newtonTol;
+	// Tolerances of the step control solver driving the method, zero under
+	// fixed steps
+	FP _solverATol;
+	FP _solverRTol;
+
+	// Continuous extension of the last accepted step [_denseT, _denseT+_denseDt]
+	FP _denseT;
+	FP _denseDt;
+	Vec<FP> _denseY0;
+	Vec<FP> _denseY1;
+	Vec<FP> _denseF0;
+	Vec<FP> _denseF1;
+
+	void HermiteStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew,
+					 const Vec<FP>* fn = 0, const Vec<FP>* fnew = 0);
 
 public:
 	BaseMethod(Hash<ParamValue>& params, BaseIVP* ivp);
@@ -26,6 +39,10 @@ public:
 
 	void SetSolverVariables(long* acceptedSteps, FP* dtOld);
 	void SetAccept(bool accept);
+
+	// Called by step control solvers, so that inner iterations can stop at a
+	// fraction of the error they allow
+	virtual void SetTolerances(FP atol, FP rtol);
 	bool Accept() const;
 
 	virtual void PreStep(const FP tn, FP& dt, Vec<FP>& yn);
@@ -33,6 +50,13 @@ public:
 	virtual void Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) = 0;
 	virtual void UpdateTimestep();
 
+	// Forgets whatever is carried from one step to the next, for a method
+	// driven by another one that changes its right hand side between steps
+	virtual void Restart();
+
+	virtual void DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew);
+	virtual void Interpolate(FP t, Vec<FP>& y) const;
+
 	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
 	
 	virtual void GetStats(Hash<ParamValue>& params) const;
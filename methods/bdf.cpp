@@ -0,0 +1,265 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/bdf.h>
+
+BDF::BDF(Hash<ParamValue>& params, BaseIVP* ivp) : NordsieckMethod(params, ivp, BDF_MAX_ORDER) {
+	_maxJacAge = GetDefaultLong(params, "bdf jacobian age", 20);
+	_newtonIterations = GetDefaultLong(params, "bdf newton iterations", 3);
+	_krylov = GetDefaultLong(params, "bdf krylov", 0);
+	if( _krylov < 0 )
+		throw Exception() << "bdf krylov must be zero (direct solves) or the Krylov dimension.";
+
+	SetCoefficients();
+
+	_jacValid = false;
+	_jacAge = 0;
+	_gammaMat = 0;
+
+	_statNewtonIterations = 0;
+	_statNewtonFailures = 0;
+	_statJacobians = 0;
+	_statFactorizations = 0;
+	_statLinearIterations = 0;
+
+	if( _sparse ) {
+		_jac = new CSRMat<FP>;
+		_newtonMat = new CSRMat<FP>;
+	} else {
+		_jac = new Mat<FP>;
+		_newtonMat = new Mat<FP>;
+	}
+}
+
+BDF::~BDF() {
+	delete _jac;
+	delete _newtonMat;
+}
+
+FP BDF::Harmonic(long q) {
+	FP h = 0;
+	for( long i = 1; i <= q; i++ )
+		h += FP(1)/i;
+	return h;
+}
+
+// Corrector coefficients of order q: l(x) = prod_{i=1}^{q} (1 + x/i)
+void BDF::SetCoefficients() {
+	for( long j = 0; j <= NORDSIECK_MAX_ORDER; j++ )
+		_l[j] = 0;
+	_l[0] = 1;
+
+	for( long i = 1; i <= _q; i++ )
+		for( long j = i; j > 0; j-- )
+			_l[j] += _l[j-1]/i;
+}
+
+void BDF::UpdateJacobian(FP t, const Vec<FP>& y) {
+	if( _sparse )
+		*(CSRMat<FP>*)_jac = *(const CSRMat<FP>*)_ivp->JacSparse(t, y);
+	else
+		*(Mat<FP>*)_jac = *(const Mat<FP>*)_ivp->Jac(t, y);
+
+	_jacValid = true;
+	_jacAge = 0;
+	_statJacobians++;
+}
+
+void BDF::FactorNewtonMatrix(FP gamma) {
+	long n = _acor.Size();
+	if( _sparse )
+		*(CSRMat<FP>*)_newtonMat = CSRMat<FP>::Eye(n) - gamma**(CSRMat<FP>*)_jac;
+	else
+		*(Mat<FP>*)_newtonMat = Mat<FP>::Eye(n) - gamma**(Mat<FP>*)_jac;
+
+	_newtonMat->Factor();
+	_gammaMat = gamma;
+	_crate = 1;
+	_statFactorizations++;
+}
+
+// Unpreconditioned GMRES on I - gamma J, with J applied by difference quotients
+// around (t, y) where f = f(t, y). The iteration runs in the space scaled by the
+// error weights, so tol is a bound on the weighted RMS norm of the residual.
+void BDF::KrylovSolve(FP t, const Vec<FP>& y, const Vec<FP>& f, FP gamma, const Vec<FP>& r, Vec<FP>& x, FP tol) {
+	long n = y.Size();
+	long m = _krylov;
+
+	std::vector< Vec<FP> > v(m+1);
+	Mat<FP> h(m+1, m);
+	Vec<FP> cs(m), sn(m), g(m+1);
+	Vec<FP> u(n), w(n), yp(n);
+
+	x.Resize(n);
+	x.Zero();
+
+	v[0] = r/_tol;
+	FP beta = v[0].Norm();
+	if( beta == 0 )
+		return;
+
+	v[0] /= beta;
+	g.Zero();
+	g(0) = beta;
+	FP target = tol*sqrt(FP(n));
+
+	long k = 0;
+	while( k < m ) {
+		// The perturbation has unit weighted RMS norm
+		u = v[k]*_tol;
+		FP sigma = sqrt(FP(n));
+		yp = y;
+		yp.AddScaled(sigma, u);
+		(*_ivp)(t, yp, w);
+		_rhsEvals++;
+		_statLinearIterations++;
+
+		w -= f;
+		w *= -gamma/sigma;
+		w += u;
+		w /= _tol;
+
+		// Modified Gram-Schmidt
+		for( long i = 0; i <= k; i++ ) {
+			FP d = 0;
+			for( long j = 0; j < n; j++ )
+				d += w[j]*v[i][j];
+			h(i,k) = d;
+			w.AddScaled(-d, v[i]);
+		}
+		FP hk1 = w.Norm();
+
+		// Reduce the Hessenberg column with Givens rotations
+		for( long i = 0; i < k; i++ ) {
+			FP a = h(i,k);
+			FP b = h(i+1,k);
+			h(i,k) = cs(i)*a + sn(i)*b;
+			h(i+1,k) = -sn(i)*a + cs(i)*b;
+		}
+
+		FP denom = sqrt(sqr(h(k,k)) + sqr(hk1));
+		if( denom == 0 )
+			break;
+
+		cs(k) = h(k,k)/denom;
+		sn(k) = hk1/denom;
+		h(k,k) = denom;
+		g(k+1) = -sn(k)*g(k);
+		g(k) = cs(k)*g(k);
+		k++;
+
+		if( fabs(g(k)) <= target || hk1 == 0 )
+			break;
+
+		v[k] = w/hk1;
+	}
+
+	Vec<FP> c(k);
+	for( long i = k-1; i >= 0; i-- ) {
+		c(i) = g(i);
+		for( long j = i+1; j < k; j++ )
+			c(i) -= h(i,j)*c(j);
+		c(i) /= h(i,i);
+	}
+
+	for( long i = 0; i < k; i++ )
+		x.AddScaled(c(i), v[i]);
+	x *= _tol;
+}
+
+// Solves acor - gamma f(t, z0 + acor) + z1/l1 = 0 for the correction to the
+// predicted history _zn.
+bool BDF::NewtonSolve(FP t, FP gamma) {
+	long n = _acor.Size();
+	Vec<FP> y(n), f(n), r(n), delta(n);
+
+	if( !_krylov ) {
+		if( !_jacValid || _jacAge >= _maxJacAge ) {
+			UpdateJacobian(t, _zn[0]);
+			FactorNewtonMatrix(gamma);
+		} else if( fabs(gamma/_gammaMat - 1) > 0.3 ) {
+			FactorNewtonMatrix(gamma);
+		}
+	}
+
+	// A matrix factored for an older gamma is compensated for by scaling
+	FP ratio = _krylov ? 1 : gamma/_gammaMat;
+	FP errConst = 1/ErrorConstant(_q);
+
+	_acor.Zero();
+	y = _zn[0];
+
+	FP delp = 0;
+	for( long m = 0; m < _newtonIterations; m++ ) {
+		(*_ivp)(t, y, f);
+		_rhsEvals++;
+		_statNewtonIterations++;
+
+		r = f;
+		r *= gamma;
+		r.AddScaled(-1/_l[1], _zn[1]);
+		r -= _acor;
+
+		if( _krylov ) {
+			KrylovSolve(t, y, f, gamma, r, delta, 0.005*errConst);
+		} else {
+			_newtonMat->Solve(r, delta);
+			if( ratio != 1 )
+				delta *= 2/(1+ratio);
+		}
+
+		_acor += delta;
+		y = _zn[0];
+		y += _acor;
+
+		FP del = (delta/_tol).RMS();
+		if( m > 0 )
+			_crate = std::max(FP(0.3)*_crate, del/delp);
+
+		if( del*std::min(FP(1), _crate)/errConst <= 0.1 )
+			return true;
+
+		if( del != del || (m > 0 && del > 2*delp) )
+			break;
+		delp = del;
+	}
+
+	return false;
+}
+
+// Retry once with a fresh Jacobian before giving up on the step
+bool BDF::Correct(FP t) {
+	FP gamma = _h/_l[1];
+	bool converged = NewtonSolve(t, gamma);
+
+	if( !converged && !_krylov && _jacAge > 0 ) {
+		_jacValid = false;
+		converged = NewtonSolve(t, gamma);
+	}
+
+	if( !converged )
+		_statNewtonFailures++;
+	return converged;
+}
+
+void BDF::UpdateTimestep() {
+	NordsieckMethod::UpdateTimestep();
+	_jacAge++;
+}
+
+// The local error of BDF of order k is h^(k+1) y^(k+1)/((k+1) l_1)
+FP BDF::ErrorConstant(long order) const {
+	return 1/((order+1)*Harmonic(order));
+}
+
+void BDF::GetStats(Hash<ParamValue>& params) const {
+	NordsieckMethod::GetStats(params);
+	params["newton iterations"].SetLong(_statNewtonIterations);
+	params["newton failures"].SetLong(_statNewtonFailures);
+	params["jacobian evaluations"].SetLong(_statJacobians);
+	params["factorizations"].SetLong(_statFactorizations);
+	params["linear iterations"].SetLong(_statLinearIterations);
+}
+
+const char* BDF::GetName() const {
+	return "BDF";
+}
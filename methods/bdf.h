@@ -0,0 +1,55 @@
+#ifndef BDF_METHOD_H
+#define BDF_METHOD_H
+
+#include <core/common.h>
+#include <core/csrmat.h>
+#include <methods/nordsieck.h>
+
+#define BDF_MAX_ORDER 5
+
+// Variable order BDF for stiff problems. Each step is a single implicit solve
+// with the modified Newton matrix I - gamma J, which is only formed again when
+// gamma drifts or the Jacobian is refreshed.
+class BDF : public NordsieckMethod {
+protected:
+	BaseMat<FP>* _jac;
+	BaseMat<FP>* _newtonMat;
+	bool _jacValid;
+	long _jacAge;
+	long _maxJacAge;
+	FP _gammaMat;
+	long _newtonIterations;
+
+	// Matrix free GMRES instead of a factored Newton matrix
+	long _krylov;
+
+	// Stats
+	long _statNewtonIterations;
+	long _statNewtonFailures;
+	long _statJacobians;
+	long _statFactorizations;
+	long _statLinearIterations;
+
+	void UpdateJacobian(FP t, const Vec<FP>& y);
+	void FactorNewtonMatrix(FP gamma);
+	bool NewtonSolve(FP t, FP gamma);
+	void KrylovSolve(FP t, const Vec<FP>& y, const Vec<FP>& f, FP gamma, const Vec<FP>& r, Vec<FP>& x, FP tol);
+
+	virtual void SetCoefficients();
+	virtual bool Correct(FP t);
+	virtual FP ErrorConstant(long order) const;
+
+	static FP Harmonic(long q);
+
+public:
+	BDF(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~BDF();
+
+	virtual void UpdateTimestep();
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -2,20 +2,23 @@
 #define BS23_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class BS23 : public ERK {
-public:
-	BS23(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 4) {
-		_a(1,0) = 1./2;
-		_a(2,0) = 0;  _a(2,1) = 3./4;
-		_a(3,0) = 2./9; _a(3,1) = 1./3; _a(3,2) = 4./9;
+struct BS23Tableau {
+	static constexpr long Stages = 4;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0 },
+		{ FP(1)/2, 0, 0, 0 },
+		{ 0, FP(3)/4, 0, 0 },
+		{ FP(2)/9, FP(1)/3, FP(4)/9, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(2)/9, FP(1)/3, FP(4)/9, 0 };
+	static constexpr FP BAux[Stages] = { FP(7)/24, FP(1)/4, FP(1)/3, FP(1)/8 };
+};
 
-		_b(0) = 2./9; _b(1) = 1./3; _b(2) = 4./9; _b(3) = 0;
-		
-		_baux(0) = 7./24; _baux(1) = 1./4; _baux(2) = 1./3; _baux(3) = 1./8;
-	
-		FillC();
+class BS23 : public TableauERK<BS23Tableau> {
+public:
+	BS23(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<BS23Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
@@ -2,30 +2,58 @@
 #define DOPR54_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
+
+struct DOPR54Tableau {
+	static constexpr long Stages = 7;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(1)/5, 0, 0, 0, 0, 0, 0 },
+		{ FP(3)/40, FP(9)/40, 0, 0, 0, 0, 0 },
+		{ FP(44)/45, -FP(56)/15, FP(32)/9, 0, 0, 0, 0 },
+		{ FP(19372)/6561, -FP(25360)/2187, FP(64448)/6561, -FP(212)/729, 0, 0, 0 },
+		{ FP(9017)/3168, -FP(355)/33, FP(46732)/5247, FP(49)/176, -FP(5103)/18656, 0, 0 },
+		{ FP(35)/384, 0, FP(500)/1113, FP(125)/192, -FP(2187)/6784, FP(11)/84, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(35)/384, 0, FP(500)/1113, FP(125)/192, -FP(2187)/6784, FP(11)/84, 0 };
+	static constexpr FP BAux[Stages] = { FP(5179)/57600, 0, FP(7571)/16695, FP(393)/640, -FP(92097)/339200, FP(187)/2100, FP(1)/40 };
+
+	// Dense output weights of the order 4 continuous extension
+	static constexpr FP D[Stages] = { -FP(12715105075)/11282082432, 0, FP(87487479700)/32700410799,
+		-FP(10690763975)/1880347072, FP(701980252875)/199316789632, -FP(1453857185)/822651844, FP(69997945)/29380423 };
+};
+
+class DOPR54 : public TableauERK<DOPR54Tableau> {
+	Vec<FP> _cont[5];
 
-class DOPR54 : public ERK {
 public:
-	DOPR54(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 7) {
-		_a(1,0) = 1./5;
-		_a(2,0) = 3./40;  _a(2,1) = 9./40;
-		_a(3,0) = 44./45; _a(3,1) = -56./15; _a(3,2) = 32./9;
+	DOPR54(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<DOPR54Tableau>(params, ivp) {
+	}
 
-		_a(4,0) = 19372./6561; _a(4,1) = -25360./2187; _a(4,2) = 64448./6561; _a(4,3) = -212./729;
+	virtual void DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+		_denseT = tn;
+		_denseDt = dt;
 
-		_a(5,0) = 9017./3168; _a(5,1) = -355./33;     _a(5,2) = 46732./5247;
-		_a(5,3) = 49./176;    _a(5,4) = -5103./18656;
+		_cont[0] = yn;
+		_cont[1] = ynew - yn;
+		_cont[2] = dt*_k[0] - _cont[1];
+		_cont[3] = _cont[1] - dt*_k[6] - _cont[2];
 
-		_a(6,0) = 35./384;  _a(6,1) = 0;           _a(6,2) = 500./1113;
-		_a(6,3) = 125./192; _a(6,4) = -2187./6784; _a(6,5) = 11./84;
+		_cont[4].Resize(yn.Size());
+		_cont[4].Zero();
+		for( long i = 0; i < S; i++ )
+			if( DOPR54Tableau::D[i] != 0 )
+				_cont[4].AddScaled(DOPR54Tableau::D[i], _k[i]);
+		_cont[4] *= dt;
+	}
 
-		_b(0) = 35./384; _b(1) = 0; _b(2) = 500./1113; _b(3) = 125./192;
-		_b(4) = -2187./6784; _b(5) = 11./84.;
+	virtual void Interpolate(FP t, Vec<FP>& y) const {
+		FP theta = (t - _denseT)/_denseDt;
+		FP theta1 = 1 - theta;
 
-		_baux(0) = 5179./57600; _baux(1) = 0; _baux(2) = 7571./16695; _baux(3) = 393./640;
-		_baux(4) = -92097./339200; _baux(5) = 187./2100; _baux(6) = 1./40;
-	
-		FillC();
+		y.Resize(_cont[0].Size());
+		for( long i = 0; i < y.Size(); i++ )
+			y[i] = _cont[0][i] + theta*(_cont[1][i] + theta1*(_cont[2][i] + theta*(_cont[3][i] + theta1*_cont[4][i])));
 	}
 
 	virtual const char* GetName() const {
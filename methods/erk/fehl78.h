@@ -2,51 +2,32 @@
 #define FEHL78_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
+
+struct FEHL78Tableau {
+	static constexpr long Stages = 13;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(2)/27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(1)/36, FP(1)/12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(1)/24, 0, FP(1)/8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(5)/12, 0, -FP(25)/16, FP(25)/16, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(1)/20, 0, 0, FP(1)/4, FP(1)/5, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ -FP(25)/108, 0, 0, FP(125)/108, -FP(65)/27, FP(125)/54, 0, 0, 0, 0, 0, 0, 0 },
+		{ FP(31)/300, 0, 0, 0, FP(61)/225, -FP(2)/9, FP(13)/900, 0, 0, 0, 0, 0, 0 },
+		{ 2, 0, 0, -FP(53)/6, FP(704)/45, -FP(107)/9, FP(67)/90, 3, 0, 0, 0, 0, 0 },
+		{ -FP(91)/108, 0, 0, FP(23)/108, -FP(976)/135, FP(311)/54, -FP(19)/60, FP(17)/6, -FP(1)/12, 0, 0, 0, 0 },
+		{ FP(2383)/4100, 0, 0, -FP(341)/164, FP(4496)/1025, -FP(301)/82, FP(2133)/4100, FP(45)/82, FP(45)/164, FP(18)/41, 0, 0, 0 },
+		{ FP(3)/205, 0, 0, 0, 0, -FP(6)/41, -FP(3)/205, -FP(3)/41, FP(3)/41, FP(6)/41, 0, 0, 0 },
+		{ -FP(1777)/4100, 0, 0, -FP(341)/164, FP(4496)/1025, -FP(289)/82, FP(2193)/4100, FP(51)/82, FP(33)/164, FP(12)/41, 0, 1, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(41)/840, 0, 0, 0, 0, FP(34)/105, FP(9)/35, FP(9)/35, FP(9)/280, FP(9)/280, FP(41)/840, 0, 0 };
+	static constexpr FP BAux[Stages] = { 0, 0, 0, 0, 0, FP(34)/105, FP(9)/35, FP(9)/35, FP(9)/280, FP(9)/280, 0, FP(41)/840, FP(41)/840 };
+};
 
-class FEHL78 : public ERK {
+class FEHL78 : public TableauERK<FEHL78Tableau> {
 public:
-	FEHL78(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 13) {
-		_a(1,0)  = 2./27.;
-		_a(2,0)  = 1./36.; _a(2,1) = 1./12.;
-		_a(3,0)  = 1./24.; _a(3,2) = 1./8.;
-		_a(4,0)  = 5./12.; _a(4,2) = -25./16.; _a(4,3) = 25./16.;
-
-		_a(5,0)  = 1./20.; _a(5,3) = 1./4.; _a(5,4) = 1./5.;
-
-		_a(6,0)  = -25./108.; _a(6,3) = 125./108.; _a(6,4) = -65./27.; _a(6,5) = 125./54.;
-
-		_a(7,0)  = 31./300.; _a(7,4) = 61./225.;
-		_a(7,5) = -2./9.; _a(7,6) = 13./900.;
-
-		_a(8,0)  = 2.;       _a(8,3) = -53./6.; _a(8,4) = 704./45.;
-		_a(8,5)  = -107./9.; _a(8,6) = 67./90.; _a(8,7) = 3.; 
-
-		_a(9,0)  = -91./108.; _a(9,3) = 23./108.; _a(9,4) = -976./135.; _a(9,5) = 311./54.; _a(9,6) = -19./60.; _a(9,7) = 17./6.; _a(9,8) = -1./12.;
-
-		_a(10,0) = 2383./4100.; _a(10,3) = -341./164.;  _a(10,4) = 4496./1025.;
-		_a(10,5) = -301./82.;   _a(10,6) = 2133./4100.; _a(10,7) = 45./82.;
-		_a(10,8) = 45./164.;    _a(10,9) = 18./41.;
-
-		_a(11,0) = 3./205.; _a(11,5) = -6./41.; _a(11,6) = -3./205.;
-		_a(11,7) = -3./41.; _a(11,8) = 3./41.;  _a(11,9) = 6./41.;
-
-		_a(12,0) = -1777./4100.; _a(12,3) = -341./164.;  _a(12,4) = 4496./1025.;
-		_a(12,5) = -289./82.;    _a(12,6) = 2193./4100.; _a(12,7) = 51./82.;
-		_a(12,8) = 33./164.;     _a(12,9) = 12./41.;     _a(12,11) = 1.; 
-
-		_b(0) = 41./840.; _b(5) = 34./105.; _b(6) = 9./35.;
-		_b(7) = 9./35.; _b(8) = 9./280.; _b(9) = 9./280.;
-		_b(10) = 41./840.;
-
-		_baux(5) = 34./105.; _baux(6) = 9./35.;
-		_baux(7) = 9./35.;
-		_baux(8) = 9./280.;
-		_baux(9) = 9./280.;
-		_baux(11) = 41./840.;
-		_baux(12) = 41./840.;
-		
-		FillC();
+	FEHL78(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<FEHL78Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
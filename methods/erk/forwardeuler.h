@@ -2,12 +2,20 @@
 #define FORWARD_EULER_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class ForwardEuler : public ERK {
+struct ForwardEulerTableau {
+	static constexpr long Stages = 1;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0 }
+	};
+	static constexpr FP B[Stages] = { 1 };
+	static constexpr FP BAux[Stages] = { 0 };
+};
+
+class ForwardEuler : public TableauERK<ForwardEulerTableau> {
 public:
-	ForwardEuler(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 1) {
-		_b(0) = 1;
+	ForwardEuler(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<ForwardEulerTableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
@@ -2,16 +2,21 @@
 #define HEUN2_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class Heun2 : public ERK {
+struct Heun2Tableau {
+	static constexpr long Stages = 2;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0 },
+		{ 1, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/2, FP(1)/2 };
+	static constexpr FP BAux[Stages] = { FP(65)/100, FP(35)/100 };
+};
+
+class Heun2 : public TableauERK<Heun2Tableau> {
 public:
-	Heun2(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 2) {
-		_a(1,0) = 1.;
-		_b(0) = 1./2;  _b(1) =1./2;
-		_baux(0) = 0.65; _baux(1) = 0.35;
-	
-		FillC();
+	Heun2(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<Heun2Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
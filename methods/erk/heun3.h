@@ -2,15 +2,22 @@
 #define HEUN3_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class Heun3 : public ERK {
+struct Heun3Tableau {
+	static constexpr long Stages = 3;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0 },
+		{ FP(1)/3, 0, 0 },
+		{ 0, FP(2)/3, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/4, 0, FP(3)/4 };
+	static constexpr FP BAux[Stages] = { 0, 0, 0 };
+};
+
+class Heun3 : public TableauERK<Heun3Tableau> {
 public:
-	Heun3(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 3) {
-		_a(1,0) = 1./3; _a(2,1) = 2./3;
-		_b(0) = 1./4;  _b(2) =3./4;
-	
-		FillC();
+	Heun3(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<Heun3Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
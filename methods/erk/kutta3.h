@@ -2,17 +2,22 @@
 #define KUTTA3_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class Kutta3 : public ERK {
+struct Kutta3Tableau {
+	static constexpr long Stages = 3;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0 },
+		{ FP(1)/2, 0, 0 },
+		{ -1, 2, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/6, FP(2)/3, FP(1)/6 };
+	static constexpr FP BAux[Stages] = { 0, 0, 0 };
+};
+
+class Kutta3 : public TableauERK<Kutta3Tableau> {
 public:
-	Kutta3(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 3) {
-		_a(1,0) = 1./2;
-		_a(2,0) = -1;
-		_a(2,1) = 2;
-		
-		_b(0) = 1./6; _b(1) = 2./3; _b(2) = 1./6;
-		FillC();
+	Kutta3(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<Kutta3Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
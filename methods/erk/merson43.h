@@ -2,21 +2,24 @@
 #define MERSON43_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class Merson43 : public ERK {
-public:
-	Merson43(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 5) {
-		_a(1,0) = 1./3;
-		_a(2,0) = 1./6; _a(2,1) = 1./6;
-		_a(3,0) = 1./8; _a(3,1) = 0;    _a(3,2) =  3./8;
-		_a(4,0) = 1./2; _a(4,1) = 0;    _a(4,2) = -3./2; _a(4,3) = 2.;
-
-		_b(0) = 1./6; _b(1) = 0; _b(2) = 0; _b(3) = 2./3; _b(4) = 1./6;
+struct Merson43Tableau {
+	static constexpr long Stages = 5;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0 },
+		{ FP(1)/3, 0, 0, 0, 0 },
+		{ FP(1)/6, FP(1)/6, 0, 0, 0 },
+		{ FP(1)/8, 0, FP(3)/8, 0, 0 },
+		{ FP(1)/2, 0, -FP(3)/2, 2, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/6, 0, 0, FP(2)/3, FP(1)/6 };
+	static constexpr FP BAux[Stages] = { FP(1)/10, 0, FP(3)/10, FP(2)/5, FP(1)/5 };
+};
 
-		_baux(0) = 1./10; _baux(1) = 0; _baux(2) = 3./10; _baux(3) = 2./5; _baux(4) = 1./5;
-	
-		FillC();
+class Merson43 : public TableauERK<Merson43Tableau> {
+public:
+	Merson43(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<Merson43Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
@@ -2,18 +2,23 @@
 #define RK38_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class RK38 : public ERK {
-public:
-	RK38(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 4) {
-		_a(1,0) =  1./3;
-		_a(2,0) = -1./3; _a(2,1) =  1.;
-		_a(3,0) =  1.;   _a(3,1) = -1.; _a(3,2) = 1.;
+struct RK38Tableau {
+	static constexpr long Stages = 4;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0 },
+		{ FP(1)/3, 0, 0, 0 },
+		{ -FP(1)/3, 1, 0, 0 },
+		{ 1, -1, 1, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/8, FP(3)/8, FP(3)/8, FP(1)/8 };
+	static constexpr FP BAux[Stages] = { 0, 0, 0, 0 };
+};
 
-		_b(0) = 1./8;  _b(1) = 3./8;
-		_b(2) = 3./8;  _b(3) = 1./8;
-		FillC();
+class RK38 : public TableauERK<RK38Tableau> {
+public:
+	RK38(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<RK38Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
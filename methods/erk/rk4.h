@@ -2,17 +2,23 @@
 #define RK4_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class RK4 : public ERK {
+struct RK4Tableau {
+	static constexpr long Stages = 4;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0 },
+		{ FP(1)/2, 0, 0, 0 },
+		{ 0, FP(1)/2, 0, 0 },
+		{ 0, 0, 1, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/6, FP(1)/3, FP(1)/3, FP(1)/6 };
+	static constexpr FP BAux[Stages] = { 0, 0, 0, 0 };
+};
+
+class RK4 : public TableauERK<RK4Tableau> {
 public:
-	RK4(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 4) {
-		_a(1,0) = 1./2;
-		_a(2,1) = 1./2;
-		_a(3,2) = 1.;
-		_b(0) = 1./6;  _b(1) =1./3;
-		_b(2) =1./3;   _b(3) = 1./6;
-		FillC();
+	RK4(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<RK4Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
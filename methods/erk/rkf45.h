@@ -2,23 +2,25 @@
 #define RKF45_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class RKF45 : public ERK {
+struct RKF45Tableau {
+	static constexpr long Stages = 6;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0, 0 },
+		{ FP(1)/4, 0, 0, 0, 0, 0 },
+		{ FP(3)/32, FP(9)/32, 0, 0, 0, 0 },
+		{ FP(1932)/2197, -FP(7200)/2197, FP(7296)/2197, 0, 0, 0 },
+		{ FP(439)/216, -8, FP(3680)/513, -FP(845)/4104, 0, 0 },
+		{ -FP(8)/27, 2, -FP(3544)/2565, FP(1859)/4104, -FP(11)/40, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(25)/216, 0, FP(1408)/2565, FP(2197)/4104, -FP(1)/5, 0 };
+	static constexpr FP BAux[Stages] = { FP(16)/135, 0, FP(6656)/12825, FP(28561)/56430, -FP(9)/50, FP(2)/55 };
+};
+
+class RKF45 : public TableauERK<RKF45Tableau> {
 public:
-	RKF45(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 6) {
-		_a(1,0) = 1./4;
-		_a(2,0) = 3./32;       _a(2,1) = 9./32;
-		_a(3,0) = 1932./2197.; _a(3,1) = -7200./2197.; _a(3,2) = 7296./2197;
-		_a(4,0) = 439./216.;   _a(4,1) = -8.;          _a(4,2) = 3680./513.;   _a(4,3) = -845./4104.;
-		_a(5,0) = -8./27.;     _a(5,1) = 2.;           _a(5,2) = -3544./2565.; _a(5,3) = 1859./4104.; _a(5,4) = -11./40.;
-		
-		_b(0) = 25./216.; _b(1) = 0.; _b(2) = 1408./2565.; _b(3) = 2197./4104.; _b(4) = -1./5.; _b(5) = 0;
-		
-		_baux(0) = 16./135.; _baux(1) = 0.; _baux(2) = 6656./12825.;
-		_baux(3) = 28561./56430.; _baux(4) = -9./50.; _baux(5) = 2./55;
-		
-		FillC();
+	RKF45(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<RKF45Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
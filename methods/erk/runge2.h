@@ -2,14 +2,21 @@
 #define RUNGE2_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class Runge2 : public ERK {
+struct Runge2Tableau {
+	static constexpr long Stages = 2;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0 },
+		{ FP(1)/2, 0 }
+	};
+	static constexpr FP B[Stages] = { 0, 1 };
+	static constexpr FP BAux[Stages] = { 0, 0 };
+};
+
+class Runge2 : public TableauERK<Runge2Tableau> {
 public:
-	Runge2(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 2) {
-		_a(1,0) = 1./2;
-		_b(1) = 1.;
-		FillC();
+	Runge2(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<Runge2Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
@@ -2,20 +2,24 @@
 #define ZONNEVELD43_H
 
 #include <core/common.h>
-#include <methods/rk.h>
+#include <methods/tableau.h>
 
-class Zonneveld43 : public ERK {
-public:
-	Zonneveld43(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, 5) {
-		_a(1,0) = 1./2;  _a(2,1) = 1./2;  _a(3,2) = 1.;
-		_a(4,0) = 5./32; _a(4,1) = 7./32; _a(4,2) = 13./32; _a(4,3) = -1./32;
-
-		_b(0) = 1./6; _b(1) = 1./3; _b(2) = 1./3; _b(3) = 1./6;
+struct Zonneveld43Tableau {
+	static constexpr long Stages = 5;
+	static constexpr FP A[Stages][Stages] = {
+		{ 0, 0, 0, 0, 0 },
+		{ FP(1)/2, 0, 0, 0, 0 },
+		{ 0, FP(1)/2, 0, 0, 0 },
+		{ 0, 0, 1, 0, 0 },
+		{ FP(5)/32, FP(7)/32, FP(13)/32, -FP(1)/32, 0 }
+	};
+	static constexpr FP B[Stages] = { FP(1)/6, FP(1)/3, FP(1)/3, FP(1)/6, 0 };
+	static constexpr FP BAux[Stages] = { -FP(1)/2, FP(7)/3, FP(7)/3, FP(13)/6, -FP(16)/3 };
+};
 
-		_baux(0) = -1./2; _baux(1) = 7./3; _baux(2) = 7./3;
-		_baux(3) = 13./6; _baux(4) = -16./3;
-	
-		FillC();
+class Zonneveld43 : public TableauERK<Zonneveld43Tableau> {
+public:
+	Zonneveld43(Hash<ParamValue>& params, BaseIVP* ivp) : TableauERK<Zonneveld43Tableau>(params, ivp) {
 	}
 
 	virtual const char* GetName() const {
@@ -0,0 +1,247 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/exprb.h>
+
+JacobianVector::JacobianVector(BaseIVP* ivp, long* rhsEvals) : _ivp(ivp), _t(0), _yNorm(0), _rhsEvals(rhsEvals) {
+	if( ivp )
+		_m = _n = ivp->Size();
+}
+
+void JacobianVector::Linearize(FP t, const Vec<FP>& y, const Vec<FP>& f) {
+	_t = t;
+	_y = y;
+	_f = f;
+	_yNorm = y.Norm();
+}
+
+void JacobianVector::VectorMult(const Vec<FP>& vec, Vec<FP>& res) const {
+	FP norm = vec.Norm();
+	if( norm == 0 ) {
+		res.Zero();
+		return;
+	}
+
+	FP eps = sqrt(std::numeric_limits<FP>::epsilon())*(1 + _yNorm)/norm;
+	Vec<FP> y(_y);
+	y.AddScaled(eps, vec);
+	(*_ivp)(_t, y, res);
+	(*_rhsEvals)++;
+	res -= _f;
+	res /= eps;
+}
+
+void JacobianVector::Factor() {
+	throw Exception() << "A matrix free Jacobian only provides products.";
+}
+
+void JacobianVector::Solve(Vec<FP>& b, Vec<FP>& x) {
+	throw Exception() << "A matrix free Jacobian only provides products.";
+}
+
+void JacobianVector::Dump(std::ostream &out) const {
+	throw Exception() << "A matrix free Jacobian only provides products.";
+}
+
+void JacobianVector::Load(std::istream &in) {
+	throw Exception() << "A matrix free Jacobian only provides products.";
+}
+
+// ------------------------------------------------------------------------------
+
+ExpRosenbrock::ExpRosenbrock(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp) {
+	_phi = new PhiFunctions(params);
+	_jv = GetDefaultLong(params, "matrix free", 0) ? new JacobianVector(ivp, &_rhsEvals) : 0;
+	_jac = 0;
+
+	if( ivp ) {
+		_fn.Resize(ivp->Size());
+		_dfdt.Resize(ivp->Size());
+		_zero.Resize(ivp->Size());
+		_zero.Zero();
+		_err.Resize(ivp->Size());
+	}
+
+	_rhsEvals = 0;
+	_statJacobians = 0;
+}
+
+ExpRosenbrock::~ExpRosenbrock() {
+	delete _phi;
+	delete _jv;
+}
+
+void ExpRosenbrock::Linearize(FP tn, const Vec<FP>& yn) {
+	(*_ivp)(tn, yn, _fn);
+	_rhsEvals++;
+	_ivp->RHSTimeDt(tn, yn, _dfdt);
+
+	if( _jv ) {
+		_jv->Linearize(tn, yn, _fn);
+		_jac = _jv;
+	} else {
+		_jac = _sparse ? _ivp->JacSparse(tn, yn) : _ivp->Jac(tn, yn);
+		_statJacobians++;
+	}
+}
+
+void ExpRosenbrock::EulerStage(FP c, FP dt, const Vec<FP>& yn, Vec<FP>& u) {
+	const Vec<FP>* w[3] = { &_zero, &_fn, &_dfdt };
+	_phi->Combination(_jac, c*dt, w, 2, u);
+	u += yn;
+}
+
+void ExpRosenbrock::Residual(FP tn, FP t, const Vec<FP>& yn, const Vec<FP>& u, Vec<FP>& r) {
+	(*_ivp)(t, u, r);
+	_rhsEvals++;
+	r -= _fn;
+	r.AddScaled(-(t - tn), _dfdt);
+
+	Vec<FP> diff(u - yn), jdiff(u.Size());
+	_jac->VectorMult(diff, jdiff);
+	r -= jdiff;
+}
+
+// The difference to the embedded method, left in _err by Step
+FP ExpRosenbrock::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	Vec<FP> tol = StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
+	return (_err/tol).RMS();
+}
+
+void ExpRosenbrock::SetTolerances(FP atol, FP rtol) {
+	BaseMethod::SetTolerances(atol, rtol);
+	_phi->SetTolerance(rtol);
+}
+
+void ExpRosenbrock::GetStats(Hash<ParamValue>& params) const {
+	params["rhs evaluations"].SetLong(_rhsEvals);
+	if( !_jv )
+		params["jacobian evaluations"].SetLong(_statJacobians);
+	_phi->GetStats(params);
+}
+
+// ------------------------------------------------------------------------------
+
+Exprb32::Exprb32(Hash<ParamValue>& params, BaseIVP* ivp) : ExpRosenbrock(params, ivp) {
+}
+
+// U2 = yn + dt phi_1 fn + dt^2 phi_2 dfdt
+// y1 = U2 + 2 dt phi_3 D2
+void Exprb32::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	Linearize(tn, yn);
+
+	Vec<FP> u2(yn.Size()), d2(yn.Size());
+	EulerStage(1, dt, yn, u2);
+	Residual(tn, tn + dt, yn, u2, d2);
+
+	d2 *= 2/(dt*dt);
+	const Vec<FP>* w[4] = { &_zero, &_zero, &_zero, &d2 };
+	_phi->Combination(_jac, dt, w, 3, _err);
+
+	ynew = u2;
+	ynew += _err;
+}
+
+const char* Exprb32::GetName() const {
+	return "exprb32";
+}
+
+long Exprb32::GetOrder() const {
+	return 3;
+}
+
+long Exprb32::GetAuxOrder() const {
+	return 2;
+}
+
+// ------------------------------------------------------------------------------
+
+Exprb43::Exprb43(Hash<ParamValue>& params, BaseIVP* ivp) : ExpRosenbrock(params, ivp) {
+}
+
+// U2 = yn + dt/2 phi_1(dt/2 J) fn + (dt/2)^2 phi_2(dt/2 J) dfdt
+// U3 = yn + dt phi_1 (fn + D2) + dt^2 phi_2 dfdt
+// y1 = yn + dt phi_1 fn + dt^2 phi_2 dfdt + dt phi_3 (16 D2 - 2 D3) + dt phi_4 (-48 D2 + 12 D3)
+//
+// and the embedded method drops the phi_4 term
+void Exprb43::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	Linearize(tn, yn);
+
+	long n = yn.Size();
+	Vec<FP> u2(n), u3(n), d2(n), d3(n);
+	EulerStage(FP(0.5), dt, yn, u2);
+	Residual(tn, tn + dt/2, yn, u2, d2);
+
+	Vec<FP> f3(_fn + d2);
+	const Vec<FP>* w3[3] = { &_zero, &f3, &_dfdt };
+	_phi->Combination(_jac, dt, w3, 2, u3);
+	u3 += yn;
+	Residual(tn, tn + dt, yn, u3, d3);
+
+	Vec<FP> p3((16*d2 - 2*d3)/(dt*dt));
+	Vec<FP> p4((-48*d2 + 12*d3)/(dt*dt*dt));
+	const Vec<FP>* w[5] = { &_zero, &_fn, &_dfdt, &p3, &p4 };
+	_phi->Combination(_jac, dt, w, 4, ynew);
+	ynew += yn;
+
+	const Vec<FP>* e[5] = { &_zero, &_zero, &_zero, &_zero, &p4 };
+	_phi->Combination(_jac, dt, e, 4, _err);
+}
+
+const char* Exprb43::GetName() const {
+	return "exprb43";
+}
+
+long Exprb43::GetOrder() const {
+	return 4;
+}
+
+long Exprb43::GetAuxOrder() const {
+	return 3;
+}
+
+// ------------------------------------------------------------------------------
+
+EPIRK4s3::EPIRK4s3(Hash<ParamValue>& params, BaseIVP* ivp) : ExpRosenbrock(params, ivp) {
+}
+
+// Y1 and Y2 are exponential Euler stages to dt/8 and dt/9, and with the
+// differences R1 = r(Y1) and R2 = r(Y2) - 2 r(Y1)
+//
+// y1 = yn + dt phi_1 fn + dt^2 phi_2 dfdt + dt (1892 phi_3 - 42336 phi_4) R1
+//         + dt (1458 phi_3 - 34992 phi_4) R2
+//
+// The embedded method of order 3 replaces the last two terms by dt 128 phi_3 r(Y1).
+void EPIRK4s3::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	Linearize(tn, yn);
+
+	long n = yn.Size();
+	Vec<FP> y1(n), y2(n), r1(n), r2(n);
+	EulerStage(FP(1)/8, dt, yn, y1);
+	EulerStage(FP(1)/9, dt, yn, y2);
+	Residual(tn, tn + dt/8, yn, y1, r1);
+	Residual(tn, tn + dt/9, yn, y2, r2);
+	r2.AddScaled(-2, r1);
+
+	FP dt2 = dt*dt, dt3 = dt2*dt;
+	Vec<FP> p3((1892*r1 + 1458*r2)/dt2);
+	Vec<FP> p4((-42336*r1 - 34992*r2)/dt3);
+	const Vec<FP>* w[5] = { &_zero, &_fn, &_dfdt, &p3, &p4 };
+	_phi->Combination(_jac, dt, w, 4, ynew);
+	ynew += yn;
+
+	p3.AddScaled(-128/dt2, r1);
+	const Vec<FP>* e[5] = { &_zero, &_zero, &_zero, &p3, &p4 };
+	_phi->Combination(_jac, dt, e, 4, _err);
+}
+
+const char* EPIRK4s3::GetName() const {
+	return "EPIRK4s3";
+}
+
+long EPIRK4s3::GetOrder() const {
+	return 4;
+}
+
+long EPIRK4s3::GetAuxOrder() const {
+	return 3;
+}
@@ -0,0 +1,110 @@
+#ifndef EXPRB_H
+#define EXPRB_H
+
+#include <core/common.h>
+#include <core/csrmat.h>
+#include <methods/basemethod.h>
+#include <methods/phi.h>
+
+// Jv by a forward difference of f about the point of linearization, so that
+// the exponential methods only need right hand side evaluations
+class JacobianVector : public BaseMat<FP> {
+protected:
+	BaseIVP* _ivp;
+	FP _t;
+	Vec<FP> _y;
+	Vec<FP> _f;
+	FP _yNorm;
+	long* _rhsEvals;
+
+	virtual void Dump(std::ostream &out) const;
+	virtual void Load(std::istream &in);
+
+public:
+	JacobianVector(BaseIVP* ivp, long* rhsEvals);
+
+	void Linearize(FP t, const Vec<FP>& y, const Vec<FP>& f);
+
+	virtual void VectorMult(const Vec<FP>& vec, Vec<FP>& res) const;
+	virtual void Factor();
+	virtual void Solve(Vec<FP>& b, Vec<FP>& x);
+};
+
+// Exponential Rosenbrock and EPIRK methods linearize the whole right hand side
+// at every step, y' = fn + J (y - yn) + (t - tn) dfdt + r(t, y), and integrate
+// the linear part exactly with the phi functions of J, so they need no linear
+// solves. Each stage only adds the residual r of the nonlinear remainder,
+// which vanishes to second order at (tn, yn). -matrix\ free 1 replaces J by
+// difference quotients of f.
+class ExpRosenbrock : public BaseMethod {
+protected:
+	PhiFunctions* _phi;
+	JacobianVector* _jv;
+	const BaseMat<FP>* _jac;
+
+	Vec<FP> _fn;
+	Vec<FP> _dfdt;
+	Vec<FP> _zero;
+	Vec<FP> _err;
+
+	long _rhsEvals;
+	long _statJacobians;
+
+	void Linearize(FP tn, const Vec<FP>& yn);
+
+	// u = yn + c dt phi_1(c dt J) fn + (c dt)^2 phi_2(c dt J) dfdt
+	void EulerStage(FP c, FP dt, const Vec<FP>& yn, Vec<FP>& u);
+
+	// r = f(t, u) - fn - J (u - yn) - (t - tn) dfdt
+	void Residual(FP tn, FP t, const Vec<FP>& yn, const Vec<FP>& u, Vec<FP>& r);
+
+public:
+	ExpRosenbrock(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~ExpRosenbrock();
+
+	virtual void SetTolerances(FP atol, FP rtol);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+	virtual void GetStats(Hash<ParamValue>& params) const;
+};
+
+// exprb32 of Hochbruck, Ostermann and Schweitzer: order 3, with the
+// exponential Rosenbrock-Euler method of order 2 as its embedded method
+class Exprb32 : public ExpRosenbrock {
+public:
+	Exprb32(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// exprb43 of Hochbruck, Ostermann and Schweitzer: order 4 with an embedded
+// method of order 3
+class Exprb43 : public ExpRosenbrock {
+public:
+	Exprb43(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// EPIRK4s3 of Rainwater and Tokman: two exponential Euler stages to dt/8 and
+// dt/9, combined through forward differences of their residuals. The embedded
+// method of order 3 only uses the first stage.
+class EPIRK4s3 : public ExpRosenbrock {
+public:
+	EPIRK4s3(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+#endif
@@ -1,18 +1,6 @@
 #include <methods/exprk.h>
 
-void AdditiveExpRK::ExpMtv(const BaseMat<FP>* M, const FP t, const Vec<FP>& v, Vec<FP>& expMtv) {
-	Vec<FP> temp(v.Size());
-	Vec<FP> tempMv = v;
-	expMtv = v;
-
-	for( long i = 1; i <= 3; i++ ) {
-		M->VectorMult(tempMv,temp);
-		tempMv = temp*(t/i);
-		expMtv += tempMv;
-	}
-}
-
-AdditiveExpRK::AdditiveExpRK(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp) {
+AdditiveExpRK::AdditiveExpRK(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp), _newton(params, 12) {
 	bool flipExp = (bool)GetDefaultLong(params, "flipexp", 0);
 	if( flipExp ) {
 		_classical = 2;
@@ -21,9 +9,22 @@ AdditiveExpRK::AdditiveExpRK(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMetho
 		_classical = 1;
 		_exponential = 2;
 	}
+
+	_phi = new PhiFunctions(params);
 }
 
 AdditiveExpRK::~AdditiveExpRK() {
+	delete _phi;
+}
+
+void AdditiveExpRK::SetTolerances(FP atol, FP rtol) {
+	BaseMethod::SetTolerances(atol, rtol);
+	_phi->SetTolerance(rtol);
+}
+
+void AdditiveExpRK::GetStats(Hash<ParamValue>& params) const {
+	_phi->GetStats(params);
+	_newton.GetStats(params);
 }
 
 // ------------------------------------------------------------------------------
@@ -44,7 +45,7 @@ void DIRKCF1::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	Vec<FP> g(yn.Size());
 	(*_ivp)(tn, yn, g, _classical);
 
-	ExpMtv(splitMat, dt, yn, ynew);
+	_phi->Exp(splitMat, dt, yn, ynew);
 	ynew += dt*g;
 
 	_ivp->FreezeJacobian(false);
@@ -83,25 +84,27 @@ void DIRKCF2::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	else
 		expmat = _ivp->SplitMat(tn, yn, _exponential);	
 	Vec<FP> k_exp(yn.Size());
-	ExpMtv(expmat, dt/2, yn, k_exp);
+	_phi->Exp(expmat, dt/2, yn, k_exp);
 
 	// Implicit stage 1/2
 	Vec<FP> k_imp = yn;
 	Vec<FP> split1(yn.Size());
-	for( int i = 0;; i++ ) {
+	_newton.Start(k_imp, _solverATol, _solverRTol);
+	for( ;; ) {
 		(*_ivp)(tn+dt/2, k_imp, split1, _classical);
 		Vec<FP> f = k_exp + (dt/2)*split1 - k_imp;
 
 		jac->Solve(f, split1);
 		k_imp -= split1;
-		
-		FP norm = f.InfNorm();
-		if( norm < _newtonTol )
+
+		NewtonControl::Status status = _newton.Check(split1);
+		if( status == NewtonControl::CONVERGED )
 			break;
-		
-		if( norm > _newtonFail || i > 10 ) {
+
+		if( status == NewtonControl::FAILED ) {
 			_accept = false;
 			ynew.Zero();
+			_ivp->FreezeJacobian(false);
 			delete jac;
 			return;
 		}
@@ -109,13 +112,13 @@ void DIRKCF2::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 
 	// Complete method
 	(*_ivp)(tn+dt/2, k_imp, split1, _classical);
-	ExpMtv(expmat, -dt/2, split1, k_exp);
+	_phi->Exp(expmat, -dt/2, split1, k_exp);
 
 	if( _sparse )
 		expmat = _ivp->SplitMatSparse(tn+dt, k_imp, _exponential);
 	else
 		expmat = _ivp->SplitMat(tn+dt, k_imp, _exponential);
-	ExpMtv(expmat, dt, yn + dt*k_exp, ynew);
+	_phi->Exp(expmat, dt, yn + dt*k_exp, ynew);
 
 	_ivp->FreezeJacobian(false);
 	delete jac;
@@ -140,21 +143,17 @@ DIRKCF3::~DIRKCF3() {
 bool DIRKCF3::NewtonSolve(BaseMat<FP>* jac, Vec<FP>& guess, FP t, FP dt, const Vec<FP>& constant) {
 	Vec<FP> temp(guess.Size());
 
-	for( long i = 0;; i++ ) {
+	_newton.Start(guess, _solverATol, _solverRTol);
+	for( ;; ) {
 		(*_ivp)(t+dt, guess, temp, _classical);
 		Vec<FP> f = constant + dt*temp - guess;
 		jac->Solve(f, temp);
 		guess -= temp;
 
-		FP norm = f.InfNorm();
-		if( norm < _newtonTol )
-			break;
-
-		if( norm > _newtonFail || i > 10 )
-			return false;
+		NewtonControl::Status status = _newton.Check(temp);
+		if( status != NewtonControl::ITERATE )
+			return status == NewtonControl::CONVERGED;
 	}
-
-	return true;
 }
 
 void DIRKCF3::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
@@ -187,7 +186,7 @@ void DIRKCF3::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	p2m.ToDense().PrintMatlab(std::cout << "phi2 matrix = ");
 
 	// Calculate stage 2
-	ExpMtv(&p2m, 1, yn, constant2);
+	_phi->Exp(&p2m, 1, yn, constant2);
 	if( !NewtonSolve(jac, y2 = yn, tn, gamma*dt, constant2) ) goto reject;
 	y2.PrintMatlab(std::cout << "y2 = ");	
 
@@ -198,8 +197,8 @@ void DIRKCF3::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 
 	// Calculate stage 3
 	(*_ivp)(tn + gamma*dt, y2, y2g, _classical);
-	ExpMtv(&p2m, -1, y2, p2ig2);
-	ExpMtv(&p3m, 1, yn + dt*(1-2*gamma)*p2ig2, constant3);
+	_phi->Exp(&p2m, -1, y2, p2ig2);
+	_phi->Exp(&p3m, 1, yn + dt*(1-2*gamma)*p2ig2, constant3);
 	constant3.PrintMatlab(std::cout << "constant3 = ");	
 	if( !NewtonSolve(jac, y3 = y2, tn, gamma*dt, constant3) ) goto reject;
 	y3.PrintMatlab(std::cout << "y3 = ");	
@@ -207,13 +206,13 @@ void DIRKCF3::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	// Calculate phi4 matrix
 	y3m = (const CSRMat<FP>*)_ivp->SplitMatSparse(tn+(1-gamma)*dt, y3, _exponential);
 	p4m1 = dt*(phi*(*y2m) - phi*(*y3m));
-	p4m2 = dt*((1./2-phi)*(*y2m) + (1./2-phi)*(*y3m));
+	p4m2 = dt*(((FP)1/2-phi)*(*y2m) + ((FP)1/2-phi)*(*y3m));
 
 	// Calculate ynew
 	(*_ivp)(tn + (1-gamma)*dt, y3, y3g, _classical);
-	ExpMtv(&p3m, -1, y3g, p3ig3);
-	ExpMtv(&p4m1, dt, yn + (dt/2)*(p2ig2 + p3ig3), ynew);
-	ExpMtv(&p4m2, dt, ynew, ynew);
+	_phi->Exp(&p3m, -1, y3g, p3ig3);
+	_phi->Exp(&p4m1, dt, yn + (dt/2)*(p2ig2 + p3ig3), ynew);
+	_phi->Exp(&p4m2, dt, ynew, ynew);
 
 	_ivp->FreezeJacobian(false);
 	delete jac;
@@ -255,7 +254,7 @@ void ERKCF2::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	else
 		expmat = _ivp->SplitMat(tn, yn, _exponential);
 	Vec<FP> k_exp(yn.Size());
-	ExpMtv(expmat, dt/2, yn, k_exp);
+	_phi->Exp(expmat, dt/2, yn, k_exp);
 
 	// Finish first stage
 	Vec<FP> split1(yn.Size());
@@ -264,13 +263,13 @@ void ERKCF2::Step(const FP tn, const FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 
 	// Complete method
 	(*_ivp)(tn+dt/2, k_exp, split1, _classical);
-	ExpMtv(expmat, -dt/2, split1, ynew);
+	_phi->Exp(expmat, -dt/2, split1, ynew);
 
 	if( _sparse ) 
 		expmat = _ivp->SplitMatSparse(tn+dt, k_exp, _exponential);
 	else
 		expmat = _ivp->SplitMat(tn+dt, k_exp, _exponential);
-	ExpMtv(expmat, dt, yn + dt*ynew, ynew);
+	_phi->Exp(expmat, dt, yn + dt*ynew, ynew);
 
 	_ivp->FreezeJacobian(false);
 }
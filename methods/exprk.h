@@ -2,10 +2,12 @@
 #define ADDITIVE_EXPRK_METHOD_H
 
 #include <methods/rk.h>
+#include <methods/phi.h>
 
 class AdditiveExpRK : public BaseMethod {
 protected:
-	void ExpMtv(const BaseMat<FP>* M, const FP t, const Vec<FP>& v, Vec<FP>& expMtv);
+	PhiFunctions* _phi;
+	NewtonControl _newton;
 
 	unsigned short _exponential;
 	unsigned short _classical;
@@ -13,6 +15,9 @@ protected:
 public:
 	AdditiveExpRK(Hash<ParamValue>& params, BaseIVP* ivp);
 	virtual ~AdditiveExpRK();
+
+	virtual void SetTolerances(FP atol, FP rtol);
+	virtual void GetStats(Hash<ParamValue>& params) const;
 };
 
 class DIRKCF1 : public AdditiveExpRK {
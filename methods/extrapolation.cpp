@@ -0,0 +1,288 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/extrapolation.h>
+
+Extrapolation::Extrapolation(Hash<ParamValue>& params, BaseIVP* ivp, long maxColumns) : BaseMethod(params, ivp) {
+	_maxColumns = GetDefaultLong(params, "max columns", maxColumns);
+	if( _maxColumns < 2 || _maxColumns > EXTRAPOLATION_MAX_COLUMNS )
+		throw Exception() << "max columns must be between 2 and " << EXTRAPOLATION_MAX_COLUMNS << ".";
+
+	_threads = GetDefaultLong(params, "threads", 1);
+	_pool = 0;
+	_k = 0;
+	_rhsEvals = 0;
+
+	for( long j = 0; j <= EXTRAPOLATION_MAX_COLUMNS; j++ ) {
+		_n[j] = 0;
+		_work[j] = 0;
+		_err[j] = 0;
+	}
+
+	if( ivp ) {
+		_f0.Resize(ivp->Size());
+		for( long j = 1; j <= _maxColumns; j++ ) {
+			_table[j].Resize(ivp->Size());
+			_diff[j].Resize(ivp->Size());
+		}
+	}
+}
+
+Extrapolation::~Extrapolation() {
+	delete _pool;
+}
+
+// Called by the derived classes once the step number sequence is known
+void Extrapolation::Initialize(Hash<ParamValue>& params) {
+	_pool = new ThreadPool(_threads);
+	_threads = _pool->Size();
+	if( _threads > 1 && _ivp && !_ivp->ThreadSafeRHS() )
+		throw Exception() << _ivp->GetName() << " does not declare a thread-safe right hand side.";
+
+	// f(tn, yn) is shared by all of the rows
+	for( long j = 1; j <= _maxColumns; j++ )
+		_work[j] = 1 + Schedule(j, 0);
+
+	FP rtol = GetDefaultFP(params, "rtol", 1e-5);
+	long k = std::max(2L, std::min(_maxColumns-1, long(-log10(rtol)*0.6 + 1.5)));
+	SetColumns(GetDefaultLong(params, "columns", k));
+}
+
+// Longest processing time first: the rows are handed out from the most
+// expensive down, each to the group with the least work so far. Returns the
+// work of the largest group.
+FP Extrapolation::Schedule(long k, std::vector< std::vector<long> >* groups) const {
+	long count = std::min(_threads, k);
+	std::vector<FP> load(count, 0);
+	if( groups ) {
+		groups->clear();
+		groups->resize(count);
+	}
+
+	for( long j = k; j >= 1; j-- ) {
+		long g = std::min_element(load.begin(), load.end()) - load.begin();
+		load[g] += Cost(j);
+		if( groups )
+			(*groups)[g].push_back(j);
+	}
+
+	return *std::max_element(load.begin(), load.end());
+}
+
+void Extrapolation::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	(*_ivp)(tn, yn, _f0);
+	_rhsEvals++;
+
+	long evals[EXTRAPOLATION_MAX_COLUMNS+1];
+	_pool->ParallelFor(_groups.size(), [&](long g) {
+		for( size_t i = 0; i < _groups[g].size(); i++ ) {
+			long j = _groups[g][i];
+			evals[j] = Row(j, tn, dt, yn);
+		}
+	});
+	for( long j = 1; j <= _k; j++ )
+		_rhsEvals += evals[j];
+
+	// Aitken-Neville, one column at a time. Row j is T_j,i+1 after pass i and
+	// the last difference added to it is T_jj - T_j,j-1.
+	FP p = Power();
+	for( long i = 1; i < _k; i++ ) {
+		for( long j = _k; j > i; j-- ) {
+			_diff[j] = _table[j];
+			_diff[j] -= _table[j-1];
+			_diff[j] /= pow(FP(_n[j])/_n[j-i], p) - 1;
+			_table[j] += _diff[j];
+		}
+	}
+
+	ynew = _table[_k];
+}
+
+FP Extrapolation::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	Vec<FP> tol = StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
+	for( long j = 2; j <= _k; j++ )
+		_err[j] = (_diff[j]/tol).RMS();
+	return _err[_k];
+}
+
+// The error of column j is O(H^(p(j-1)+1)), with the safety factors of ODEX
+FP Extrapolation::StepFactor(long j) const {
+	return pow(_err[j]/FP(0.65), FP(1)/(Power()*(j-1) + 1))/FP(0.94);
+}
+
+// Work per unit step W_j = A_j/H_j is compared for the columns k-1 and k,
+// and that of k+1 is estimated from column k as in ODEX. No more columns are
+// tried after a rejected step.
+long Extrapolation::SelectColumns(FP& factor, bool reject) const {
+	FP fk = StepFactor(_k);
+	factor = fk;
+
+	if( _k > 2 ) {
+		FP fdown = StepFactor(_k-1);
+		if( _work[_k-1]*fdown < FP(0.8)*_work[_k]*fk ) {
+			factor = fdown;
+			return _k-1;
+		}
+		if( _work[_k]*fk >= FP(0.9)*_work[_k-1]*fdown )
+			return _k;
+	}
+
+	if( reject || _k >= _maxColumns )
+		return _k;
+
+	factor = fk*_work[_k]/_work[_k+1];
+	return _k+1;
+}
+
+void Extrapolation::SetColumns(long k) {
+	if( k < 2 || k > _maxColumns )
+		throw Exception() << GetName() << " needs between 2 and " << _maxColumns << " columns.";
+
+	_k = k;
+	Schedule(k, &_groups);
+}
+
+long Extrapolation::GetColumns() const {
+	return _k;
+}
+
+long Extrapolation::GetMaxColumns() const {
+	return _maxColumns;
+}
+
+void Extrapolation::GetStats(Hash<ParamValue>& params) const {
+	params["rhs evaluations"].SetLong(_rhsEvals);
+	params["columns"].SetLong(_k);
+	params["threads"].SetLong(_threads);
+}
+
+long Extrapolation::GetOrder() const {
+	return Power()*_k;
+}
+
+long Extrapolation::GetAuxOrder() const {
+	return Power()*(_k-1);
+}
+
+GBS::GBS(Hash<ParamValue>& params, BaseIVP* ivp) : Extrapolation(params, ivp, 9) {
+	for( long j = 1; j <= _maxColumns; j++ ) {
+		_n[j] = 2*j;
+		if( ivp ) {
+			_z[j][0].Resize(ivp->Size());
+			_z[j][1].Resize(ivp->Size());
+			_f[j].Resize(ivp->Size());
+		}
+	}
+	Initialize(params);
+}
+
+// Explicit Euler to start, then z_i+1 = z_i-1 + 2h f(z_i) written over z_i-1
+long GBS::Row(long j, FP tn, FP dt, const Vec<FP>& yn) {
+	long n = _n[j];
+	FP h = dt/n;
+	Vec<FP>* z = _z[j];
+
+	z[0] = yn;
+	z[1] = yn;
+	z[1].AddScaled(h, _f0);
+
+	long prev = 0, cur = 1;
+	for( long i = 1; i < n; i++ ) {
+		(*_ivp)(tn + i*h, z[cur], _f[j]);
+		z[prev].AddScaled(2*h, _f[j]);
+		std::swap(prev, cur);
+	}
+
+	_table[j] = z[cur];
+	return n-1;
+}
+
+FP GBS::Cost(long j) const {
+	return _n[j] - 1;
+}
+
+long GBS::Power() const {
+	return 2;
+}
+
+const char* GBS::GetName() const {
+	return "GBS";
+}
+
+LIEuler::LIEuler(Hash<ParamValue>& params, BaseIVP* ivp) : Extrapolation(params, ivp, 8) {
+	_jac = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+	for( long j = 0; j <= EXTRAPOLATION_MAX_COLUMNS; j++ )
+		_mats[j] = 0;
+
+	for( long j = 1; j <= _maxColumns; j++ ) {
+		_n[j] = j;
+		_mats[j] = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+		if( ivp ) {
+			_f[j].Resize(ivp->Size());
+			_delta[j].Resize(ivp->Size());
+		}
+	}
+
+	_statJacobians = 0;
+	_statFactorizations = 0;
+	Initialize(params);
+}
+
+LIEuler::~LIEuler() {
+	delete _jac;
+	for( long j = 0; j <= EXTRAPOLATION_MAX_COLUMNS; j++ )
+		delete _mats[j];
+}
+
+void LIEuler::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	if( _sparse )
+		*(CSRMat<FP>*)_jac = *(const CSRMat<FP>*)_ivp->JacSparse(tn, yn);
+	else
+		*(Mat<FP>*)_jac = *(const Mat<FP>*)_ivp->Jac(tn, yn);
+	_statJacobians++;
+
+	Extrapolation::Step(tn, dt, yn, ynew);
+	_statFactorizations += _k;
+}
+
+long LIEuler::Row(long j, FP tn, FP dt, const Vec<FP>& yn) {
+	long n = _n[j];
+	FP h = dt/n;
+
+	if( _sparse )
+		*(CSRMat<FP>*)_mats[j] = CSRMat<FP>::Eye(yn.Size()) - h**(CSRMat<FP>*)_jac;
+	else
+		*(Mat<FP>*)_mats[j] = Mat<FP>::Eye(yn.Size()) - h**(Mat<FP>*)_jac;
+	_mats[j]->Factor();
+
+	_table[j] = yn;
+	_f[j] = _f0;
+	for( long i = 0; i < n; i++ ) {
+		if( i > 0 )
+			(*_ivp)(tn + i*h, _table[j], _f[j]);
+		_f[j] *= h;
+		_mats[j]->Solve(_f[j], _delta[j]);
+		_table[j] += _delta[j];
+	}
+
+	return n-1;
+}
+
+// A factorization is counted as one evaluation, which suits the small systems
+// with expensive right hand sides these methods are meant for
+FP LIEuler::Cost(long j) const {
+	return _n[j];
+}
+
+long LIEuler::Power() const {
+	return 1;
+}
+
+void LIEuler::GetStats(Hash<ParamValue>& params) const {
+	Extrapolation::GetStats(params);
+	params["jacobian evaluations"].SetLong(_statJacobians);
+	params["factorizations"].SetLong(_statFactorizations);
+}
+
+const char* LIEuler::GetName() const {
+	return "LIEuler";
+}
@@ -0,0 +1,121 @@
+#ifndef EXTRAPOLATION_H
+#define EXTRAPOLATION_H
+
+#include <core/common.h>
+#include <core/csrmat.h>
+#include <core/threadpool.h>
+#include <methods/basemethod.h>
+
+#define EXTRAPOLATION_MAX_COLUMNS 12
+
+// Extrapolation methods. A step of size H is taken by a simple base method
+// with n_j substeps for every row j = 1..k of the tableau, and the results
+// are extrapolated to H = 0 with the Aitken-Neville recursion. The rows only
+// share f(tn, yn), so they are computed at the same time on a thread pool,
+// grouped so that every thread is given about the same amount of work. The
+// work of k columns, used to choose the number of columns, is that of the
+// largest group rather than the sum over the rows.
+class Extrapolation : public BaseMethod {
+protected:
+	ThreadPool* _pool;
+	long _threads;
+
+	long _k;
+	long _maxColumns;
+	long _n[EXTRAPOLATION_MAX_COLUMNS+1];
+	FP _work[EXTRAPOLATION_MAX_COLUMNS+1];
+	std::vector< std::vector<long> > _groups;
+
+	// Rows of the tableau, extrapolated in place to T_jj, and the differences
+	// T_jj - T_j,j-1 that estimate the error of each column
+	Vec<FP> _f0;
+	Vec<FP> _table[EXTRAPOLATION_MAX_COLUMNS+1];
+	Vec<FP> _diff[EXTRAPOLATION_MAX_COLUMNS+1];
+	FP _err[EXTRAPOLATION_MAX_COLUMNS+1];
+
+	long _rhsEvals;
+
+	void Initialize(Hash<ParamValue>& params);
+	FP Schedule(long k, std::vector< std::vector<long> >* groups) const;
+
+	// Computes T_j1 from the base method with _n[j] substeps and returns the
+	// number of right hand side evaluations it took
+	virtual long Row(long j, FP tn, FP dt, const Vec<FP>& yn) = 0;
+
+	// Right hand side evaluations (or their equivalent) of a row, which must
+	// grow with j
+	virtual FP Cost(long j) const = 0;
+
+	// The error expansion of the base method is in powers of H^p
+	virtual long Power() const = 0;
+
+public:
+	Extrapolation(Hash<ParamValue>& params, BaseIVP* ivp, long maxColumns);
+	virtual ~Extrapolation();
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+
+	// Reciprocal of the step size ratio that the error of column j allows
+	FP StepFactor(long j) const;
+
+	// Number of columns that takes the least work per unit step for the next
+	// step, along with its step factor
+	long SelectColumns(FP& factor, bool reject) const;
+
+	void SetColumns(long k);
+	long GetColumns() const;
+	long GetMaxColumns() const;
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// Gragg-Bulirsch-Stoer: the explicit midpoint rule with n_j = 2j substeps,
+// extrapolated in H^2 to order 2k.
+class GBS : public Extrapolation {
+protected:
+	Vec<FP> _z[EXTRAPOLATION_MAX_COLUMNS+1][2];
+	Vec<FP> _f[EXTRAPOLATION_MAX_COLUMNS+1];
+
+	virtual long Row(long j, FP tn, FP dt, const Vec<FP>& yn);
+	virtual FP Cost(long j) const;
+	virtual long Power() const;
+
+public:
+	GBS(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+// Linearly implicit Euler, (I - h J)(y_i+1 - y_i) = h f(t_i, y_i), with
+// n_j = j substeps extrapolated to order k for stiff problems. The Jacobian
+// is evaluated once per step and every row factors its own matrix.
+class LIEuler : public Extrapolation {
+protected:
+	BaseMat<FP>* _jac;
+	BaseMat<FP>* _mats[EXTRAPOLATION_MAX_COLUMNS+1];
+	Vec<FP> _f[EXTRAPOLATION_MAX_COLUMNS+1];
+	Vec<FP> _delta[EXTRAPOLATION_MAX_COLUMNS+1];
+
+	long _statJacobians;
+	long _statFactorizations;
+
+	virtual long Row(long j, FP tn, FP dt, const Vec<FP>& yn);
+	virtual FP Cost(long j) const;
+	virtual long Power() const;
+
+public:
+	LIEuler(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~LIEuler();
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <methods/irk/backwardeuler.h>
 #include <methods/irk/radau5.h>
+#include <methods/irk/radauiia.h>
 #include <methods/irk/rodas.h>
 
 #endif
@@ -2,7 +2,10 @@
 #define RADAU5_H
 
 #include <core/common.h>
+#include <core/exception.h>
+#include <core/threadpool.h>
 #include <methods/basemethod.h>
+#include <methods/newton.h>
 #include <solvers/basesolver.h>
 
 class Radau5 : public BaseMethod {
@@ -26,11 +29,14 @@ class Radau5 : public BaseMethod {
 	FP _alpha;
 	FP _beta;
 
-	FP _newtonFail;
-	FP _newtonTol;
+	NewtonControl _newton;
+
+	// With more than one thread the three stage evaluations, and the real and
+	// complex factorizations and solves, run at the same time
+	ThreadPool* _pool;
 	
 public:
-	Radau5(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp), _a(3,3), _Tr(3,3), _Ti(3,3), _c(2), _d(3), _newtonFail(1e20), _newtonTol(1e-8) {
+	Radau5(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp), _a(3,3), _Tr(3,3), _Ti(3,3), _c(2), _d(3), _newton(params, 20) {
 		FP sq6 = sqrt(6);
 		
 		_a(0,0) = (88-7*sq6)/360;
@@ -80,11 +86,9 @@ public:
 		_Ti(2,1) = 2.5719269498556054292;
 		_Ti(2,2) = -0.59603920482822492497;
 
-		ParamValue* pv;
-		if( (pv = params.Get("newton fail")) )
-			_newtonFail = pv->GetFP();
-		if( (pv = params.Get("newton tol")) )
-			_newtonTol = pv->GetFP();
+		_pool = new ThreadPool(GetDefaultLong(params, "threads", 1));
+		if( _pool->Size() > 1 && _ivp && !_ivp->ThreadSafeRHS() )
+			throw Exception() << _ivp->GetName() << " does not declare a thread-safe right hand side.";
 
 		if( _ivp ) {
 			_Z1.Resize(_ivp->Size());
@@ -104,6 +108,7 @@ public:
 	~Radau5() {
 		delete _E1;
 		delete _E2;
+		delete _pool;
 	}
 
 	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
@@ -111,18 +116,22 @@ public:
 		FP a = _alpha/dt;
 		FP b = _beta/dt;
 
-		if( _sparse ) {
-			CSRMat<FP>* jac = (CSRMat<FP>*)_ivp->JacSparse(tn,yn);
-			*(CSRMat<FP>*)_E1 = g*CSRMat<FP>::Eye(yn.Size()) - *jac;
-			*(CSRMat<CFP>*)_E2 = CFP(a,b)*CSRMat<CFP>::Eye(yn.Size()) - CSRMat<CFP>(*jac);
-		} else {
-			Mat<FP>* jac = (Mat<FP>*)_ivp->Jac(tn,yn);
-			*(Mat<FP>*)_E1 = g*Mat<FP>::Eye(yn.Size()) - *jac;
-			*(Mat<CFP>*)_E2 = CFP(a,b)*Mat<CFP>::Eye(yn.Size()) - *jac;
-		}
-
-		_E1->Factor();
-		_E2->Factor();		
+		const BaseMat<FP>* jac = _sparse ? _ivp->JacSparse(tn,yn) : _ivp->Jac(tn,yn);
+		_pool->ParallelFor(2, [&](long i) {
+			if( i == 0 ) {
+				if( _sparse )
+					*(CSRMat<FP>*)_E1 = g*CSRMat<FP>::Eye(yn.Size()) - *(CSRMat<FP>*)jac;
+				else
+					*(Mat<FP>*)_E1 = g*Mat<FP>::Eye(yn.Size()) - *(Mat<FP>*)jac;
+				_E1->Factor();
+			} else {
+				if( _sparse )
+					*(CSRMat<CFP>*)_E2 = CFP(a,b)*CSRMat<CFP>::Eye(yn.Size()) - CSRMat<CFP>(*(CSRMat<FP>*)jac);
+				else
+					*(Mat<CFP>*)_E2 = CFP(a,b)*Mat<CFP>::Eye(yn.Size()) - *(Mat<FP>*)jac;
+				_E2->Factor();
+			}
+		});
 
 		Vec<FP> F1(yn.Size());
 		Vec<FP> F2(yn.Size());
@@ -149,12 +158,16 @@ public:
 			F3 = _Ti(2,0)*Z1I + _Ti(2,1)*Z2I + _Ti(2,2)*Z3I;
 		}
 
-		for( long i = 0; i < 20; i++ ) {
-			Vec<FP> A1(yn.Size()), A2(yn.Size()), A3(yn.Size());
+		Vec<FP> A1(yn.Size()), A2(yn.Size()), A3(yn.Size());
+		Vec<FP>* Z[3] = { &_Z1, &_Z2, &_Z3 };
+		Vec<FP>* A[3] = { &A1, &A2, &A3 };
+		FP c[3] = { _c(0), _c(1), 1 };
 
-			(*_ivp)(tn + _c(0)*dt, yn + _Z1, A1);
-			(*_ivp)(tn + _c(1)*dt, yn + _Z2, A2);
-			(*_ivp)(tn + dt, yn + _Z3, A3);
+		_newton.Start(yn, _solverATol, _solverRTol);
+		for( ;; ) {
+			_pool->ParallelFor(3, [&](long s) {
+				(*_ivp)(tn + c[s]*dt, yn + *Z[s], *A[s]);
+			});
 			
 			_Z1 = _Ti(0,0)*A1 + _Ti(0,1)*A2 + _Ti(0,2)*A3;
 			_Z2 = _Ti(1,0)*A1 + _Ti(1,1)*A2 + _Ti(1,2)*A3;
@@ -164,20 +177,21 @@ public:
 			_Z2 += -F2*a + F3*b;
 			_Z3 += -F3*a - F2*b;
 
-			Vec<FP> temp(_Z1);
-			_E1->Solve(temp, _Z1);
+			_pool->ParallelFor(2, [&](long j) {
+				if( j == 0 ) {
+					Vec<FP> temp(_Z1);
+					_E1->Solve(temp, _Z1);
+				} else {
+					Vec<CFP> res(yn.Size());
+					Vec<CFP> tempC(Vec<CFP>(_Z2) + CFP(0,1)*Vec<CFP>(_Z3));
+					_E2->Solve(tempC, res);
 
-			Vec<CFP> res(yn.Size());
-			Vec<CFP> tempC(Vec<CFP>(_Z2) + CFP(0,1)*Vec<CFP>(_Z3));
-			_E2->Solve(tempC, res);
-			
-			_Z2 = VecReal(res);
-			_Z3 = VecImag(res);
+					_Z2 = VecReal(res);
+					_Z3 = VecImag(res);
+				}
+			});
 
-			FP norm = 0;
-			for( long j = 0; j < yn.Size(); j++ )
-				norm += sqr(_Z1(j)) + sqr(_Z2(j)) + sqr(_Z3(j));
-			norm = sqrt(norm/(3*yn.Size()));
+			FP norm = sqrt((sqr(_newton.Norm(_Z1)) + sqr(_newton.Norm(_Z2)) + sqr(_newton.Norm(_Z3)))/3);
 
 			// Do the newton update
 			F1 += _Z1;
@@ -187,16 +201,17 @@ public:
 			_Z2 = _Tr(1,0)*F1 + _Tr(1,1)*F2 + _Tr(1,2)*F3;
 			_Z3 = _Tr(2,0)*F1 + _Tr(2,1)*F2 + _Tr(2,2)*F3;
 
-			if( norm > _newtonFail )
-				break;
-
-			if( norm < _newtonTol ) {
+			switch( _newton.Check(norm) ) {
+			case NewtonControl::CONVERGED:
 				ynew = yn + _Z3;
 				return;
+			case NewtonControl::FAILED:
+				_accept = false;
+				return;
+			default:
+				break;
 			}
 		}
-
-		_accept = false;
 	}
 
 	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
@@ -224,6 +239,11 @@ public:
 		return err.RMS();
 	}
 
+	virtual void GetStats(Hash<ParamValue>& params) const {
+		BaseMethod::GetStats(params);
+		_newton.GetStats(params);
+	}
+
 	virtual void UpdateTimestep() {
 		BaseMethod::UpdateTimestep();
 		
@@ -233,6 +253,24 @@ public:
 		_cont3 = _cont2 - (ak-_Z1/_c(0))/_c(1);
 	}
 
+	// The collocation polynomial through the stages, built in UpdateTimestep,
+	// is the continuous extension of the step.
+	virtual void DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+		_denseT = tn;
+		_denseDt = dt;
+		_denseY1 = ynew;
+	}
+
+	virtual void Interpolate(FP t, Vec<FP>& y) const {
+		FP s = (t - _denseT - _denseDt)/_denseDt;
+		FP c2m1 = _c(1) - 1;
+		FP c1m1 = _c(0) - 1;
+
+		y.Resize(_denseY1.Size());
+		for( long i = 0; i < y.Size(); i++ )
+			y[i] = _denseY1[i] + s*(_cont1[i] + (s-c2m1)*(_cont2[i] + (s-c1m1)*_cont3[i]));
+	}
+
 	virtual const char* GetName() const {
 		return "Radau IIA 5";
 	}
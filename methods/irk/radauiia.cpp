@@ -0,0 +1,474 @@
+#include <core/exception.h>
+#include <methods/irk/radauiia.h>
+
+#include <algorithm>
+
+// All roots of p[0] + p[1] x + ... + p[n] x^n by the Durand-Kerner iteration
+static std::vector<CFP> PolynomialRoots(const std::vector<FP>& p) {
+	long n = p.size() - 1;
+	std::vector<CFP> r(n);
+	CFP z(0.4, 0.9), w(1);
+	for( long i = 0; i < n; i++ ) {
+		r[i] = w;
+		w *= z;
+	}
+
+	for( long it = 0; it < 500; it++ ) {
+		FP change = 0;
+		for( long i = 0; i < n; i++ ) {
+			CFP v = p[n], den = p[n];
+			for( long k = n-1; k >= 0; k-- )
+				v = v*r[i] + p[k];
+			for( long j = 0; j < n; j++ )
+				if( j != i )
+					den *= r[i] - r[j];
+			CFP delta = v/den;
+			r[i] -= delta;
+			change = std::max(change, fabs(delta)/std::max(FP(1), fabs(r[i])));
+		}
+		if( change <= sqr(std::numeric_limits<FP>::epsilon()) )
+			break;
+	}
+
+	return r;
+}
+
+// P_s(u) - P_(s-1)(u) at u = 2x-1 and its derivative in x, by the Legendre
+// recurrence, whose roots are the Radau IIA nodes
+static void RadauPolynomial(long s, FP x, FP& r, FP& dr) {
+	FP u = 2*x - 1;
+	FP p0 = 1, p1 = u, d0 = 0, d1 = 1;
+	for( long k = 1; k < s; k++ ) {
+		FP p2 = ((2*k+1)*u*p1 - k*p0)/(k+1);
+		FP d2 = d0 + (2*k+1)*p1;
+		p0 = p1; p1 = p2;
+		d0 = d1; d1 = d2;
+	}
+	r = s > 0 ? p1 - p0 : 0;
+	dr = 2*(d1 - d0);
+}
+
+static FP Factorial(long n) {
+	FP f = 1;
+	for( long i = 2; i <= n; i++ )
+		f *= i;
+	return f;
+}
+
+static bool RealPartLess(const CFP& a, const CFP& b) {
+	return a.real() < b.real();
+}
+
+void RadauIIA::Coefficients::Compute(long stages) {
+	s = stages;
+	c.Resize(s);
+	d.Resize(s);
+	T = Mat<FP>(s, s);
+	Ti = Mat<FP>(s, s);
+	Ai = Mat<FP>(s, s);
+
+	// The nodes are the roots of d^(s-1)/dx^(s-1) x^(s-1) (x-1)^s. The
+	// expanded polynomial only gives starting values, which Newton polishes
+	// on the well conditioned Legendre form.
+	std::vector<FP> p(2*s, 0);
+	for( long k = 0; k <= s; k++ )
+		p[s-1+k] = Factorial(s)/(Factorial(k)*Factorial(s-k))*((s-k) % 2 ? -1 : 1);
+	for( long r = 0; r < s-1; r++ ) {
+		for( size_t k = 1; k < p.size(); k++ )
+			p[k-1] = k*p[k];
+		p.pop_back();
+	}
+	std::vector<CFP> roots = PolynomialRoots(p);
+	std::sort(roots.begin(), roots.end(), RealPartLess);
+	for( long i = 0; i < s-1; i++ ) {
+		FP x = roots[i].real(), r, dr;
+		for( long it = 0; it < 5; it++ ) {
+			RadauPolynomial(s, x, r, dr);
+			if( dr == 0 )
+				break;
+			x -= r/dr;
+		}
+		c(i) = x;
+	}
+	c(s-1) = 1;
+
+	// A^-1 differentiates the collocation polynomial through 0 and the
+	// stages: entry (i,j) is the derivative at c_i of the Lagrange basis
+	// polynomial of c_j on the nodes 0, c_1, ..., c_s. Written as products of
+	// node differences it is accurate to rounding, unlike an inverted A.
+	std::vector<FP> x(s+1);
+	x[0] = 0;
+	for( long i = 0; i < s; i++ )
+		x[i+1] = c(i);
+	for( long j = 1; j <= s; j++ ) {
+		FP den = 1;
+		for( long m = 0; m <= s; m++ )
+			if( m != j )
+				den *= x[j] - x[m];
+		for( long i = 1; i <= s; i++ ) {
+			FP v = 0;
+			if( i == j ) {
+				for( long m = 0; m <= s; m++ )
+					if( m != j )
+						v += 1/(x[j] - x[m]);
+			} else {
+				v = 1/den;
+				for( long m = 0; m <= s; m++ )
+					if( m != i && m != j )
+						v *= x[i] - x[m];
+			}
+			Ai(i-1,j-1) = v;
+		}
+	}
+
+	// The eigenvalues of A^-1 are the roots of det(I - zA), the denominator of
+	// the (s-1,s) Pade approximation to e^z: one real, the rest in pairs
+	std::vector<FP> q(s+1);
+	for( long j = 0; j <= s; j++ )
+		q[j] = Factorial(2*s-1-j)*Factorial(s)/(Factorial(2*s-1)*Factorial(j)*Factorial(s-j))*(j % 2 ? -1 : 1);
+	std::vector<CFP> lambda = PolynomialRoots(q);
+	std::vector<CFP> eig;
+	long real = 0;
+	for( long i = 1; i < s; i++ )
+		if( fabs(lambda[i].imag()) < fabs(lambda[real].imag()) )
+			real = i;
+	eig.push_back(CFP(lambda[real].real(), 0));
+	for( long i = 0; i < s; i++ )
+		if( i != real && lambda[i].imag() > 0 )
+			eig.push_back(lambda[i]);
+	std::sort(eig.begin() + 1, eig.end(), RealPartLess);
+
+	// Eigenvectors of A^-1, scaled to a last component of one, give the
+	// columns of T: the real one, then the real and imaginary parts of each
+	// pair. They only set how fast Newton contracts, since the residual is
+	// built from A^-1 itself.
+	Vec<FP> e(s), col(s);
+	long column = 0;
+	for( size_t k = 0; k < eig.size(); k++ ) {
+		Vec<CFP> v(s);
+		v(s-1) = 1;
+		if( s > 1 ) {
+			Mat<CFP> m(s-1, s-1);
+			Vec<CFP> rhs(s-1), y(s-1);
+			for( long i = 0; i < s-1; i++ ) {
+				for( long j = 0; j < s-1; j++ )
+					m(i,j) = Ai(i,j) - (i == j ? eig[k] : CFP(0));
+				rhs(i) = -Ai(i,s-1);
+			}
+			m.Factor();
+			m.Solve(rhs, y);
+			for( long i = 0; i < s-1; i++ )
+				v(i) = y(i);
+		}
+
+		for( long i = 0; i < s; i++ )
+			T(i,column) = v(i).real();
+		column++;
+		if( k > 0 ) {
+			for( long i = 0; i < s; i++ )
+				T(i,column) = v(i).imag();
+			column++;
+		}
+	}
+
+	Mat<FP> t(T);
+	t.Factor();
+	for( long j = 0; j < s; j++ ) {
+		e.Zero();
+		e(j) = 1;
+		t.Solve(e, col);
+		for( long i = 0; i < s; i++ )
+			Ti(i,j) = col(i);
+	}
+
+	// The blocks are read back from T^-1 A^-1 T, whatever the signs of T
+	Mat<FP> lam(s, s);
+	for( long i = 0; i < s; i++ ) {
+		for( long j = 0; j < s; j++ ) {
+			FP sum = 0;
+			for( long k = 0; k < s; k++ )
+				for( long l = 0; l < s; l++ )
+					sum += Ti(i,k)*Ai(k,l)*T(l,j);
+			lam(i,j) = sum;
+		}
+	}
+	gamma = lam(0,0);
+	for( long k = 0; k < s/2; k++ ) {
+		alpha[k] = lam(1+2*k, 1+2*k);
+		beta[k] = lam(1+2*k, 2+2*k);
+	}
+
+	// Embedded method of order s, yhat = y0 + h (f0/gamma + sum bhat_i f_i).
+	// Its weights integrate the interpolant of f at the nodes less 1/gamma of
+	// its value at 0, so bhat_i = b_i - l_i(0)/gamma for the Lagrange basis
+	// l_i. With h f = A^-1 Z its difference to y1 is (h f0 + sum d_i Z_i)/gamma
+	// with d = -A^-T l(0).
+	Vec<FP> l0(s);
+	for( long j = 0; j < s; j++ ) {
+		l0(j) = 1;
+		for( long m = 0; m < s; m++ )
+			if( m != j )
+				l0(j) *= -c(m)/(c(j) - c(m));
+	}
+	for( long i = 0; i < s; i++ ) {
+		FP sum = 0;
+		for( long j = 0; j < s; j++ )
+			sum += Ai(j,i)*l0(j);
+		d(i) = -sum;
+	}
+}
+
+RadauIIA::RadauIIA(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp), _newton(params, 20) {
+	_minStages = GetDefaultLong(params, "radau min stages", 1);
+	_maxStages = GetDefaultLong(params, "radau max stages", RADAUIIA_MAX_STAGES);
+	_stages = GetDefaultLong(params, "radau stages", std::max(_minStages, std::min(_maxStages, 3L)));
+
+	long checks[3] = { _minStages, _maxStages, _stages };
+	for( long i = 0; i < 3; i++ )
+		if( checks[i] < 1 || checks[i] > RADAUIIA_MAX_STAGES || checks[i] % 2 == 0 )
+			throw Exception() << "Radau IIA stages must be 1, 3, 5 or 7.";
+	if( _stages < _minStages || _stages > _maxStages )
+		throw Exception() << "radau stages must be between the minimum and maximum stages.";
+
+	for( long s = 1; s <= RADAUIIA_MAX_STAGES; s += 2 )
+		_coef[s].Compute(s);
+	_nextStages = _stages;
+
+	_sinceChange = 0;
+	_contS = 0;
+	_dt = 0;
+
+	if( ivp ) {
+		for( long i = 0; i < RADAUIIA_MAX_STAGES; i++ ) {
+			_Z[i].Resize(ivp->Size());
+			_W[i].Resize(ivp->Size());
+			_F[i].Resize(ivp->Size());
+			_cont[i].Resize(ivp->Size());
+		}
+	}
+
+	_E1 = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+	for( long p = 0; p < RADAUIIA_MAX_STAGES/2; p++ )
+		_E2[p] = _sparse ? (BaseMat<CFP>*)new CSRMat<CFP> : (BaseMat<CFP>*)new Mat<CFP>;
+
+	_rhsEvals = 0;
+	_statJacobians = 0;
+	_statFactorizations = 0;
+	_statChanges = 0;
+}
+
+RadauIIA::~RadauIIA() {
+	delete _E1;
+	for( long p = 0; p < RADAUIIA_MAX_STAGES/2; p++ )
+		delete _E2[p];
+}
+
+// Collocation polynomial of the last accepted step through 0 and its stages,
+// at theta in units of that step
+void RadauIIA::Collocation(FP theta, Vec<FP>& z) const {
+	z.Resize(_cont[0].Size());
+	z.Zero();
+	for( long k = 0; k < _contS; k++ ) {
+		FP l = theta/_contC(k);
+		for( long j = 0; j < _contS; j++ )
+			if( j != k )
+				l *= (theta - _contC(j))/(_contC(k) - _contC(j));
+		z.AddScaled(l, _cont[k]);
+	}
+}
+
+void RadauIIA::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
+	if( _nextStages != _stages ) {
+		_stages = _nextStages;
+		_sinceChange = 0;
+		_statChanges++;
+	}
+}
+
+void RadauIIA::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	const Coefficients& k = _coef[_stages];
+	long s = _stages;
+	long n = yn.Size();
+	FP g = k.gamma/dt;
+	_dt = dt;
+
+	if( _sparse ) {
+		CSRMat<FP>* jac = (CSRMat<FP>*)_ivp->JacSparse(tn,yn);
+		*(CSRMat<FP>*)_E1 = g*CSRMat<FP>::Eye(n) - *jac;
+		for( long p = 0; p < s/2; p++ )
+			*(CSRMat<CFP>*)_E2[p] = CFP(k.alpha[p], -k.beta[p])/dt*CSRMat<CFP>::Eye(n) - CSRMat<CFP>(*jac);
+	} else {
+		Mat<FP>* jac = (Mat<FP>*)_ivp->Jac(tn,yn);
+		*(Mat<FP>*)_E1 = g*Mat<FP>::Eye(n) - *jac;
+		for( long p = 0; p < s/2; p++ )
+			*(Mat<CFP>*)_E2[p] = CFP(k.alpha[p], -k.beta[p])/dt*Mat<CFP>::Eye(n) - *jac;
+	}
+	_E1->Factor();
+	for( long p = 0; p < s/2; p++ )
+		_E2[p]->Factor();
+	_statJacobians++;
+	_statFactorizations += 1 + s/2;
+
+	// Starting values from the collocation polynomial of the last step
+	for( long i = 0; i < s; i++ ) {
+		if( *_acceptedSteps && _contS ) {
+			Collocation(1 + k.c(i)*dt / *_dtOld, _Z[i]);
+			_Z[i] -= _cont[_contS-1];
+		} else {
+			_Z[i].Zero();
+		}
+	}
+	for( long i = 0; i < s; i++ ) {
+		_W[i].Zero();
+		for( long j = 0; j < s; j++ )
+			_W[i].AddScaled(k.Ti(i,j), _Z[j]);
+	}
+
+	Vec<FP> arg(n);
+	Vec<CFP> res(n);
+
+	_newton.Start(yn, _solverATol, _solverRTol);
+	for( ;; ) {
+		for( long i = 0; i < s; i++ ) {
+			arg = yn;
+			arg += _Z[i];
+			(*_ivp)(tn + k.c(i)*dt, arg, _F[i]);
+		}
+		_rhsEvals += s;
+
+		// The residuals F - A^-1 Z/h of the collocation equations, with the
+		// exact A^-1 so that the blocks of T^-1 A^-1 T in the Newton matrices
+		// only set the rate of convergence. Their transforms T^-1 (F - A^-1 Z/h)
+		// overwrite Z, then the solutions, the Newton updates of W.
+		for( long i = 0; i < s; i++ )
+			for( long j = 0; j < s; j++ )
+				_F[i].AddScaled(-k.Ai(i,j)/dt, _Z[j]);
+		for( long i = 0; i < s; i++ ) {
+			_Z[i].Zero();
+			for( long j = 0; j < s; j++ )
+				_Z[i].AddScaled(k.Ti(i,j), _F[j]);
+		}
+
+		arg = _Z[0];
+		_E1->Solve(arg, _Z[0]);
+		for( long p = 0; p < s/2; p++ ) {
+			long r = 1+2*p, m = 2+2*p;
+			Vec<CFP> rhs(Vec<CFP>(_Z[r]) + CFP(0,1)*Vec<CFP>(_Z[m]));
+			_E2[p]->Solve(rhs, res);
+			_Z[r] = VecReal(res);
+			_Z[m] = VecImag(res);
+		}
+
+		FP norm = 0;
+		for( long i = 0; i < s; i++ )
+			norm += sqr(_newton.Norm(_Z[i]));
+		NewtonControl::Status status = _newton.Check(sqrt(norm/s));
+
+		for( long i = 0; i < s; i++ )
+			_W[i] += _Z[i];
+		for( long i = 0; i < s; i++ ) {
+			_Z[i].Zero();
+			for( long j = 0; j < s; j++ )
+				_Z[i].AddScaled(k.T(i,j), _W[j]);
+		}
+
+		if( status == NewtonControl::CONVERGED ) {
+			ynew = yn;
+			ynew += _Z[s-1];
+			return;
+		}
+		if( status == NewtonControl::FAILED )
+			break;
+	}
+
+	// Newton did not converge, so reject and drop the order
+	_accept = false;
+	if( _stages > _minStages )
+		_nextStages = _stages - 2;
+	ynew = yn;
+	ynew += _Z[s-1];
+}
+
+FP RadauIIA::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	const Coefficients& k = _coef[_stages];
+	Vec<FP> fn(yn.Size());
+	(*_ivp)(tn, yn, fn);
+	_rhsEvals++;
+
+	Vec<FP> diff(yn.Size());
+	diff.Zero();
+	for( long i = 0; i < _stages; i++ )
+		diff.AddScaled(k.d(i)/dt, _Z[i]);
+
+	// First prediction
+	Vec<FP> err(yn.Size());
+	Vec<FP> temp(fn+diff);
+	_E1->Solve(temp, err);
+	err /= StepControlSolver::GetTolerances(yn,yn,atol,rtol);
+	FP eps = err.RMS();
+
+	// Second prediction
+	if( eps >= 1 ) {
+		(*_ivp)(tn, err + yn, fn);
+		_rhsEvals++;
+		temp = fn + diff;
+		_E1->Solve(temp, err);
+		err /= StepControlSolver::GetTolerances(yn,yn,atol,rtol);
+		eps = err.RMS();
+	}
+
+	return eps;
+}
+
+// More stages are tried once Newton has converged quickly for a while at a
+// steady step size, fewer when it contracts slowly
+void RadauIIA::UpdateTimestep() {
+	BaseMethod::UpdateTimestep();
+
+	const Coefficients& k = _coef[_stages];
+	for( long i = 0; i < _stages; i++ )
+		_cont[i] = _Z[i];
+	_contC = k.c;
+	_contS = _stages;
+
+	FP quot = *_acceptedSteps ? _dt / *_dtOld : 1;
+	_sinceChange++;
+	if( _stages < _maxStages && _sinceChange > 10 && (_newton.Iterations() <= 2 || _newton.Theta() <= FP(0.002)) &&
+		quot >= FP(0.8) && quot <= FP(1.2) )
+		_nextStages = _stages + 2;
+	else if( _stages > _minStages && _newton.Theta() >= FP(0.8) )
+		_nextStages = _stages - 2;
+}
+
+void RadauIIA::DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+	_denseT = tn;
+	_denseDt = dt;
+	_denseY1 = ynew;
+}
+
+void RadauIIA::Interpolate(FP t, Vec<FP>& y) const {
+	Collocation((t - _denseT)/_denseDt, y);
+	y -= _cont[_contS-1];
+	y += _denseY1;
+}
+
+void RadauIIA::GetStats(Hash<ParamValue>& params) const {
+	params["rhs evaluations"].SetLong(_rhsEvals);
+	params["jacobian evaluations"].SetLong(_statJacobians);
+	params["factorizations"].SetLong(_statFactorizations);
+	params["stages"].SetLong(_stages);
+	params["stage changes"].SetLong(_statChanges);
+	_newton.GetStats(params);
+}
+
+const char* RadauIIA::GetName() const {
+	return "Radau IIA";
+}
+
+long RadauIIA::GetOrder() const {
+	return 2*_stages - 1;
+}
+
+long RadauIIA::GetAuxOrder() const {
+	return _stages;
+}
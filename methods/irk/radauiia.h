@@ -0,0 +1,86 @@
+#ifndef RADAUIIA_H
+#define RADAUIIA_H
+
+#include <core/common.h>
+#include <methods/basemethod.h>
+#include <methods/newton.h>
+#include <solvers/basesolver.h>
+
+#define RADAUIIA_MAX_STAGES 7
+
+// Radau IIA collocation with 1, 3, 5 or 7 stages (orders 1, 5, 9 and 13), the
+// variable order scheme of Hairer and Wanner's RADAU. The simplified Newton
+// iteration is decoupled by the eigenvalues of A^-1, one real and (s-1)/2
+// complex pairs, into a real system and complex ones of size n. The number of
+// stages is raised while Newton converges quickly and lowered when it
+// converges slowly.
+class RadauIIA : public BaseMethod {
+protected:
+	struct Coefficients {
+		long s;
+		Vec<FP> c;
+		Vec<FP> d;
+		Mat<FP> T;
+		Mat<FP> Ti;
+
+		// A^-1, from which the Newton residual is built
+		Mat<FP> Ai;
+
+		// Blocks of T^-1 A^-1 T: gamma, then [alpha beta; -beta alpha] per pair
+		FP gamma;
+		FP alpha[RADAUIIA_MAX_STAGES/2];
+		FP beta[RADAUIIA_MAX_STAGES/2];
+
+		void Compute(long stages);
+	};
+
+	Coefficients _coef[RADAUIIA_MAX_STAGES+1];
+	long _stages;
+	long _minStages;
+	long _maxStages;
+	long _nextStages;
+
+	NewtonControl _newton;
+	FP _dt;
+	long _sinceChange;
+
+	Vec<FP> _Z[RADAUIIA_MAX_STAGES];
+	Vec<FP> _W[RADAUIIA_MAX_STAGES];
+	Vec<FP> _F[RADAUIIA_MAX_STAGES];
+
+	// Stages of the last accepted step and their nodes, which define its
+	// collocation polynomial
+	Vec<FP> _cont[RADAUIIA_MAX_STAGES];
+	Vec<FP> _contC;
+	long _contS;
+
+	BaseMat<FP>* _E1;
+	BaseMat<CFP>* _E2[RADAUIIA_MAX_STAGES/2];
+
+	long _rhsEvals;
+	long _statJacobians;
+	long _statFactorizations;
+	long _statChanges;
+
+	void Collocation(FP theta, Vec<FP>& z) const;
+
+public:
+	RadauIIA(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~RadauIIA();
+
+	virtual void PreStep(const FP tn, FP& dt, Vec<FP>& yn);
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+	virtual void UpdateTimestep();
+
+	virtual void DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew);
+	virtual void Interpolate(FP t, Vec<FP>& y) const;
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+#endif
@@ -0,0 +1,365 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/lowstorage.h>
+
+// Gaussian elimination with partial pivoting on a small dense system
+static bool SolveSmall(std::vector<FP> a, std::vector<FP> b, long n, std::vector<FP>& x) {
+	for( long i = 0; i < n; i++ ) {
+		long p = i;
+		for( long r = i+1; r < n; r++ )
+			if( fabs(a[r*n+i]) > fabs(a[p*n+i]) )
+				p = r;
+		if( a[p*n+i] == 0 )
+			return false;
+		for( long c = 0; c < n; c++ )
+			std::swap(a[i*n+c], a[p*n+c]);
+		std::swap(b[i], b[p]);
+
+		for( long r = i+1; r < n; r++ ) {
+			FP m = a[r*n+i]/a[i*n+i];
+			for( long c = i; c < n; c++ )
+				a[r*n+c] -= m*a[i*n+c];
+			b[r] -= m*b[i];
+		}
+	}
+
+	x.assign(n, 0);
+	for( long i = n-1; i >= 0; i-- ) {
+		FP sum = b[i];
+		for( long c = i+1; c < n; c++ )
+			sum -= a[i*n+c]*x[c];
+		x[i] = sum/a[i*n+i];
+	}
+	return true;
+}
+
+// The largest defect of the tableau a (n x n, by rows) with weights b in the
+// conditions of order up to p <= 4
+static FP OrderDefect(const std::vector<FP>& a, const std::vector<FP>& b, long n, long p) {
+	std::vector<FP> c(n, 0), ac(n, 0), acc(n, 0), aac(n, 0);
+	for( long i = 0; i < n; i++ )
+		for( long j = 0; j < i; j++ )
+			c[i] += a[i*n+j];
+	for( long i = 0; i < n; i++ )
+		for( long j = 0; j < i; j++ ) {
+			ac[i] += a[i*n+j]*c[j];
+			acc[i] += a[i*n+j]*c[j]*c[j];
+		}
+	for( long i = 0; i < n; i++ )
+		for( long j = 0; j < i; j++ )
+			aac[i] += a[i*n+j]*ac[j];
+
+	FP sums[8] = { 0 };
+	for( long j = 0; j < n; j++ ) {
+		sums[0] += b[j];
+		sums[1] += b[j]*c[j];
+		sums[2] += b[j]*c[j]*c[j];
+		sums[3] += b[j]*ac[j];
+		sums[4] += b[j]*c[j]*c[j]*c[j];
+		sums[5] += b[j]*c[j]*ac[j];
+		sums[6] += b[j]*acc[j];
+		sums[7] += b[j]*aac[j];
+	}
+
+	const FP target[] = { 1, FP(1)/2, FP(1)/3, FP(1)/6, FP(1)/4, FP(1)/8, FP(1)/12, FP(1)/24 };
+	const long conditions[] = { 0, 1, 2, 4, 8 };
+	FP defect = 0;
+	for( long k = 0; k < conditions[p]; k++ )
+		defect = std::max(defect, fabs(sums[k] - target[k]));
+	return defect;
+}
+
+// Coefficients published to 12 digits, as those of RK46NL, meet the order
+// conditions only that closely
+static FP OrderTolerance() {
+	return std::max(FP(1e-10), 100*std::numeric_limits<FP>::epsilon());
+}
+
+LowStorageRK::LowStorageRK(Hash<ParamValue>& params, BaseIVP* ivp, long m, long order) : BaseMethod(params, ivp), _m(m), _order(order), _rhsEvals(0) {
+	if( ivp ) {
+		_S2.Resize(ivp->Size());
+		_f.Resize(ivp->Size());
+		_err.Resize(ivp->Size());
+	}
+}
+
+void LowStorageRK::SetCoefficients(const FP* A, const FP* B) {
+	long m = _m;
+	_A.assign(A, A+m);
+	_B.assign(B, B+m);
+
+	// Stage j enters stage i > j, and the solution, through the products of
+	// the A of the stages after it
+	std::vector<FP> a(m*m, 0), b(m, 0), c(m, 0);
+	for( long j = 0; j < m; j++ ) {
+		FP sum = 0, product = 1;
+		for( long r = j; r < m; r++ ) {
+			if( r > j )
+				product *= A[r];
+			sum += B[r]*product;
+			if( r+1 < m )
+				a[(r+1)*m+j] = sum;
+		}
+		b[j] = sum;
+	}
+	for( long i = 0; i < m; i++ )
+		for( long j = 0; j < i; j++ )
+			c[i] += a[i*m+j];
+	_c.assign(c.begin(), c.end());
+
+	if( !(OrderDefect(a, b, m, _order) <= OrderTolerance()) )
+		throw Exception() << GetName() << " does not meet the conditions of order " << _order << ".";
+
+	// The conditions of order p-1, up to 3
+	std::vector<FP> ac(m, 0);
+	for( long i = 0; i < m; i++ )
+		for( long j = 0; j < i; j++ )
+			ac[i] += a[i*m+j]*c[j];
+
+	long q = _order-1;
+	long conditions = q == 1 ? 1 : q == 2 ? 2 : 4;
+	if( q < 1 || q > 3 || conditions > m-1 )
+		throw Exception() << "No embedded method of order " << q << " for " << GetName() << ".";
+
+	std::vector<FP> C(conditions*(m-1)), rhs(conditions);
+	const FP target[] = { 1, FP(1)/2, FP(1)/3, FP(1)/6 };
+	for( long k = 0; k < conditions; k++ ) {
+		for( long j = 0; j < m-1; j++ )
+			C[k*(m-1)+j] = k == 0 ? 1 : k == 1 ? c[j] : k == 2 ? c[j]*c[j] : ac[j];
+		rhs[k] = target[k];
+		for( long j = 0; j < m-1; j++ )
+			rhs[k] -= C[k*(m-1)+j]*b[j];
+	}
+
+	// bhat = b + C^T lambda with C C^T lambda = rhs - C b, the nearest to b
+	std::vector<FP> G(conditions*conditions, 0), lambda;
+	for( long k = 0; k < conditions; k++ )
+		for( long l = 0; l < conditions; l++ )
+			for( long j = 0; j < m-1; j++ )
+				G[k*conditions+l] += C[k*(m-1)+j]*C[l*(m-1)+j];
+	if( !SolveSmall(G, rhs, conditions, lambda) )
+		throw Exception() << "No embedded method of order " << q << " for " << GetName() << ".";
+
+	_e.assign(m, 0);
+	for( long j = 0; j < m-1; j++ )
+		for( long k = 0; k < conditions; k++ )
+			_e[j] -= C[k*(m-1)+j]*lambda[k];
+	_e[m-1] = b[m-1];
+}
+
+void LowStorageRK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	ynew = yn;
+	for( long i = 0; i < _m; i++ ) {
+		_rhsEvals++;
+		(*_ivp)(tn + _c[i]*dt, ynew, _f);
+
+		if( i == 0 ) {
+			_S2 = _f;
+			_S2 *= dt;
+			_err.Zero();
+		} else {
+			_S2 *= _A[i];
+			_S2.AddScaled(dt, _f);
+		}
+		if( _e[i] != 0 )
+			_err.AddScaled(_e[i], _f);
+		ynew.AddScaled(_B[i], _S2);
+	}
+}
+
+FP LowStorageRK::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	return fabs(dt)*(_err/StepControlSolver::GetTolerances(yn, ynew, atol, rtol)).RMS();
+}
+
+void LowStorageRK::GetStats(Hash<ParamValue>& params) const {
+	BaseMethod::GetStats(params);
+	params["rhs evaluations"].SetLong(_rhsEvals);
+}
+
+long LowStorageRK::GetOrder() const {
+	return _order;
+}
+
+long LowStorageRK::GetAuxOrder() const {
+	return _order-1;
+}
+
+LowStorage3SRK::LowStorage3SRK(Hash<ParamValue>& params, BaseIVP* ivp, long m, long order) : BaseMethod(params, ivp), _m(m), _order(order), _deltaSum(1), _betaHat(0), _rhsEvals(0) {
+	if( ivp ) {
+		_S2.Resize(ivp->Size());
+		_f.Resize(ivp->Size());
+	}
+}
+
+void LowStorage3SRK::SetCoefficients(const FP* gamma1, const FP* gamma2, const FP* gamma3, const FP* beta, const FP* delta, FP betaHat) {
+	long m = _m;
+	_gamma1.assign(gamma1, gamma1+m);
+	_gamma2.assign(gamma2, gamma2+m);
+	_gamma3.assign(gamma3, gamma3+m);
+	_beta.assign(beta, beta+m);
+	_delta.assign(delta, delta+m+2);
+	_betaHat = betaHat;
+
+	_deltaSum = 0;
+	for( long i = 0; i < m+2; i++ )
+		_deltaSum += delta[i];
+	if( _deltaSum == 0 )
+		throw Exception() << "The embedded weights of " << GetName() << " sum to zero.";
+
+	// The registers as combinations of yn (entry 0) and dt k_1..dt k_m, run
+	// through the steps of the form. Stage m+1 is ynew, where the last
+	// embedded weight takes f.
+	long n = m+1;
+	std::vector<FP> S1(n+1, 0), S2(n+1, 0), a(n*n, 0), b(n, 0), bhat(n, 0);
+	S1[0] = 1;
+	for( long i = 0; i <= m; i++ ) {
+		if( fabs(S1[0] - 1) > OrderTolerance() )
+			throw Exception() << "Stage " << i+1 << " of " << GetName() << " is not consistent.";
+		for( long j = 0; j < i; j++ )
+			a[i*n+j] = S1[j+1];
+		if( i == m )
+			break;
+
+		for( long j = 0; j <= n; j++ ) {
+			S2[j] += delta[i]*S1[j];
+			S1[j] = gamma1[i]*S1[j] + gamma2[i]*S2[j] + (j == 0 ? gamma3[i] : 0);
+		}
+		S1[i+1] += beta[i];
+	}
+	for( long j = 0; j < m; j++ ) {
+		b[j] = S1[j+1];
+		bhat[j] = (S2[j+1] + delta[m]*S1[j+1])/_deltaSum;
+	}
+	bhat[m] = betaHat;
+
+	_c.assign(m, 0);
+	for( long i = 0; i < m; i++ )
+		for( long j = 0; j < i; j++ )
+			_c[i] += a[i*n+j];
+
+	if( !(OrderDefect(a, b, n, _order) <= OrderTolerance()) )
+		throw Exception() << GetName() << " does not meet the conditions of order " << _order << ".";
+	if( !(fabs((S2[0] + delta[m]*S1[0] + delta[m+1])/_deltaSum - 1) <= OrderTolerance() && OrderDefect(a, bhat, n, _order-1) <= OrderTolerance()) )
+		throw Exception() << "The embedded method of " << GetName() << " does not meet the conditions of order " << _order-1 << ".";
+}
+
+void LowStorage3SRK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	ynew = yn;
+	_S2.Zero();
+	for( long i = 0; i < _m; i++ ) {
+		_rhsEvals++;
+		(*_ivp)(tn + _c[i]*dt, ynew, _f);
+
+		if( _delta[i] != 0 )
+			_S2.AddScaled(_delta[i], ynew);
+		ynew *= _gamma1[i];
+		if( _gamma2[i] != 0 )
+			ynew.AddScaled(_gamma2[i], _S2);
+		if( _gamma3[i] != 0 )
+			ynew.AddScaled(_gamma3[i], yn);
+		ynew.AddScaled(_beta[i]*dt, _f);
+	}
+
+	// yhat - ynew, in S2
+	_S2.AddScaled(_delta[_m], ynew);
+	_S2.AddScaled(_delta[_m+1], yn);
+	_S2 /= _deltaSum;
+	_S2 -= ynew;
+	if( _betaHat != 0 ) {
+		_rhsEvals++;
+		(*_ivp)(tn + dt, ynew, _f);
+		_S2.AddScaled(_betaHat*dt, _f);
+	}
+}
+
+FP LowStorage3SRK::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	return (_S2/StepControlSolver::GetTolerances(yn, ynew, atol, rtol)).RMS();
+}
+
+void LowStorage3SRK::GetStats(Hash<ParamValue>& params) const {
+	BaseMethod::GetStats(params);
+	params["rhs evaluations"].SetLong(_rhsEvals);
+}
+
+long LowStorage3SRK::GetOrder() const {
+	return _order;
+}
+
+long LowStorage3SRK::GetAuxOrder() const {
+	return _order-1;
+}
+
+// -----------------------------------------------------------------------------------
+
+Williamson3::Williamson3(Hash<ParamValue>& params, BaseIVP* ivp) : LowStorageRK(params, ivp, 3, 3) {
+	const FP A[] = { 0, -FP(5)/9, -FP(153)/128 };
+	const FP B[] = { FP(1)/3, FP(15)/16, FP(8)/15 };
+	SetCoefficients(A, B);
+}
+
+const char* Williamson3::GetName() const {
+	return "Williamson 3(2) 2N";
+}
+
+CarpenterKennedy4::CarpenterKennedy4(Hash<ParamValue>& params, BaseIVP* ivp) : LowStorageRK(params, ivp, 5, 4) {
+	const FP A[] = {
+		0,
+		-FP(567301805773)/1357537059087,
+		-FP(2404267990393)/2016746695238,
+		-FP(3550918686646)/2091501179385,
+		-FP(1275806237668)/842570457699
+	};
+	const FP B[] = {
+		FP(1432997174477)/9575080441755,
+		FP(5161836677717)/13612068292357,
+		FP(1720146321549)/2090206949498,
+		FP(3134564353537)/4481467310338,
+		FP(2277821191437)/14882151754819
+	};
+	SetCoefficients(A, B);
+}
+
+const char* CarpenterKennedy4::GetName() const {
+	return "Carpenter-Kennedy 4(3) 2N";
+}
+
+RK46NL::RK46NL(Hash<ParamValue>& params, BaseIVP* ivp) : LowStorageRK(params, ivp, 6, 4) {
+	const FP A[] = {
+		0,
+		-FP(737101392796)/1000000000000,
+		-FP(1634740794341)/1000000000000,
+		-FP(744739003780)/1000000000000,
+		-FP(1469897351522)/1000000000000,
+		-FP(2813971388035)/1000000000000
+	};
+	const FP B[] = {
+		FP(32918605146)/1000000000000,
+		FP(823256998200)/1000000000000,
+		FP(381530948900)/1000000000000,
+		FP(200092213184)/1000000000000,
+		FP(1718581042715)/1000000000000,
+		FP(27)/100
+	};
+	SetCoefficients(A, B);
+}
+
+const char* RK46NL::GetName() const {
+	return "RK46-NL 4(3) 2N";
+}
+
+// The stages yn + dt/2 k1 and yn + 3dt/4 k2, with S2 = yn + Y2 from the
+// second stage on. ynew = 4/9 Y3 + 4/9 S2 - 1/3 yn + 4dt/9 k3 is the
+// solution of the pair, and yhat = (S2 + 3 ynew - yn)/4 + dt/8 f(ynew) its
+// embedded method with the weights 7/24, 1/4, 1/3, 1/8.
+BogackiShampine3::BogackiShampine3(Hash<ParamValue>& params, BaseIVP* ivp) : LowStorage3SRK(params, ivp, 3, 3) {
+	const FP gamma1[] = { 0, 0, FP(4)/9 };
+	const FP gamma2[] = { 1, 0, FP(4)/9 };
+	const FP gamma3[] = { 0, 1, -FP(1)/3 };
+	const FP beta[] = { FP(1)/2, FP(3)/4, FP(4)/9 };
+	const FP delta[] = { 1, 1, 0, 3, -1 };
+	SetCoefficients(gamma1, gamma2, gamma3, beta, delta, FP(1)/8);
+}
+
+const char* BogackiShampine3::GetName() const {
+	return "Bogacki-Shampine 3(2) 3S*";
+}
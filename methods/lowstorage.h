@@ -0,0 +1,128 @@
+#ifndef LOW_STORAGE_H
+#define LOW_STORAGE_H
+
+#include <methods/basemethod.h>
+
+#include <vector>
+
+// Williamson's 2N low storage form of an explicit Runge-Kutta method,
+//
+//	S2 = A_i S2 + dt f(tn + c_i dt, S1),	S1 = S1 + B_i S2,	i = 1..m
+//
+// with S1 = yn at first and ynew at the end, which keeps two registers plus
+// the evaluation of f whatever the number of stages. The embedded method is
+// the one of order p-1 on the first m-1 stages closest to the method itself,
+// found from its Butcher tableau when the method is created. Its difference
+// sum (b_i - bhat_i) k_i builds up in a register of its own as the stages go,
+// since f is overwritten at every stage, so the form keeps four vectors
+// rather than two.
+class LowStorageRK : public BaseMethod {
+protected:
+	long _m;
+	long _order;
+	std::vector<FP> _A;
+	std::vector<FP> _B;
+	std::vector<FP> _c;
+	std::vector<FP> _e;
+
+	Vec<FP> _S2;
+	Vec<FP> _f;
+	Vec<FP> _err;
+
+	long _rhsEvals;
+
+	void SetCoefficients(const FP* A, const FP* B);
+
+public:
+	LowStorageRK(Hash<ParamValue>& params, BaseIVP* ivp, long m, long order);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// Williamson's three stage method of order 3
+class Williamson3 : public LowStorageRK {
+public:
+	Williamson3(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+// The five stage method of order 4 of Carpenter and Kennedy
+class CarpenterKennedy4 : public LowStorageRK {
+public:
+	CarpenterKennedy4(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+// The six stage method of order 4 of Berland, Bogey and Bailly, with low
+// dissipation and dispersion for wave propagation. Its coefficients are
+// published to 12 digits only.
+class RK46NL : public LowStorageRK {
+public:
+	RK46NL(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+// Ketcheson's 3S* low storage form of an explicit Runge-Kutta method,
+//
+//	S2 = S2 + delta_i S1,
+//	S1 = gamma1_i S1 + gamma2_i S2 + gamma3_i yn + beta_i dt f(tn + c_i dt, S1),	i = 1..m
+//
+// with S1 = yn and S2 = 0 at first and ynew = S1 at the end. Its third
+// register is yn, which the solver keeps anyway, so the method stores S2 and
+// the evaluation of f besides ynew. The embedded method is
+//
+//	yhat = (S2 + delta_m+1 ynew + delta_m+2 yn)/sum delta + betahat dt f(tn + dt, ynew)
+//
+// and its difference to ynew overwrites S2 at the end of the step. Both
+// tableaux are rebuilt from the coefficients and checked against the order
+// conditions when the method is created.
+class LowStorage3SRK : public BaseMethod {
+protected:
+	long _m;
+	long _order;
+	std::vector<FP> _gamma1;
+	std::vector<FP> _gamma2;
+	std::vector<FP> _gamma3;
+	std::vector<FP> _beta;
+	std::vector<FP> _delta;
+	FP _deltaSum;
+	FP _betaHat;
+	std::vector<FP> _c;
+
+	Vec<FP> _S2;
+	Vec<FP> _f;
+
+	long _rhsEvals;
+
+	void SetCoefficients(const FP* gamma1, const FP* gamma2, const FP* gamma3, const FP* beta, const FP* delta, FP betaHat);
+
+public:
+	LowStorage3SRK(Hash<ParamValue>& params, BaseIVP* ivp, long m, long order);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// The Bogacki-Shampine pair 3(2) in 3S* form, with its published embedded
+// weights. The last of them needs f at ynew, one more evaluation per step,
+// as the form keeps no copy of ynew to reuse it from on the next step.
+class BogackiShampine3 : public LowStorage3SRK {
+public:
+	BogackiShampine3(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -0,0 +1,305 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/mri.h>
+
+BaseMethod* AllocMethod(Hash<ParamValue>& params, BaseIVP* ivp);
+
+MRIFastIVP::MRIFastIVP(Hash<ParamValue>& params, BaseIVP* outer, unsigned short split, long degree) : BaseIVP(params), _outer(outer), _split(split), _t0(0), _length(1) {
+	_initialCondition.Resize(outer->Size());
+	_forcing.assign(degree, Vec<FP>(outer->Size()));
+}
+
+void MRIFastIVP::RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	(*_outer)(t, y, yp, _split);
+
+	FP theta = (t - _t0)/_length;
+	FP power = 1;
+	for( size_t k = 0; k < _forcing.size(); k++ ) {
+		yp.AddScaled(power, _forcing[k]);
+		power *= theta;
+	}
+}
+
+void MRIFastIVP::SetInterval(FP t0, FP length) {
+	_t0 = t0;
+	_length = length;
+}
+
+Vec<FP>& MRIFastIVP::Forcing(long k) {
+	return _forcing[k];
+}
+
+const char* MRIFastIVP::GetName() {
+	return "MRI fast problem";
+}
+
+// -----------------------------------------------------------------------------------
+
+MRIGARK::MRIGARK(Hash<ParamValue>& params, BaseIVP* ivp, long stages, long degree) : BaseMethod(params, ivp), _stages(stages), _degree(degree) {
+	_c.assign(stages, 0);
+	_gamma.assign(stages*degree*stages, 0);
+	_embedded.assign(degree*stages, 0);
+
+	_fastSplit = (unsigned short)GetDefaultLong(params, "fast split", 2);
+	if( _fastSplit != 1 && _fastSplit != 2 )
+		throw Exception() << "fast split must be 1 or 2.";
+	_slowSplit = 3 - _fastSplit;
+
+	_substeps = GetDefaultLong(params, "fast substeps", 0);
+	_maxSubsteps = GetDefaultLong(params, "fast max substeps", 100000);
+	_fastRtol = GetDefaultFP(params, "fast rtol", GetDefaultFP(params, "rtol", 1e-5));
+	_fastAtol = GetDefaultFP(params, "fast atol", GetDefaultFP(params, "atol", 1e-5));
+	_fastDt = GetDefaultFP(params, "fast dt", 0);
+	_stretch = GetDefaultFP(params, "last step stretch", 1.1);
+	if( _substeps < 0 )
+		throw Exception() << "fast substeps cannot be negative.";
+
+	_fastAccepted = 0;
+	_fastDtOld = 0;
+	_statFastSteps = 0;
+	_statFastRejections = 0;
+
+	_fastIVP = 0;
+	_inner = 0;
+	_Y = new Vec<FP>[stages];
+	_fS = new Vec<FP>[stages];
+	if( !ivp )
+		return;
+
+	for( long i = 0; i < stages; i++ ) {
+		_Y[i].Resize(ivp->Size());
+		_fS[i].Resize(ivp->Size());
+	}
+	_v.Resize(ivp->Size());
+	_yhat.Resize(ivp->Size());
+
+	// The fast problem is differenced for Jacobians, as ADOL-C cannot trace
+	// the outer IVP through it
+	Hash<ParamValue> fastParams;
+	_fastIVP = new MRIFastIVP(fastParams, ivp, _fastSplit, degree);
+
+	std::string fastMethod = GetDefaultString(params, "fast method", "DOPR54");
+	if( fastMethod.compare(0, 7, "MRIGARK") == 0 )
+		throw Exception() << "The fast method of a multirate method cannot itself be multirate.";
+
+	Hash<ParamValue> innerParams(params);
+	innerParams["method"].SetString(fastMethod.c_str());
+	_inner = AllocMethod(innerParams, _fastIVP);
+	_inner->SetSolverVariables(&_fastAccepted, &_fastDtOld);
+}
+
+MRIGARK::~MRIGARK() {
+	delete _inner;
+	delete _fastIVP;
+	delete [] _Y;
+	delete [] _fS;
+}
+
+void MRIGARK::SetTable(const double* c, const double* gamma, const double* embedded) {
+	for( long i = 0; i < _stages; i++ )
+		_c[i] = c[i];
+	for( size_t i = 0; i < _gamma.size(); i++ )
+		_gamma[i] = gamma[i];
+	for( size_t i = 0; i < _embedded.size(); i++ )
+		_embedded[i] = embedded[i];
+}
+
+void MRIGARK::Stage(FP tn, FP dt, long i, const FP* gamma, Vec<FP>& v) {
+	FP dc = _c[i] - _c[i-1];
+	if( dc == 0 ) {
+		for( long k = 0; k < _degree; k++ )
+			for( long j = 0; j < i; j++ )
+				if( gamma[k*_stages+j] != 0 )
+					v.AddScaled(dt*gamma[k*_stages+j]/(k+1), _fS[j]);
+		return;
+	}
+
+	for( long k = 0; k < _degree; k++ ) {
+		Vec<FP>& r = _fastIVP->Forcing(k);
+		r.Zero();
+		for( long j = 0; j < i; j++ )
+			if( gamma[k*_stages+j] != 0 )
+				r.AddScaled(gamma[k*_stages+j]/dc, _fS[j]);
+	}
+	_fastIVP->SetInterval(tn + _c[i-1]*dt, dc*dt);
+	Fast(tn + _c[i-1]*dt, dc*dt, v);
+}
+
+void MRIGARK::Fast(FP t0, FP length, Vec<FP>& v) {
+	// The forcing changed, so nothing the inner method kept from its last
+	// step is valid anymore
+	_inner->Restart();
+
+	if( _substeps ) {
+		FP h = length/_substeps;
+		for( long n = 0; n < _substeps; n++ ) {
+			_inner->SetAccept(true);
+			_inner->Step(t0 + n*h, h, v, _v);
+			v = _v;
+			_fastAccepted++;
+			_fastDtOld = h;
+			_statFastSteps++;
+		}
+		return;
+	}
+
+	long q = std::min(_inner->GetOrder(), _inner->GetAuxOrder());
+	if( _fastDt <= 0 )
+		_fastDt = length/10;
+
+	FP t = 0;
+	long substeps = 0;
+	while( t < length ) {
+		if( ++substeps > _maxSubsteps ) {
+			_accept = false;
+			return;
+		}
+
+		FP rest = length - t;
+		FP h = _stretch*_fastDt >= rest ? rest : _fastDt;
+		_inner->SetAccept(true);
+		_inner->PreStep(t0 + t, h, v);
+		_inner->Step(t0 + t, h, v, _v);
+		_inner->PostStep(t0 + t, h, v);
+		FP eps = _inner->CalcEpsilon(t0 + t, h, v, _v, _fastAtol, _fastRtol);
+
+		if( !_inner->Accept() || _v.IsNan() ) {
+			_fastDt = h/5;
+			_statFastRejections++;
+			continue;
+		}
+
+		FP factor = std::max(FP(0.2), std::min(FP(5), FP(0.9)*pow(eps, -FP(1)/(q+1))));
+		if( eps > 1 ) {
+			_fastDt = h*factor;
+			_statFastRejections++;
+			continue;
+		}
+
+		v = _v;
+		t = h < rest ? t + h : length;
+		_inner->UpdateTimestep();
+		_fastAccepted++;
+		_fastDtOld = h;
+		_statFastSteps++;
+
+		// A last substep shortened to the end of the stage says little about
+		// the step size the next stage can take
+		_fastDt = h < _fastDt ? std::max(_fastDt, h*factor) : h*factor;
+	}
+}
+
+void MRIGARK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	// Only cleared by a fast integration that fails, which not every solver
+	// checks for
+	_accept = true;
+
+	_Y[0] = yn;
+	(*_ivp)(tn, yn, _fS[0], _slowSplit);
+	for( long i = 1; i < _stages; i++ ) {
+		_Y[i] = _Y[i-1];
+		Stage(tn, dt, i, &_gamma[i*_degree*_stages], _Y[i]);
+		if( !_accept )
+			break;
+		if( i < _stages-1 )
+			(*_ivp)(tn + _c[i]*dt, _Y[i], _fS[i], _slowSplit);
+	}
+	ynew = _Y[_stages-1];
+}
+
+FP MRIGARK::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	if( !_accept )
+		return 2;
+
+	_yhat = _Y[_stages-2];
+	Stage(tn, dt, _stages-1, &_embedded[0], _yhat);
+	return ((ynew-_yhat)/StepControlSolver::GetTolerances(yn, ynew, atol, rtol)).RMS();
+}
+
+void MRIGARK::GetStats(Hash<ParamValue>& params) const {
+	BaseMethod::GetStats(params);
+	params["fast steps"].SetLong(_statFastSteps);
+	params["fast rejections"].SetLong(_statFastRejections);
+}
+
+// -----------------------------------------------------------------------------------
+
+MRIGARK22a::MRIGARK22a(Hash<ParamValue>& params, BaseIVP* ivp) : MRIGARK(params, ivp, 3, 1) {
+	const double c[] = { 0, 0.5, 1 };
+	const double gamma[] = {
+		0, 0, 0,
+		0.5, 0, 0,
+		-0.5, 1, 0
+	};
+	const double embedded[] = { 0.5, 0, 0 };
+	SetTable(c, gamma, embedded);
+}
+
+const char* MRIGARK22a::GetName() const {
+	return "MRI-GARK ERK22a";
+}
+
+long MRIGARK22a::GetOrder() const {
+	return 2;
+}
+
+long MRIGARK22a::GetAuxOrder() const {
+	return 1;
+}
+
+MRIGARK22b::MRIGARK22b(Hash<ParamValue>& params, BaseIVP* ivp) : MRIGARK(params, ivp, 3, 1) {
+	const double c[] = { 0, 1, 1 };
+	const double gamma[] = {
+		0, 0, 0,
+		1, 0, 0,
+		-0.5, 0.5, 0
+	};
+	const double embedded[] = { 0, 0, 0 };
+	SetTable(c, gamma, embedded);
+}
+
+const char* MRIGARK22b::GetName() const {
+	return "MRI-GARK ERK22b";
+}
+
+long MRIGARK22b::GetOrder() const {
+	return 2;
+}
+
+long MRIGARK22b::GetAuxOrder() const {
+	return 1;
+}
+
+MRIGARK33a::MRIGARK33a(Hash<ParamValue>& params, BaseIVP* ivp) : MRIGARK(params, ivp, 4, 2) {
+	const double c[] = { 0, 1./3, 2./3, 1 };
+	const double gamma[] = {
+		0, 0, 0, 0,
+		0, 0, 0, 0,
+
+		1./3, 0, 0, 0,
+		0, 0, 0, 0,
+
+		-1./3, 2./3, 0, 0,
+		0, 0, 0, 0,
+
+		0, -2./3, 1, 0,
+		0.5, 0, -0.5, 0
+	};
+	const double embedded[] = {
+		0, -1./6, 0.5, 0,
+		0, 0, 0, 0
+	};
+	SetTable(c, gamma, embedded);
+}
+
+const char* MRIGARK33a::GetName() const {
+	return "MRI-GARK ERK33a";
+}
+
+long MRIGARK33a::GetOrder() const {
+	return 3;
+}
+
+long MRIGARK33a::GetAuxOrder() const {
+	return 2;
+}
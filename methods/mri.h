@@ -0,0 +1,126 @@
+#ifndef MRI_H
+#define MRI_H
+
+#include <methods/basemethod.h>
+
+#include <vector>
+
+// The fast problem of a multirate stage: the fast split of the outer IVP plus
+// a forcing polynomial sum_k r_k theta^k in theta = (t - t0)/length, which
+// carries the slow split into the fast integration.
+class MRIFastIVP : public BaseIVP {
+protected:
+	BaseIVP* _outer;
+	unsigned short _split;
+	FP _t0;
+	FP _length;
+	std::vector<Vec<FP> > _forcing;
+
+	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp);
+
+public:
+	MRIFastIVP(Hash<ParamValue>& params, BaseIVP* outer, unsigned short split, long degree);
+
+	void SetInterval(FP t0, FP length);
+	Vec<FP>& Forcing(long k);
+
+	virtual const char* GetName();
+};
+
+// Explicit multirate infinitesimal GARK methods of Sandu for two-splitting
+// IVPs, with a slow split evaluated once per outer stage and a fast split
+// integrated in between by another method. Stage i solves
+//
+//	v' = f_fast(t, v) + 1/dc_i sum_j sum_k gamma^k_ij theta^k f_slow(T_j, Y_j)
+//
+// from v(T_i-1) = Y_i-1 to Y_i = v(T_i), with dc_i = c_i - c_i-1 and theta the
+// fraction of the stage interval, and a stage with dc_i = 0 is a plain slow
+// update. With constant forcing (a single gamma) they are the MIS methods of
+// Knoth and Wolke. The slow error is estimated by an embedded last stage from
+// Y_s-2, which costs one more fast integration over the last interval.
+//
+// The fast split (-fast\ split, 2 by default, which is the reaction in the
+// IVPs here) is integrated by -fast\ method with its own step control and
+// tolerances (-fast\ rtol, -fast\ atol), or in -fast\ substeps equal substeps
+// per stage for methods without an error estimate.
+class MRIGARK : public BaseMethod {
+protected:
+	long _stages;
+	long _degree;
+	std::vector<FP> _c;
+
+	// gamma^k_ij at _gamma[(i*_degree + k)*_stages + j], and the embedded
+	// last stage at _embedded[k*_stages + j]
+	std::vector<FP> _gamma;
+	std::vector<FP> _embedded;
+
+	unsigned short _fastSplit;
+	unsigned short _slowSplit;
+	MRIFastIVP* _fastIVP;
+	BaseMethod* _inner;
+
+	long _substeps;
+	long _maxSubsteps;
+	FP _fastRtol;
+	FP _fastAtol;
+	FP _fastDt;
+	FP _stretch;
+
+	// The solver variables of the inner method
+	long _fastAccepted;
+	FP _fastDtOld;
+
+	Vec<FP>* _Y;
+	Vec<FP>* _fS;
+	Vec<FP> _v;
+	Vec<FP> _yhat;
+
+	long _statFastSteps;
+	long _statFastRejections;
+
+	void SetTable(const double* c, const double* gamma, const double* embedded);
+	void Stage(FP tn, FP dt, long i, const FP* gamma, Vec<FP>& v);
+	void Fast(FP t0, FP length, Vec<FP>& v);
+
+public:
+	MRIGARK(Hash<ParamValue>& params, BaseIVP* ivp, long stages, long degree);
+	virtual ~MRIGARK();
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+	virtual void GetStats(Hash<ParamValue>& params) const;
+};
+
+// The explicit midpoint rule as slow method
+class MRIGARK22a : public MRIGARK {
+public:
+	MRIGARK22a(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// Heun's method as slow method, with a single fast integration per step and
+// the correction as a slow update
+class MRIGARK22b : public MRIGARK {
+public:
+	MRIGARK22b(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// Heun's third order method as slow method, with a linear forcing in the last
+// stage
+class MRIGARK33a : public MRIGARK {
+public:
+	MRIGARK33a(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include <core/exception.h>
+#include <methods/newton.h>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+NewtonControl::NewtonControl(Hash<ParamValue>& params, long maxIterations) {
+	_kappa = GetDefaultFP(params, "newton kappa", 0.05);
+	_tol = GetDefaultFP(params, "newton tol", 1e-8);
+	_bounded = params.Get("newton tol") != 0;
+	_fail = GetDefaultFP(params, "newton fail", 1e20);
+	_maxIterations = GetDefaultLong(params, "newton max iterations", maxIterations);
+	if( _kappa <= 0 || _tol <= 0 )
+		throw Exception() << "newton kappa and newton tol must be greater than zero.";
+	if( _maxIterations < 1 )
+		throw Exception() << "newton max iterations must be at least one.";
+
+	_scaled = false;
+	_eta = 1;
+	_theta = 0;
+	_last = 0;
+	_iteration = 0;
+
+	_statSolves = 0;
+	_statIterations = 0;
+	_statDiverged = 0;
+	_statSlow = 0;
+	_histogram.assign(_maxIterations, 0);
+}
+
+void NewtonControl::Start(const Vec<FP>& y, FP atol, FP rtol) {
+	if( _weights.Size() != y.Size() )
+		_weights.Resize(y.Size());
+
+	// An error of kappa in the weighted norm is an error of newton tol
+	FP bound = _tol/_kappa;
+	_scaled = atol > 0 || rtol > 0;
+	for( long i = 0; i < y.Size(); i++ ) {
+		FP w = _scaled ? atol + rtol*fabs(y[i]) : bound;
+		_weights[i] = _bounded ? std::min(w, bound) : w;
+	}
+
+	_eta = pow(std::max(_eta, std::numeric_limits<FP>::epsilon()), FP(0.8));
+	_theta = 0;
+	_iteration = 0;
+	_statSolves++;
+}
+
+FP NewtonControl::Norm(const Vec<FP>& dx, FP scale) const {
+	FP sum = 0;
+	for( long i = 0; i < dx.Size(); i++ )
+		sum += sqr(scale*dx[i]/_weights[i]);
+	return sqrt(sum/dx.Size());
+}
+
+void NewtonControl::Converged() {
+	_histogram[_iteration-1]++;
+}
+
+// The rate no longer tells how the next solve will go
+NewtonControl::Status NewtonControl::Failed() {
+	_eta = 1;
+	return FAILED;
+}
+
+NewtonControl::Status NewtonControl::Check(FP norm, bool exact) {
+	_iteration++;
+	_statIterations++;
+
+	if( !(norm <= _fail) ) {
+		_statDiverged++;
+		return Failed();
+	}
+
+	if( exact || norm == 0 ) {
+		Converged();
+		return CONVERGED;
+	}
+
+	if( _iteration > 1 ) {
+		_theta = norm/_last;
+		if( _theta >= FP(0.99) ) {
+			_statDiverged++;
+			return Failed();
+		}
+
+		if( pow(_theta, FP(_maxIterations - _iteration))/(1 - _theta)*norm > _kappa ) {
+			_statSlow++;
+			return Failed();
+		}
+		_eta = _theta/(1 - _theta);
+	}
+
+	// Fixed steps take the whole error of every solve, so they stop on the
+	// increment itself rather than on the error predicted after it. The rate
+	// carried into the first iteration was measured at an older step size,
+	// so it is trusted only once the increment is within the tolerance.
+	if( (_iteration > 1 || norm <= 1) && (_scaled ? _eta : std::max(_eta, FP(1)))*norm <= _kappa ) {
+		Converged();
+		return CONVERGED;
+	}
+
+	if( _iteration >= _maxIterations ) {
+		_statSlow++;
+		return Failed();
+	}
+
+	_last = norm;
+	return ITERATE;
+}
+
+NewtonControl::Status NewtonControl::Check(const Vec<FP>& dx, FP scale, bool exact) {
+	return Check(Norm(dx, scale), exact);
+}
+
+FP NewtonControl::Theta() const {
+	return _theta;
+}
+
+long NewtonControl::Iterations() const {
+	return _iteration;
+}
+
+void NewtonControl::Merge(const NewtonControl& other) {
+	_statSolves += other._statSolves;
+	_statIterations += other._statIterations;
+	_statDiverged += other._statDiverged;
+	_statSlow += other._statSlow;
+	for( long k = 0; k < _maxIterations && k < other._maxIterations; k++ )
+		_histogram[k] += other._histogram[k];
+}
+
+void NewtonControl::GetStats(Hash<ParamValue>& params) const {
+	if( !_statSolves )
+		return;
+
+	std::ostringstream histogram;
+	for( long k = 0; k < _maxIterations; k++ )
+		if( _histogram[k] )
+			histogram << (histogram.tellp() > 0 ? " " : "") << k+1 << ":" << _histogram[k];
+
+	params["newton solves"].SetLong(_statSolves);
+	params["newton iterations"].SetLong(_statIterations);
+	params["newton diverged"].SetLong(_statDiverged);
+	params["newton slow"].SetLong(_statSlow);
+	params["newton histogram"].SetString(histogram.str().c_str());
+}
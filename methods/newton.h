@@ -0,0 +1,87 @@
+#ifndef NEWTON_H
+#define NEWTON_H
+
+#include <core/common.h>
+#include <core/hash.h>
+#include <core/paramvalue.h>
+#include <core/vec.h>
+
+#include <vector>
+
+// Convergence control of the simplified Newton iterations of the implicit
+// methods, after Hairer and Wanner (IV.8). Under a step control solver,
+// increments are measured in the RMS norm weighted by atol + rtol |y|, with
+// the tolerances of that solver, so the iteration stops once its error is a
+// fraction -newton\ kappa of the local error allowed, or -newton\ tol if that
+// is given and smaller. With the contraction rate theta = |dx_k|/|dx_k-1|,
+// the error left after iteration k is about eta |dx_k| with
+// eta = theta/(1-theta), and a solve
+//
+//	converges when eta |dx_k| <= kappa,
+//	fails when theta >= 0.99, or when theta^(kmax-k)/(1-theta) |dx_k| > kappa
+//	says it will not converge within -newton\ max\ iterations.
+//
+// The first iteration has no rate yet and uses the eta of the previous solve.
+// Under fixed steps there is no local error to compare with, and a solve
+// converges once max(eta, 1) |dx_k| is below -newton\ tol (default 1e-8). A
+// failed solve clears Accept, so the step is retried with a smaller dt.
+class NewtonControl {
+public:
+	enum Status {
+		ITERATE,
+		CONVERGED,
+		FAILED
+	};
+
+protected:
+	FP _kappa;
+	FP _tol;
+	bool _bounded;
+	bool _scaled;
+	FP _fail;
+	long _maxIterations;
+
+	Vec<FP> _weights;
+	FP _eta;
+	FP _theta;
+	FP _last;
+	long _iteration;
+
+	long _statSolves;
+	long _statIterations;
+	long _statDiverged;
+	long _statSlow;
+
+	// Solves that converged in k iterations at k-1
+	std::vector<long> _histogram;
+
+	void Converged();
+	Status Failed();
+
+public:
+	NewtonControl(Hash<ParamValue>& params, long maxIterations);
+
+	// Starts a solve whose unknowns are of the size of y, with the tolerances
+	// of the step control solver, or zero under fixed steps
+	void Start(const Vec<FP>& y, FP atol, FP rtol);
+
+	// The weighted norm of an increment of the unknowns scaled by scale, for
+	// unknowns such as stage derivatives whose effect on y is scaled by dt
+	FP Norm(const Vec<FP>& dx, FP scale = 1) const;
+
+	// Checks the norm of the latest increment. Linear problems are solved by
+	// the first iteration, which they mark as exact.
+	Status Check(FP norm, bool exact = false);
+	Status Check(const Vec<FP>& dx, FP scale = 1, bool exact = false);
+
+	// The contraction rate and number of iterations of the last solve
+	FP Theta() const;
+	long Iterations() const;
+
+	// Adds the stats of a control of the same method, for methods that solve
+	// on several threads with one control each
+	void Merge(const NewtonControl& other);
+	void GetStats(Hash<ParamValue>& params) const;
+};
+
+#endif
@@ -0,0 +1,254 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/nordsieck.h>
+
+NordsieckMethod::NordsieckMethod(Hash<ParamValue>& params, BaseIVP* ivp, long maxOrder) : BaseMethod(params, ivp) {
+	_maxOrder = GetDefaultLong(params, "max order", maxOrder);
+	if( _maxOrder < 1 || _maxOrder > maxOrder )
+		throw Exception() << "max order must be between 1 and " << maxOrder << ".";
+
+	_rTol = GetDefaultFP(params, "rtol", 1e-5);
+	_aTol = GetDefaultFP(params, "atol", 1e-5);
+
+	_z = _history[0];
+	_zn = _history[1];
+	_t = 0;
+	_h = 0;
+	_q = 1;
+	_stepsAtOrder = 0;
+	_constantSteps = 0;
+	_restart = true;
+	_autoOrder = true;
+	_retry = false;
+	_retries = 0;
+
+	_eH = 0;
+	_hPrev = 0;
+	_eOrder = 0;
+	_ePrevOrder = 0;
+	_crate = 1;
+	_rhsEvals = 0;
+
+	if( ivp ) {
+		for( long j = 0; j < NORDSIECK_MAX_ORDER+2; j++ ) {
+			_history[0][j].Resize(ivp->Size());
+			_history[1][j].Resize(ivp->Size());
+		}
+		_acor.Resize(ivp->Size());
+		_e.Resize(ivp->Size());
+		_ePrev.Resize(ivp->Size());
+		_tol.Resize(ivp->Size());
+	}
+}
+
+void NordsieckMethod::Restart(FP tn, FP dt, const Vec<FP>& yn) {
+	_t = tn;
+	_h = dt;
+	_q = 1;
+	SetCoefficients();
+
+	_z[0] = yn;
+	_z[1].Resize(yn.Size());
+	(*_ivp)(tn, yn, _z[1]);
+	_rhsEvals++;
+	_z[1] *= dt;
+
+	_stepsAtOrder = 0;
+	_constantSteps = 0;
+	_eOrder = 0;
+	_ePrevOrder = 0;
+	_restart = false;
+}
+
+void NordsieckMethod::Rescale(FP dt) {
+	FP eta = dt/_h;
+	FP s = 1;
+	for( long j = 1; j <= _q; j++ ) {
+		s *= eta;
+		_z[j] *= s;
+	}
+	_h = dt;
+	_constantSteps = 0;
+}
+
+// Under a solver that knows nothing about the history, the step size is held
+// for q+1 steps after every change, as rescaling the history on every step is
+// not stable at high order. Smaller steps after a rejection are always taken.
+void NordsieckMethod::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
+	if( !_autoOrder || _restart || _retry || tn != _t )
+		return;
+
+	if( _constantSteps <= _q )
+		dt = _h;
+}
+
+void NordsieckMethod::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	bool restart = _restart || tn != _t;
+	for( long i = 0; !restart && i < yn.Size(); i++ )
+		restart = _z[0][i] != yn[i];
+
+	// Repeated failures at a solver's step size call for a lower order
+	if( _retry && _autoOrder && ++_retries >= 2 && _q > 1 ) {
+		SetOrder(_q-1);
+		_retries = 0;
+	}
+
+	if( restart )
+		Restart(tn, dt, yn);
+	else if( dt != _h )
+		Rescale(dt);
+	_retry = true;
+
+	_tol = StepControlSolver::GetTolerances(yn, yn, _aTol, _rTol);
+
+	// Predict with the Pascal triangle
+	for( long j = 0; j <= _q; j++ )
+		_zn[j] = _z[j];
+	for( long k = 0; k < _q; k++ )
+		for( long j = _q; j > k; j-- )
+			_zn[j-1] += _zn[j];
+
+	if( !Correct(tn + dt) ) {
+		_accept = false;
+		ynew = _zn[0];
+		return;
+	}
+
+	for( long j = 0; j <= _q; j++ )
+		_zn[j].AddScaled(_l[j], _acor);
+	ynew = _zn[0];
+}
+
+void NordsieckMethod::UpdateTimestep() {
+	std::swap(_z, _zn);
+	_t += _h;
+
+	_ePrev = _e;
+	_hPrev = _eH;
+	_ePrevOrder = _eOrder;
+	_e = _acor;
+	_eH = _h;
+	_eOrder = _q;
+
+	_stepsAtOrder++;
+	_constantSteps++;
+	_retry = false;
+	_retries = 0;
+
+	// Without a solver that chooses the order, change it here as
+	// MultistepSolver would
+	if( _autoOrder && _constantSteps > _q ) {
+		FP factor;
+		long order = SelectOrder(factor);
+		if( order != _q && factor <= 1/FP(1.1) )
+			SetOrder(order);
+	}
+}
+
+// The history array is already the interpolating polynomial of the last step
+void NordsieckMethod::DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+}
+
+void NordsieckMethod::Interpolate(FP t, Vec<FP>& y) const {
+	FP s = (t - _t)/_h;
+	y = _z[_q];
+	for( long j = _q-1; j >= 0; j-- ) {
+		y *= s;
+		y += _z[j];
+	}
+}
+
+FP NordsieckMethod::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	_tol = StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
+	return ErrorConstant(_q)*(_acor/_tol).RMS();
+}
+
+FP NordsieckMethod::ErrorEstimate(long order) const {
+	// The correction is h^(q+1) y^(q+1)
+	if( order == _q )
+		return ErrorConstant(_q)*(_e/_tol).RMS();
+
+	// z_q = h^q y^(q)/q!
+	if( order == _q-1 && order >= 1 ) {
+		FP fact = 1;
+		for( long i = 2; i <= _q; i++ )
+			fact *= i;
+		return ErrorConstant(_q-1)*fact*(_z[_q]/_tol).RMS();
+	}
+
+	// The difference of the last two corrections, brought to the same step
+	// size, is h^(q+2) y^(q+2)
+	if( order == _q+1 && order <= _maxOrder && _eOrder == _q && _ePrevOrder == _q ) {
+		Vec<FP> d = _ePrev*FP(-pow(_eH/_hPrev, _q+1));
+		d += _e;
+		return ErrorConstant(_q+1)*(d/_tol).RMS();
+	}
+
+	return -1;
+}
+
+long NordsieckMethod::SelectOrder(FP& factor) const {
+	// Staying at the same order is preferred, lowering it more so than raising
+	const FP bias[3] = { 1.3, 1.2, 1.4 };
+
+	long order = _q;
+	factor = -1;
+	for( long k = _q-1; k <= _q+1; k++ ) {
+		FP err = ErrorEstimate(k);
+		if( err < 0 )
+			continue;
+
+		FP f = bias[k-_q+1]*pow(err, FP(1)/(k+1)) + 1e-6;
+		if( factor < 0 || f < factor ) {
+			factor = f;
+			order = k;
+		}
+	}
+	return order;
+}
+
+// Raising the order builds z_(q+1) = h^(q+1) y^(q+1)/(q+1)! from the last
+// correction, lowering it drops the top column.
+void NordsieckMethod::SetOrder(long order) {
+	if( order == _q )
+		return;
+
+	if( order < 1 || order > _maxOrder || order > _q+1 )
+		throw Exception() << GetName() << " order can only be raised by one, up to " << _maxOrder << ".";
+
+	if( order > _q ) {
+		FP fact = 1;
+		for( long i = 2; i <= order; i++ )
+			fact *= i;
+		_z[order] = _e/fact;
+	}
+
+	_q = order;
+	SetCoefficients();
+	_stepsAtOrder = 0;
+	_constantSteps = 0;
+}
+
+void NordsieckMethod::SetAutoOrder(bool autoOrder) {
+	_autoOrder = autoOrder;
+}
+
+void NordsieckMethod::ForceRestart() {
+	_restart = true;
+}
+
+long NordsieckMethod::ConstantSteps() const {
+	return _constantSteps;
+}
+
+long NordsieckMethod::GetMaxOrder() const {
+	return _maxOrder;
+}
+
+void NordsieckMethod::GetStats(Hash<ParamValue>& params) const {
+	params["rhs evaluations"].SetLong(_rhsEvals);
+}
+
+long NordsieckMethod::GetOrder() const {
+	return _q;
+}
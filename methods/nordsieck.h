@@ -0,0 +1,92 @@
+#ifndef NORDSIECK_H
+#define NORDSIECK_H
+
+#include <core/common.h>
+#include <methods/basemethod.h>
+
+#define NORDSIECK_MAX_ORDER 12
+
+// Variable order, variable step multistep methods in Nordsieck form. The
+// history array holds z_j = h^j y^(j)/j! for j = 0..q at the current time, so
+// a change of step size is a rescaling of the columns and the dense output is
+// the polynomial itself. A step predicts with the Pascal triangle and solves
+// the corrector for a correction e that updates every column, z_j += l_j e.
+// Derived classes supply the corrector coefficients l, the error constants
+// and the corrector iteration.
+class NordsieckMethod : public BaseMethod {
+protected:
+	Vec<FP> _history[2][NORDSIECK_MAX_ORDER+2];
+	Vec<FP>* _z;
+	Vec<FP>* _zn;
+
+	FP _t;
+	FP _h;
+	long _q;
+	long _maxOrder;
+	long _stepsAtOrder;
+	long _constantSteps;
+	bool _restart;
+	bool _autoOrder;
+	bool _retry;
+	long _retries;
+	FP _l[NORDSIECK_MAX_ORDER+1];
+
+	// Correction of the current step, and those of the last two accepted
+	// steps for the order q+1 estimate
+	Vec<FP> _acor;
+	Vec<FP> _e;
+	Vec<FP> _ePrev;
+	FP _eH;
+	FP _hPrev;
+	long _eOrder;
+	long _ePrevOrder;
+
+	// The corrector iteration is measured in the same norm as the error test
+	Vec<FP> _tol;
+	FP _rTol;
+	FP _aTol;
+	FP _crate;
+
+	long _rhsEvals;
+
+	void Restart(FP tn, FP dt, const Vec<FP>& yn);
+	void Rescale(FP dt);
+
+	virtual void SetCoefficients() = 0;
+	virtual bool Correct(FP t) = 0;
+
+	// Multiplier taking ||h^(k+1) y^(k+1)|| to the local error at order k
+	virtual FP ErrorConstant(long order) const = 0;
+
+public:
+	NordsieckMethod(Hash<ParamValue>& params, BaseIVP* ivp, long maxOrder);
+
+	virtual void PreStep(const FP tn, FP& dt, Vec<FP>& yn);
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual void UpdateTimestep();
+
+	virtual void DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew);
+	virtual void Interpolate(FP t, Vec<FP>& y) const;
+
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+
+	// Error estimate of the last accepted step had it been taken at order
+	// q-1, q or q+1. Returns a negative value when it is not available.
+	FP ErrorEstimate(long order) const;
+
+	// Order whose error estimate allows the largest next step, along with
+	// the reciprocal of that step size ratio
+	long SelectOrder(FP& factor) const;
+
+	void SetOrder(long order);
+	void SetAutoOrder(bool autoOrder);
+	void ForceRestart();
+	long ConstantSteps() const;
+	long GetMaxOrder() const;
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual long GetOrder() const;
+};
+
+#endif
@@ -0,0 +1,199 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/pdirk.h>
+
+PDIRK::PDIRK(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp), _a(PDIRK_MAX_STAGES, PDIRK_MAX_STAGES), _c(PDIRK_MAX_STAGES), _d(PDIRK_MAX_STAGES), _newton(PDIRK_MAX_STAGES, NewtonControl(params, 20)) {
+	_stages = GetDefaultLong(params, "pdirk stages", 3);
+	if( _stages < 2 || _stages > PDIRK_MAX_STAGES )
+		throw Exception() << "pdirk stages must be 2 or 3.";
+	_iterations = GetDefaultLong(params, "pdirk iterations", 2*_stages - 1);
+	if( _iterations < 2 )
+		throw Exception() << "pdirk iterations must be at least two.";
+
+	_threads = GetDefaultLong(params, "threads", 1);
+	_pool = new ThreadPool(_threads);
+	_threads = _pool->Size();
+	if( _threads > 1 && ivp && !ivp->ThreadSafeRHS() )
+		throw Exception() << ivp->GetName() << " does not declare a thread-safe right hand side.";
+
+	_a.Zero();
+	if( _stages == 2 ) {
+		_a(0,0) = FP(5)/12; _a(0,1) = -FP(1)/12;
+		_a(1,0) = FP(3)/4;  _a(1,1) = FP(1)/4;
+
+		_c(0) = FP(1)/3;
+		_c(1) = 1;
+
+		_d(1) = (4 + sqrt(FP(6)))/10;
+		_d(0) = 1/(6*_d(1));
+	} else {
+		FP sq6 = sqrt(FP(6));
+
+		_a(0,0) = (88-7*sq6)/360;
+		_a(0,1) = (296-169*sq6)/1800;
+		_a(0,2) = (-2+3*sq6)/225;
+
+		_a(1,0) = (296+169*sq6)/1800;
+		_a(1,1) = (88+7*sq6)/360;
+		_a(1,2) = (-2-3*sq6)/225;
+
+		_a(2,0) = (16-sq6)/36;
+		_a(2,1) = (16+sq6)/36;
+		_a(2,2) = FP(1)/9;
+
+		_c(0) = (4-sq6)/10;
+		_c(1) = (4+sq6)/10;
+		_c(2) = 1;
+
+		// Of the positive diagonals that make I - D^-1 A nilpotent, the one
+		// with the smallest iteration error on the imaginary axis
+		_d(0) = 0.32038277768578083042;
+		_d(1) = 0.13996680467732669480;
+		_d(2) = 0.37166745952291147760;
+	}
+
+	_jac = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+	for( long i = 0; i < PDIRK_MAX_STAGES; i++ ) {
+		_mats[i] = i < _stages ? (_sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>) : 0;
+		_evals[i] = 0;
+		if( ivp && i < _stages ) {
+			_y[i].Resize(ivp->Size());
+			_f[i].Resize(ivp->Size());
+			_fOld[i].Resize(ivp->Size());
+			_rhs[i].Resize(ivp->Size());
+			_res[i].Resize(ivp->Size());
+			_delta[i].Resize(ivp->Size());
+		}
+	}
+	if( ivp ) {
+		_f0.Resize(ivp->Size());
+		_yPrev.Resize(ivp->Size());
+	}
+
+	_rhsEvals = 0;
+	_statIterations = 0;
+	_statJacobians = 0;
+	_statFactorizations = 0;
+}
+
+PDIRK::~PDIRK() {
+	delete _jac;
+	for( long i = 0; i < PDIRK_MAX_STAGES; i++ )
+		delete _mats[i];
+	delete _pool;
+}
+
+// Simplified Newton for Y_i = _rhs[i] + a f(t, Y_i), starting from the last
+// iterate, with a control of its own so that the stages can be solved on
+// different threads. _f[i] is left evaluated at the solution.
+bool PDIRK::Solve(long i, FP t, FP a) {
+	_newton[i].Start(_y[i], _solverATol, _solverRTol);
+	for( ;; ) {
+		(*_ivp)(t, _y[i], _f[i]);
+		_evals[i]++;
+
+		_res[i] = _rhs[i];
+		_res[i].AddScaled(a, _f[i]);
+		_res[i] -= _y[i];
+
+		_mats[i]->Solve(_res[i], _delta[i]);
+		_y[i] += _delta[i];
+
+		switch( _newton[i].Check(_delta[i]) ) {
+		case NewtonControl::CONVERGED:
+			(*_ivp)(t, _y[i], _f[i]);
+			_evals[i]++;
+			return true;
+		case NewtonControl::FAILED:
+			return false;
+		default:
+			break;
+		}
+	}
+}
+
+void PDIRK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	if( _sparse )
+		*(CSRMat<FP>*)_jac = *(const CSRMat<FP>*)_ivp->JacSparse(tn, yn);
+	else
+		*(Mat<FP>*)_jac = *(const Mat<FP>*)_ivp->Jac(tn, yn);
+	_ivp->FreezeJacobian(true);
+	_statJacobians++;
+
+	_pool->ParallelFor(_stages, [&](long i) {
+		if( _sparse )
+			*(CSRMat<FP>*)_mats[i] = CSRMat<FP>::Eye(yn.Size()) - dt*_d(i)**(CSRMat<FP>*)_jac;
+		else
+			*(Mat<FP>*)_mats[i] = Mat<FP>::Eye(yn.Size()) - dt*_d(i)**(Mat<FP>*)_jac;
+		_mats[i]->Factor();
+	});
+	_statFactorizations += _stages;
+
+	(*_ivp)(tn, yn, _f0);
+	_rhsEvals++;
+	for( long i = 0; i < _stages; i++ ) {
+		_y[i] = yn;
+		_f[i] = _f0;
+		_evals[i] = 0;
+	}
+
+	bool converged[PDIRK_MAX_STAGES];
+	bool ok = true;
+	for( long j = 0; j < _iterations && ok; j++ ) {
+		for( long i = 0; i < _stages; i++ )
+			_fOld[i] = _f[i];
+		_yPrev = _y[_stages-1];
+
+		_pool->ParallelFor(_stages, [&](long i) {
+			_rhs[i] = yn;
+			for( long k = 0; k < _stages; k++ )
+				_rhs[i].AddScaled(dt*(_a(i,k) - (i == k ? _d(i) : 0)), _fOld[k]);
+			converged[i] = Solve(i, tn + dt*_c(i), dt*_d(i));
+		});
+		_statIterations++;
+
+		for( long i = 0; i < _stages; i++ )
+			ok = ok && converged[i];
+	}
+
+	for( long i = 0; i < _stages; i++ )
+		_rhsEvals += _evals[i];
+
+	// Newton failed to converge, so reject
+	if( !ok )
+		_accept = false;
+
+	ynew = _y[_stages-1];
+	_ivp->FreezeJacobian(false);
+}
+
+// The change made by the last iteration
+FP PDIRK::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	Vec<FP> tol = StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
+	return ((ynew - _yPrev)/tol).RMS();
+}
+
+void PDIRK::GetStats(Hash<ParamValue>& params) const {
+	params["rhs evaluations"].SetLong(_rhsEvals);
+	params["iterations"].SetLong(_statIterations);
+	params["jacobian evaluations"].SetLong(_statJacobians);
+	params["factorizations"].SetLong(_statFactorizations);
+	params["threads"].SetLong(_threads);
+
+	NewtonControl newton(_newton[0]);
+	for( long i = 1; i < PDIRK_MAX_STAGES; i++ )
+		newton.Merge(_newton[i]);
+	newton.GetStats(params);
+}
+
+const char* PDIRK::GetName() const {
+	return "PDIRK";
+}
+
+long PDIRK::GetOrder() const {
+	return std::min(_iterations, 2*_stages - 1);
+}
+
+long PDIRK::GetAuxOrder() const {
+	return std::min(_iterations - 1, 2*_stages - 1);
+}
@@ -0,0 +1,71 @@
+#ifndef PDIRK_H
+#define PDIRK_H
+
+#include <core/common.h>
+#include <core/csrmat.h>
+#include <core/threadpool.h>
+#include <methods/basemethod.h>
+#include <methods/newton.h>
+
+#include <vector>
+
+#define PDIRK_MAX_STAGES 3
+
+// Parallel diagonally implicit iteration of the s-stage Radau IIA method. The
+// stage values start at yn and each iteration solves
+//
+//	Y_i - dt d_i f(Y_i) = yn + dt sum_k (a_ik - delta_ik d_i) f(Y_k^old)
+//
+// for every stage i. The stages only depend on the previous iterate, so they
+// are solved at the same time on a thread pool, each with its own Newton
+// matrix I - dt d_i J. The diagonal D makes I - D^-1 A nilpotent, so stiff
+// components have converged after s iterations, while every iteration raises
+// the order by one up to the 2s-1 of Radau IIA. The change made by the last
+// iteration estimates the error.
+class PDIRK : public BaseMethod {
+protected:
+	ThreadPool* _pool;
+	long _threads;
+
+	long _stages;
+	long _iterations;
+	Mat<FP> _a;
+	Vec<FP> _c;
+	Vec<FP> _d;
+
+	Vec<FP> _f0;
+	Vec<FP> _y[PDIRK_MAX_STAGES];
+	Vec<FP> _f[PDIRK_MAX_STAGES];
+	Vec<FP> _fOld[PDIRK_MAX_STAGES];
+	Vec<FP> _rhs[PDIRK_MAX_STAGES];
+	Vec<FP> _res[PDIRK_MAX_STAGES];
+	Vec<FP> _delta[PDIRK_MAX_STAGES];
+	Vec<FP> _yPrev;
+
+	BaseMat<FP>* _jac;
+	BaseMat<FP>* _mats[PDIRK_MAX_STAGES];
+	long _evals[PDIRK_MAX_STAGES];
+	std::vector<NewtonControl> _newton;
+
+	long _rhsEvals;
+	long _statIterations;
+	long _statJacobians;
+	long _statFactorizations;
+
+	bool Solve(long i, FP t, FP a);
+
+public:
+	PDIRK(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~PDIRK();
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+#endif
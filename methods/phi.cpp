@@ -0,0 +1,385 @@
+#include <core/exception.h>
+#include <methods/phi.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+static FP Dot(const Vec<FP>& a, const Vec<FP>& b) {
+	FP sum = 0;
+	for( long i = 0; i < a.Size(); i++ )
+		sum += a(i)*b(i);
+	return sum;
+}
+
+// exp(tau Hbar) for the first k columns of the Arnoldi matrix, with the
+// subdiagonal entry below them as an extra row when extended
+static void HessenbergExp(const Mat<FP>& H, long k, bool extended, FP tau, Mat<FP>& F) {
+	long size = k + extended;
+	Mat<FP> a(size, size);
+	a.Zero();
+	for( long i = 0; i < size; i++ )
+		for( long j = 0; j < k; j++ )
+			a(i,j) = tau*H(i,j);
+	PhiFunctions::DenseExp(a, F);
+}
+
+PhiFunctions::PhiFunctions(Hash<ParamValue>& params) {
+	_leja = !strcmp(GetDefaultString(params, "phi method", "krylov"), "leja");
+	_tol = GetDefaultFP(params, "phi tol", 100*std::numeric_limits<FP>::epsilon());
+	_fixedTol = params.Get("phi tol") != 0;
+	if( _tol <= 0 )
+		throw Exception() << "phi tol must be greater than zero.";
+	_maxDim = GetDefaultLong(params, "phi dim", 30);
+	_maxPoints = GetDefaultLong(params, "phi points", 40);
+	if( _maxDim < 1 || _maxPoints < 2 )
+		throw Exception() << "phi dim must be at least one and phi points at least two.";
+
+	// Leja points of [-2, 2], each maximizing the product of distances to
+	// the previous ones over a fine grid
+	long grid = 50*_maxPoints;
+	std::vector<FP> x(grid+1), logDist(grid+1, 0);
+	for( long i = 0; i <= grid; i++ )
+		x[i] = -2 + FP(4*i)/grid;
+	_points.push_back(2);
+	for( long j = 1; j < _maxPoints; j++ ) {
+		long best = 0;
+		for( long i = 0; i <= grid; i++ ) {
+			FP dist = fabs(x[i] - _points[j-1]);
+			logDist[i] = dist > 0 && logDist[i] > -std::numeric_limits<FP>::max() ? logDist[i] + log(dist) : -std::numeric_limits<FP>::max();
+			if( logDist[i] > logDist[best] )
+				best = i;
+		}
+		_points.push_back(x[best]);
+	}
+
+	_M = 0;
+	_scale = 1;
+	_n = 0;
+
+	_statMatvecs = 0;
+	_statSubsteps = 0;
+	_statRejections = 0;
+}
+
+// y = [|t|M W; 0 J] x
+void PhiFunctions::Apply(const Vec<FP>& x, Vec<FP>& y) {
+	long p = _u.size();
+	y.Resize(_n + p);
+	_statMatvecs++;
+
+	if( p == 0 ) {
+		_M->VectorMult(x, y);
+		y *= _scale;
+		return;
+	}
+
+	Vec<FP> top(_n);
+	for( long i = 0; i < _n; i++ )
+		_temp(i) = x(i);
+	_M->VectorMult(_temp, top);
+	top *= _scale;
+	for( long j = 0; j < p; j++ )
+		if( x(_n+j) != 0 )
+			top.AddScaled(_w[p-1-j]*x(_n+j), *_u[p-1-j]);
+
+	for( long i = 0; i < _n; i++ )
+		y(i) = top(i);
+	for( long j = 0; j < p-1; j++ )
+		y(_n+j) = x(_n+j+1);
+	y(_n+p-1) = 0;
+}
+
+// Expokit's expv: each substep builds a Krylov space of exp(tau A) w, checking
+// Saad's error estimate at dimensions 4, 8, 16, ... and shrinking tau once the
+// largest dimension does not suffice
+void PhiFunctions::Krylov(FP t, Vec<FP>& w) {
+	long m = std::min(_maxDim, w.Size());
+	FP eps = std::numeric_limits<FP>::epsilon();
+	FP sgn = t < 0 ? -1 : 1;
+	FP tEnd = fabs(t);
+	FP remaining = tEnd;
+	FP tau = tEnd;
+
+	if( (long)_V.size() < m+1 )
+		_V.resize(m+1);
+	Mat<FP> H(m+1, m);
+	Mat<FP> F;
+
+	while( remaining > 0 ) {
+		FP beta = w.Norm();
+		if( beta == 0 )
+			return;
+		FP tol = _tol*beta/tEnd;
+
+		tau = std::min(tau, remaining);
+		_V[0] = w;
+		_V[0] /= beta;
+		H.Zero();
+
+		long k = 0;
+		bool happy = false;
+		FP err = 0;
+		for( long j = 0; j < m; j++ ) {
+			Apply(_V[j], _V[j+1]);
+			FP avnorm = _V[j+1].Norm();
+			for( long i = 0; i <= j; i++ ) {
+				FP h = Dot(_V[i], _V[j+1]);
+				H(i,j) = h;
+				_V[j+1].AddScaled(-h, _V[i]);
+			}
+			FP s = _V[j+1].Norm();
+			k = j+1;
+
+			// An invariant subspace, so the whole interval is exact
+			if( s <= 100*eps*avnorm ) {
+				happy = true;
+				tau = remaining;
+				err = 0;
+				HessenbergExp(H, k, false, sgn*tau, F);
+				break;
+			}
+			H(j+1,j) = s;
+			_V[j+1] /= s;
+
+			if( k == m || (k >= 4 && !(k & (k-1))) ) {
+				for( ;; ) {
+					HessenbergExp(H, k, true, sgn*tau, F);
+					err = fabs(beta*F(k,0));
+					if( err <= tau*tol || k < m )
+						break;
+					tau *= std::max(FP(0.2), FP(0.9)*pow(tau*tol/err, FP(1)/k));
+					_statRejections++;
+					if( tau <= 10*eps*tEnd )
+						throw Exception() << "Krylov substep too small in the phi functions.";
+				}
+				if( err <= tau*tol )
+					break;
+			}
+		}
+
+		long dim = happy ? k : k+1;
+		w.Zero();
+		for( long i = 0; i < dim; i++ )
+			w.AddScaled(beta*F(i,0), _V[i]);
+
+		remaining = tau >= remaining ? 0 : remaining - tau;
+		_statSubsteps++;
+		if( !happy )
+			tau *= err > 0 ? std::min(FP(5), FP(0.9)*pow(tau*tol/err, FP(1)/k)) : 5;
+	}
+}
+
+// Newton interpolation of exp(h (c + gamma xi)) at the Leja points, with
+// c + gamma [-2, 2] = [-rho, 0]. The divided differences are the first column
+// of the exponential of the bidiagonal matrix of the points, which stays
+// accurate where the recursive formula cancels. A substep is halved when the
+// last two terms do not fall below the tolerance.
+void PhiFunctions::Leja(FP t, Vec<FP>& w) {
+	FP rho = SpectralRadius();
+	FP c = -rho/2;
+	FP gamma = rho > 0 ? rho/4 : 1/fabs(t);
+	FP sgn = t < 0 ? -1 : 1;
+	FP tEnd = fabs(t);
+	FP remaining = tEnd;
+	FP h = std::min(tEnd, _maxPoints/(4*gamma));
+	FP hd = 0;
+
+	long m = _maxPoints;
+	Mat<FP> Z(m, m), E;
+	Vec<FP> d(m), r, q, p;
+
+	while( remaining > 0 ) {
+		bool last = h >= remaining;
+		if( last )
+			h = remaining;
+		if( h != hd ) {
+			Z.Zero();
+			for( long i = 0; i < m; i++ ) {
+				Z(i,i) = sgn*h*gamma*_points[i];
+				if( i > 0 )
+					Z(i,i-1) = sgn*h*gamma;
+			}
+			DenseExp(Z, E);
+			for( long i = 0; i < m; i++ )
+				d(i) = exp(sgn*h*c)*E(i,0);
+			hd = h;
+		}
+
+		FP tol = _tol*w.Norm()*h/tEnd;
+		p = w;
+		p *= d(0);
+		r = w;
+		bool converged = false;
+		FP errPrev = std::numeric_limits<FP>::max();
+		for( long j = 1; j < m; j++ ) {
+			Apply(r, q);
+			q.AddScaled(-c - gamma*_points[j-1], r);
+			r = q;
+			r /= gamma;
+			p.AddScaled(d(j), r);
+
+			FP err = fabs(d(j))*r.Norm();
+			if( err <= tol && errPrev <= tol ) {
+				converged = true;
+				break;
+			}
+			errPrev = err;
+		}
+
+		if( !converged ) {
+			h /= 2;
+			_statRejections++;
+			if( h <= 10*std::numeric_limits<FP>::epsilon()*tEnd )
+				throw Exception() << "Leja substep too small in the phi functions.";
+			continue;
+		}
+
+		w = p;
+		remaining = last ? 0 : remaining - h;
+		_statSubsteps++;
+	}
+}
+
+// A few power iterations from the last call's vector, with a margin
+FP PhiFunctions::SpectralRadius() {
+	if( _power.Size() != _n || _power.Norm() == 0 ) {
+		_power.Resize(_n);
+		for( long i = 0; i < _n; i++ )
+			_power(i) = 1 + FP(i)/_n;
+	}
+
+	Vec<FP> y(_n);
+	FP rho = 0;
+	for( long it = 0; it < 10; it++ ) {
+		FP norm = _power.Norm();
+		if( norm == 0 )
+			break;
+		_power /= norm;
+		_M->VectorMult(_power, y);
+		_statMatvecs++;
+		rho = y.Norm();
+		_power = y;
+	}
+
+	return FP(1.1)*rho*_scale;
+}
+
+void PhiFunctions::SetTolerance(FP rtol) {
+	if( !_fixedTol && rtol > 0 )
+		_tol = rtol/100;
+}
+
+void PhiFunctions::Combination(const BaseMat<FP>* M, FP t, const Vec<FP>* const* u, long p, Vec<FP>& w) {
+	_M = M;
+	_scale = fabs(t);
+	_n = u[0]->Size();
+	_u.assign(u+1, u+p+1);
+	_w.resize(p);
+	_temp.Resize(_n);
+
+	// The columns of W are |t|^k u_k, scaled by 1/max |t|^k |u_k| and the
+	// last entry of e_p by the inverse, so that the augmented vector is
+	// balanced against the result
+	FP unorm = 0, power = 1;
+	for( long k = 1; k <= p; k++ ) {
+		power *= _scale;
+		_w[k-1] = power;
+		unorm = std::max(unorm, power*u[k]->Norm());
+	}
+	FP eta = unorm > 0 ? 1/unorm : 1;
+	for( long k = 0; k < p; k++ )
+		_w[k] *= eta;
+
+	Vec<FP> x(_n + p);
+	x.Zero();
+	for( long i = 0; i < _n; i++ )
+		x(i) = (*u[0])(i);
+	if( p > 0 )
+		x(_n+p-1) = 1/eta;
+
+	if( t != 0 ) {
+		FP sgn = t < 0 ? -1 : 1;
+		if( _leja )
+			Leja(sgn, x);
+		else
+			Krylov(sgn, x);
+	}
+
+	w.Resize(_n);
+	for( long i = 0; i < _n; i++ )
+		w(i) = x(i);
+}
+
+void PhiFunctions::Exp(const BaseMat<FP>* M, FP t, const Vec<FP>& v, Vec<FP>& w) {
+	const Vec<FP>* u[1] = { &v };
+	Combination(M, t, u, 0, w);
+}
+
+// phi_k(tM) v is the combination with u_k = v/t^k and the others zero
+void PhiFunctions::Phi(const BaseMat<FP>* M, FP t, long k, const Vec<FP>& v, Vec<FP>& w) {
+	if( t == 0 ) {
+		FP factorial = 1;
+		for( long i = 2; i <= k; i++ )
+			factorial *= i;
+		w = v/factorial;
+		return;
+	}
+
+	Vec<FP> zero(v.Size()), scaled(v/pow(t, FP(k)));
+	zero.Zero();
+	std::vector<const Vec<FP>*> u(k+1, &zero);
+	u[k] = &scaled;
+	Combination(M, t, &u[0], k, w);
+}
+
+void PhiFunctions::GetStats(Hash<ParamValue>& params) const {
+	params["phi matvecs"].SetLong(_statMatvecs);
+	params["phi substeps"].SetLong(_statSubsteps);
+	params["phi rejections"].SetLong(_statRejections);
+}
+
+// Diagonal (10,10) Pade approximant after scaling to an infinity norm of at
+// most 1/2, then squaring back
+void PhiFunctions::DenseExp(const Mat<FP>& a, Mat<FP>& e) {
+	long n = a.M();
+	FP norm = 0;
+	for( long i = 0; i < n; i++ ) {
+		FP sum = 0;
+		for( long j = 0; j < n; j++ )
+			sum += fabs(a(i,j));
+		norm = std::max(norm, sum);
+	}
+
+	long squarings = 0;
+	FP scale = 1;
+	while( norm*scale > FP(0.5) ) {
+		scale /= 2;
+		squarings++;
+	}
+	Mat<FP> x(a*scale);
+
+	const long q = 10;
+	Mat<FP> num(Mat<FP>::Eye(n)), den(Mat<FP>::Eye(n)), power(Mat<FP>::Eye(n));
+	FP coef = 1;
+	for( long k = 1; k <= q; k++ ) {
+		coef *= FP(q-k+1)/(k*(2*q-k+1));
+		power = power*x;
+		num += power*coef;
+		den += power*(k % 2 ? -coef : coef);
+	}
+
+	den.Factor();
+	e = Mat<FP>(n, n);
+	Vec<FP> col(n), sol(n);
+	for( long j = 0; j < n; j++ ) {
+		for( long i = 0; i < n; i++ )
+			col(i) = num(i,j);
+		den.Solve(col, sol);
+		for( long i = 0; i < n; i++ )
+			e(i,j) = sol(i);
+	}
+
+	for( long s = 0; s < squarings; s++ )
+		e = e*e;
+}
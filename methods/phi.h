@@ -0,0 +1,77 @@
+#ifndef PHI_H
+#define PHI_H
+
+#include <core/common.h>
+#include <core/hash.h>
+#include <core/paramvalue.h>
+#include <core/mat.h>
+
+#include <vector>
+
+// exp(tM)v and phi_k(tM)v for any BaseMat M, where phi_0 = exp and
+// phi_k+1(z) = (phi_k(z) - 1/k!)/z. As in phipm, the combination
+//
+//	w = sum_k t^k phi_k(tM) u_k,	k = 0..p
+//
+// is the top of exp(A) [u_0; e_p] for the augmented operator A = [tM W; 0 J],
+// where W holds t^p u_p..t u_1 and J shifts up by one, so every phi function
+// comes from one exponential that only needs products with M. For t < 0 it
+// is exp(-A) with |t| in A instead.
+//
+// The exponential is taken in substeps, either by Arnoldi (-phi\ method krylov)
+// with the substep controlled by Saad's error estimate as in Expokit, or by
+// Newton interpolation at real Leja points (-phi\ method leja) on [-rho, 0],
+// with rho the spectral radius of M from the power method. Either stops adding
+// Krylov vectors or interpolation points once the estimated error is below
+// -phi\ tol relative to the result. It defaults to rtol/100 under a step
+// control solver, and close to the machine precision under fixed steps.
+class PhiFunctions {
+protected:
+	bool _leja;
+	FP _tol;
+	bool _fixedTol;
+	long _maxDim;
+	long _maxPoints;
+
+	// The augmented operator of the current evaluation
+	const BaseMat<FP>* _M;
+	FP _scale;
+	std::vector<const Vec<FP>*> _u;
+	std::vector<FP> _w;
+	long _n;
+
+	std::vector<Vec<FP> > _V;
+	Vec<FP> _temp;
+
+	// Leja points on [-2, 2] and the power method's last vector
+	std::vector<FP> _points;
+	Vec<FP> _power;
+
+	long _statMatvecs;
+	long _statSubsteps;
+	long _statRejections;
+
+	void Apply(const Vec<FP>& x, Vec<FP>& y);
+	void Krylov(FP t, Vec<FP>& w);
+	void Leja(FP t, Vec<FP>& w);
+	FP SpectralRadius();
+
+public:
+	PhiFunctions(Hash<ParamValue>& params);
+
+	// The relative tolerance of the step control solver, unless -phi\ tol
+	// was given
+	void SetTolerance(FP rtol);
+
+	// w may be any of the inputs
+	void Combination(const BaseMat<FP>* M, FP t, const Vec<FP>* const* u, long p, Vec<FP>& w);
+	void Exp(const BaseMat<FP>* M, FP t, const Vec<FP>& v, Vec<FP>& w);
+	void Phi(const BaseMat<FP>* M, FP t, long k, const Vec<FP>& v, Vec<FP>& w);
+
+	void GetStats(Hash<ParamValue>& params) const;
+
+	// exp(a) of a small dense matrix by scaling and squaring a Pade approximant
+	static void DenseExp(const Mat<FP>& a, Mat<FP>& e);
+};
+
+#endif
@@ -9,7 +9,54 @@ void RKMethod::FillC() {
 			_c(i) += _a(i,j);
 }
 
+static bool SamePoint(FP t, const Vec<FP>& y, FP tn, const Vec<FP>& yn) {
+	if( tn != t || yn.Size() != y.Size() )
+		return false;
+
+	for( long i = 0; i < yn.Size(); i++ )
+		if( yn[i] != y[i] )
+			return false;
+	return true;
+}
+
+// Leaves f(tn,yn) in _k[0] and returns true when it is already known
+bool RKMethod::ReuseFirstStage(FP tn, const Vec<FP>& yn) {
+	if( _fsal && _fsalValid && SamePoint(_fsalT, _fsalY, tn, yn) ) {
+		_k[0] = _k[_m-1];
+		_fsalReuses++;
+		return true;
+	}
+
+	if( _firstValid && SamePoint(_firstT, _firstY, tn, yn) ) {
+		_retryReuses++;
+		return true;
+	}
+	return false;
+}
+
+void RKMethod::StoreFirstStage(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+	// The first stage only depends on dt through its node
+	_firstValid = _c(0) == 0;
+	_firstT = tn;
+	_firstY = yn;
+
+	if( _fsal ) {
+		_fsalT = tn + dt;
+		_fsalY = ynew;
+		_fsalValid = true;
+	}
+}
+
 RKMethod::RKMethod(Hash<ParamValue>& params, BaseIVP* ivp, long m) : BaseMethod(params, ivp), _a(m,m), _b(m), _baux(m), _c(m), _m(m) {
+	_fsal = false;
+	_fsalValid = false;
+	_fsalT = 0;
+	_firstValid = false;
+	_firstT = 0;
+	_rhsEvals = 0;
+	_fsalReuses = 0;
+	_retryReuses = 0;
+
 	_k = new Vec<FP>[m];
 	_a.Zero();
 	_b.Zero();
@@ -30,10 +77,19 @@ const Vec<FP>& RKMethod::GetB() const {
 	return _b;
 }
 
+const Vec<FP>& RKMethod::GetBAux() const {
+	return _baux;
+}
+
 const Vec<FP>& RKMethod::GetC() const {
 	return _c;
 }
 
+void RKMethod::Restart() {
+	_fsalValid = false;
+	_firstValid = false;
+}
+
 FP RKMethod::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
 	Vec<FP> aux(yn.Size());
 	aux.Zero();
@@ -57,7 +113,13 @@ ERK::ERK(Hash<ParamValue>& params, BaseIVP* ivp, long m) : RKMethod(params, ivp,
 void ERK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	ynew.Zero();
 
-	for( long i = 0; i < _m; i++ ) {
+	long first = 0;
+	if( ReuseFirstStage(tn, yn) ) {
+		ynew.AddScaled(_b(0), _k[0]);
+		first = 1;
+	}
+
+	for( long i = first; i < _m; i++ ) {
 		Vec<FP> k(yn.Size());
 		k.Zero();
 		
@@ -66,26 +128,42 @@ void ERK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 
 		(*_ivp)(tn + dt*_c(i), yn + dt*k, _k[i]);
 		ynew.AddScaled(_b(i), _k[i]);
+		_rhsEvals++;
 	}
 	
 	ynew *= dt;
 	ynew += yn;
+	StoreFirstStage(tn, dt, yn, ynew);
+}
+
+// The first stage is f(tn,yn), and for FSAL tableaux the last one is
+// f(tn+dt,ynew), so the Hermite fallback costs at most one evaluation.
+void ERK::DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew) {
+	HermiteStep(tn, dt, yn, ynew, &_k[0], _fsal ? &_k[_m-1] : 0);
+}
+
+void ERK::GetStats(Hash<ParamValue>& params) const {
+	RKMethod::GetStats(params);
+	params["rhs evaluations"].SetLong(_rhsEvals);
+	params["fsal reuses"].SetLong(_fsalReuses);
+	params["retry reuses"].SetLong(_retryReuses);
 }
 
 // -----------------------------------------------------------------------------------
 
-DIRK::DIRK(Hash<ParamValue>& params, BaseIVP* ivp, long m) : RKMethod(params, ivp, m) {
+DIRK::DIRK(Hash<ParamValue>& params, BaseIVP* ivp, long m) : RKMethod(params, ivp, m), _newton(params, 20) {
 }
 
 void DIRK::NewtonSolve(const FP tn, const FP dt, const long s, const Vec<FP>& yn, BaseMat<FP>* mat,
 					   Vec<FP>& k, unsigned short split) {
-	FP norm;	
 	FP argt = tn + dt*_c(s);
 
 	Vec<FP> f(yn.Size());
 	Vec<FP> argy(yn.Size());
 
-	for( long i = 0; i < 20; i++ ) {
+	// The stage is yn + dt a_ss k, so increments of k count dt a_ss times
+	_newton.Start(yn, _solverATol, _solverRTol);
+	for( ;; ) {
 		argy = yn;
 		argy.AddScaled(dt*_a(s,s),k);
 		(*_ivp)(argt, argy, f, split);
@@ -94,18 +172,16 @@ void DIRK::NewtonSolve(const FP tn, const FP dt, const long s, const Vec<FP>& yn
 		mat->Solve(f, argy);
 		k += argy;
 
-		norm = f.InfNorm();
-		
-		if( norm > _newtonFail )
-			break;
-		
-		if( norm < _newtonTol || _ivp->JacobianSplitting() ) {
+		switch( _newton.Check(argy, dt*_a(s,s), _ivp->JacobianSplitting()) ) {
+		case NewtonControl::CONVERGED:
 			return;
+		case NewtonControl::FAILED:
+			_accept = false;
+			return;
+		default:
+			break;
 		}
 	}
-
-	// Method did not reach tolerence, so reject
-	_accept = false;	
 }
 
 void DIRK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
@@ -158,6 +234,11 @@ void DIRK::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	_ivp->FreezeJacobian(false);
 }
 
+void DIRK::GetStats(Hash<ParamValue>& params) const {
+	RKMethod::GetStats(params);
+	_newton.GetStats(params);
+}
+
 // -----------------------------------------------------------------------------------
 
 void IMEX::FillC2() {
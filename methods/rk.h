@@ -7,6 +7,7 @@
 #include <core/vec.h>
 #include <core/mat.h>
 #include <methods/basemethod.h>
+#include <methods/newton.h>
 
 class RKMethod : public BaseMethod {
 protected:
@@ -17,8 +18,29 @@ protected:
 	Vec<FP>* _k;
 	
 	long _m;
+
+	// The first stage of an explicit step is f(_firstT, _firstY), and is kept
+	// for the retry after a rejection, which starts from the same point. First
+	// same as last: for FSAL tableaux the final stage of a step is
+	// f(_fsalT, _fsalY) and replaces the first stage of the next step when
+	// that step starts from exactly this point. Any other starting point, such
+	// as a state changed by the solver, falls back to evaluating the first
+	// stage.
+	bool _fsal;
+	bool _fsalValid;
+	FP _fsalT;
+	Vec<FP> _fsalY;
+	bool _firstValid;
+	FP _firstT;
+	Vec<FP> _firstY;
+
+	long _rhsEvals;
+	long _fsalReuses;
+	long _retryReuses;
 	
 	void FillC();
+	bool ReuseFirstStage(FP tn, const Vec<FP>& yn);
+	void StoreFirstStage(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew);
 	
 public:
 	RKMethod(Hash<ParamValue>& params, BaseIVP* ivp, long m);
@@ -26,8 +48,10 @@ public:
 
 	const Mat<FP>& GetA() const;
 	const Vec<FP>& GetB() const;
+	const Vec<FP>& GetBAux() const;
 	const Vec<FP>& GetC() const;
 
+	virtual void Restart();
 	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
 };
 
@@ -36,10 +60,14 @@ public:
 	ERK(Hash<ParamValue>& params, BaseIVP* ivp, long m);
 	
 	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual void DenseStep(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew);
+	virtual void GetStats(Hash<ParamValue>& params) const;
 };
 
 class DIRK : public RKMethod {
 protected:
+	NewtonControl _newton;
+
 	void NewtonSolve(const FP tn, const FP dt, const long s, const Vec<FP>& yn, BaseMat<FP>* mat,
 					 Vec<FP>& k, unsigned short split = 0);
 	
@@ -47,6 +75,7 @@ public:
 	DIRK(Hash<ParamValue>& params, BaseIVP* ivp, long m);
 	
 	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual void GetStats(Hash<ParamValue>& params) const;
 };
 
 class IMEX : public DIRK {
@@ -2,25 +2,25 @@
 #include <solvers/basesolver.h>
 #include <methods/rkc.h>
 
-FP RKC2::EstimateJacobianSpectralRadius(FP t, const Vec<FP>& y, Vec<FP>& guess, const Vec<FP>& yp, long split) {	
+FP RKC2::EstimateJacobianSpectralRadius(FP t, const Vec<FP>& y, Vec<FP>& guess, const Vec<FP>& yp, long split, long iters) {	
 	if( !guess.Size() )
 		guess = yp;
 	
 	FP yNorm = y.Norm();
-	FP ypNorm = yp.Norm();
+	FP guessNorm = guess.Norm();
 	FP eps = std::numeric_limits<FP>().epsilon();
 	FP sqrtEps = sqrt(eps);
 
 	FP dyNorm;
-	if( yNorm != 0 && ypNorm != 0 ) {
+	if( yNorm != 0 && guessNorm != 0 ) {
 		dyNorm = yNorm*sqrtEps;
-		guess = y + guess*dyNorm/ypNorm;
+		guess = y + guess*dyNorm/guessNorm;
 	} else if( yNorm != 0 ) {
 		dyNorm = yNorm*sqrtEps;
 		guess = y + y*sqrtEps;
-	} else if( ypNorm != 0 ) {
+	} else if( guessNorm != 0 ) {
 		dyNorm = eps;
-		guess = guess*dyNorm/ypNorm;
+		guess = guess*dyNorm/guessNorm;
 	} else {
 		dyNorm = eps;
 		guess = Vec<FP>::Ones(guess.Size())*dyNorm;
@@ -30,18 +30,17 @@ FP RKC2::EstimateJacobianSpectralRadius(FP t, const Vec<FP>& y, Vec<FP>& guess,
 	FP sigma = 0;
 	FP spRad = 0;
 	
-	for( long i = 0; i < 50; i++ ) {
+	for( long i = 0; i < iters; i++ ) {
 		Vec<FP> fv(y.Size());
 		(*_ivp)(t, guess, fv, split);
+		_statSpRadEvals++;
 				
 		FP fvypNorm = (fv-yp).Norm();
 		FP sigma1 = sigma;
 		sigma = fvypNorm / dyNorm;
 		spRad = 1.2*sigma;
-		if( i > 1 && fabs(sigma - sigma1) < sigma*0.01 ) {
-			guess -= y;
+		if( i > 1 && fabs(sigma - sigma1) < sigma*0.01 )
 			break;
-		}
 
 		if( fvypNorm != 0 )
 			guess = y + (fv-yp) * dyNorm / fvypNorm;
@@ -51,9 +50,66 @@ FP RKC2::EstimateJacobianSpectralRadius(FP t, const Vec<FP>& y, Vec<FP>& guess,
 		}
 	}
 
+	// Keep the direction as the next starting guess
+	guess -= y;
 	return spRad;
 }
 
+// The largest absolute row sum of the Jacobian of the split
+FP RKC2::GershgorinBound(FP t, const Vec<FP>& y, long split) {
+	FP bound = 0;
+	if( _sparse ) {
+		const CSRMat<FP>& jac = *(const CSRMat<FP>*)_ivp->JacSparse(t, y, split);
+		for( long i = 0; i < jac.M(); i++ ) {
+			FP sum = 0;
+			for( long j = jac.RowPtr()[i]; j < jac.RowPtr()[i+1]; j++ )
+				sum += fabs(jac[j]);
+			bound = std::max(bound, sum);
+		}
+	} else {
+		const Mat<FP>& jac = *(const Mat<FP>*)_ivp->Jac(t, y, split);
+		for( long i = 0; i < jac.M(); i++ ) {
+			FP sum = 0;
+			for( long j = 0; j < jac.N(); j++ )
+				sum += fabs(jac(i,j));
+			bound = std::max(bound, sum);
+		}
+	}
+	return bound;
+}
+
+// A step tried again from the same time was rejected, so its estimates are
+// made again unless they were made for it
+void RKC2::CheckRejection(FP tn) {
+	if( _statSteps && tn == _lastT ) {
+		for( long i = 0; i < 3; i++ )
+			if( _spRadAge[i] > 1 )
+				_spRadAge[i] = 0;
+	}
+	_lastT = tn;
+}
+
+FP RKC2::SpectralRadius(FP t, const Vec<FP>& y, const Vec<FP>& yp, long split) {
+	if( _spRadType == SR_BOUND ) {
+		FP bound = _ivp->SpectralRadiusBound(split);
+		if( bound > 0 )
+			return bound;
+	}
+
+	if( _spRadAge[split] && _spRadAge[split] < _spRadReuse ) {
+		_spRadAge[split]++;
+		return _spRad[split];
+	}
+
+	if( _spRadType == SR_GERSHGORIN )
+		_spRad[split] = GershgorinBound(t, y, split);
+	else
+		_spRad[split] = EstimateJacobianSpectralRadius(t, y, _spRadGuess[split], yp, split, _spRadGuess[split].Size() ? _warmPowerIters : _powerIters);
+	_spRadAge[split] = 1;
+	_statSpRadEstimates++;
+	return _spRad[split];
+}
+
 RKC2::RKC2(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp) {
 	if( params.Get("eta") )
 		_eta = params["eta"].GetFP();
@@ -65,59 +121,70 @@ RKC2::RKC2(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp) {
 	else
 		_maxStages = 100;
 
+	std::string type(GetDefaultString(params, "spectral radius", "power"));
+	if( type == "power" )
+		_spRadType = SR_POWER;
+	else if( type == "gershgorin" )
+		_spRadType = SR_GERSHGORIN;
+	else if( type == "bound" )
+		_spRadType = SR_BOUND;
+	else
+		throw Exception() << "Unknown spectral radius estimate " << type << ".";
+
+	_spRadReuse = GetDefaultLong(params, "spectral radius reuse", 25);
+	_powerIters = GetDefaultLong(params, "power iterations", 50);
+	_warmPowerIters = GetDefaultLong(params, "warm power iterations", 10);
+	_lastT = 0;
+	for( long i = 0; i < 3; i++ ) {
+		_spRad[i] = 0;
+		_spRadAge[i] = 0;
+	}
+
 	_statMaxStages = 2;
 	_statMinStages = _maxStages;
 	_statSteps = 0;
 	_statStages = 0;
+	_statSpRadEstimates = 0;
+	_statSpRadEvals = 0;
 
-	if( ivp )
+	_tables.resize(_maxStages + 1);
+	for( size_t i = 0; i < _tables.size(); i++ )
+		_tables[i].computed = false;
+
+	if( ivp ) {
 		_F0.Resize(ivp->Size());
+		_Fj.Resize(ivp->Size());
+		_K[0].Resize(ivp->Size());
+		_K[1].Resize(ivp->Size());
+	}
 }
 
-void RKC2::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
-	// Estimate spectral radius of the Jacobian
-	(*_ivp)(tn, yn, _F0);
-	FP spRad = EstimateJacobianSpectralRadius(tn, yn, _spRadGuess, _F0);
-
-	// Calculate the number of stages
-	_m = 1 + (long)sqrt(dt*spRad/0.65 + 1);
-
-	if( _m > _maxStages ) {
-		_m = _maxStages;
-		dt = 0.65*(_m*_m-1)/spRad;
+const RKC2::StageTable& RKC2::Table(long m) {
+	StageTable& table = _tables[m];
+	if( !table.computed ) {
+		ComputeTable(m, table);
+		table.computed = true;
 	}
-	
-	if( _m < _statMinStages )
-		_statMinStages = _m;
-	if( _m > _statMaxStages )
-		_statMaxStages = _m;
-	_statStages += _m;
-	_statSteps++;
-
+	return table;
 }
 
-void RKC2::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
-	const Vec<FP>& K0 = yn;
-	Vec<FP>& Km = ynew;
-
-	Vec<FP> Kjm1(yn.Size());
-	Vec<FP> Kjm2(yn.Size());
-	Vec<FP> Fjm1(yn.Size());
+void RKC2::ComputeTable(long m, StageTable& table) const {
+	table.k0.assign(m+1, 0);
+	table.mu.assign(m+1, 0);
+	table.nu.assign(m+1, 0);
+	table.kappa.assign(m+1, 0);
+	table.gamma.assign(m+1, 0);
+	table.c.assign(m+1, 0);
 
-	// Begin steps
-	FP w0 = 1 + _eta/(_m*_m);
-	FP w1 = Cheb1p(_m, w0) / Cheb1pp(_m, w0);
+	FP w0 = 1 + _eta/(m*m);
+	FP w1 = Cheb1p(m, w0) / Cheb1pp(m, w0);
 
-	// Start setting up constants
 	FP bj = Cheb1ppRecursive(2, 2*w0*w0-1, 2*w0, w0) / sqr(Cheb1pRecursive(2,2*w0));
 	FP bjm1 = bj;
 	FP bjm2 = bj;
+	table.kappa[1] = bjm1*w1;
+	table.c[1] = w1*bjm1;
 
-	// Calculate K1
-	FP kj   = bjm1*w1;
-	Kjm1 = K0;
-	Km   = K0 + kj*dt*_F0;
-	
 	// Set up Chebyshev polynomials
 	FP Tjm1 = 1;    // T0(w0) = 1
 	FP Tj   = w0;   // T1(w0) = w0
@@ -125,8 +192,7 @@ void RKC2::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	FP Uj   = 2*w0; // U1(w0) = w0
 	FP Tjm2, Ujm2;
 
-	for( long j = 2; j < _m+1; j++ ) {
-		// Update chebyshev polynomials
+	for( long j = 2; j < m+1; j++ ) {
 		Tjm2 = Tjm1;
 		Tjm1 = Tj;
 		Tj = 2*w0*Tjm1-Tjm2;
@@ -134,33 +200,74 @@ void RKC2::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 		Ujm1 = Uj;
 		Uj = 2*w0*Ujm1-Ujm2;
 
-		// Update past stages
-		Kjm2 = Kjm1;
-		Kjm1 = Km;
-
-		// Set up constants
 		bjm2 = bjm1;
 		bjm1 = bj;
 		bj = Cheb1ppRecursive(j,Tj,Ujm1,w0) / sqr(Cheb1pRecursive(j,Ujm1));
 		FP ajm1 = 1 - bjm1*Tjm1;
 		FP muj = 2*bj*w0/bjm1;
 		FP nuj = -bj/bjm2;
-		kj = 2*bj*w1/bjm1;
+		FP kj = 2*bj*w1/bjm1;
 
-		// Update function evaluations
-		FP cjm1;
-		if( j == 2 )
-			cjm1 = w1*bjm1;
-		else
-			cjm1 = w1*Cheb1ppRecursive(j-1,Tjm1,Ujm2,w0)/Cheb1pRecursive(j-1,Ujm2);
-		(*_ivp)(tn+cjm1*dt, Kjm1, Fjm1);
-		
-		// Update stage
-		Km = (1-muj-nuj)*K0;
-		Km.AddScaled(muj,Kjm1);
-		Km.AddScaled(nuj,Kjm2);
-		Km.AddScaled(kj*dt,Fjm1);
-		Km.AddScaled(-ajm1*kj*dt,_F0);
+		table.k0[j] = 1-muj-nuj;
+		table.mu[j] = muj;
+		table.nu[j] = nuj;
+		table.kappa[j] = kj;
+		table.gamma[j] = -ajm1*kj;
+		if( j > 2 )
+			table.c[j-1] = w1*Cheb1ppRecursive(j-1,Tjm1,Ujm2,w0)/Cheb1pRecursive(j-1,Ujm2);
+	}
+}
+
+void RKC2::StageBuffers(long m, Vec<FP>& last, Vec<FP>** K) {
+	K[m % 3] = &last;
+	K[(m+1) % 3] = &_K[0];
+	K[(m+2) % 3] = &_K[1];
+}
+
+void RKC2::ChebyshevStage(const StageTable& table, long j, FP dt, const Vec<FP>& K0, const Vec<FP>& Kjm1, const Vec<FP>& Kjm2, const Vec<FP>& F0, Vec<FP>& Kj) const {
+	FP a[5] = { table.k0[j], table.mu[j], table.nu[j], table.kappa[j]*dt, table.gamma[j]*dt };
+	const Vec<FP>* v[5] = { &K0, &Kjm1, &Kjm2, &_Fj, &F0 };
+	Kj.Combine<5>(a, v);
+}
+
+void RKC2::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
+	// Estimate spectral radius of the Jacobian
+	CheckRejection(tn);
+	(*_ivp)(tn, yn, _F0);
+	FP spRad = SpectralRadius(tn, yn, _F0);
+
+	// Calculate the number of stages
+	_m = 1 + (long)sqrt(dt*spRad/0.65 + 1);
+
+	if( _m > _maxStages ) {
+		_m = _maxStages;
+		dt = 0.65*(_m*_m-1)/spRad;
+	}
+	
+	if( _m < _statMinStages )
+		_statMinStages = _m;
+	if( _m > _statMaxStages )
+		_statMaxStages = _m;
+	_statStages += _m;
+	_statSteps++;
+
+}
+
+void RKC2::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	const StageTable& table = Table(_m);
+	Vec<FP>* K[3];
+	StageBuffers(_m, ynew, K);
+
+	// Calculate K1
+	FP a[2] = { 1, table.kappa[1]*dt };
+	const Vec<FP>* v[2] = { &yn, &_F0 };
+	K[1]->Combine<2>(a, v);
+
+	for( long j = 2; j < _m+1; j++ ) {
+		const Vec<FP>& Kjm1 = *K[(j-1) % 3];
+		const Vec<FP>& Kjm2 = j == 2 ? yn : *K[(j-2) % 3];
+		(*_ivp)(tn+table.c[j-1]*dt, Kjm1, _Fj);
+		ChebyshevStage(table, j, dt, yn, Kjm1, Kjm2, _F0, *K[j % 3]);
 	}
 }
 
@@ -181,6 +288,8 @@ void RKC2::GetStats(Hash<ParamValue>& params) const {
 	params["max stages"].SetFP(_statMaxStages);
 	params["min stages"].SetFP(_statMinStages);
 	params["avg stages"].SetFP(FP(_statStages)/_statSteps);
+	params["spectral radius estimates"].SetLong(_statSpRadEstimates);
+	params["spectral radius evaluations"].SetLong(_statSpRadEvals);
 }
 
 const char* RKC2::GetName() const {
@@ -237,18 +346,18 @@ FP RKC2::Cheb1ppRecursive(long n, FP Tj, FP Ujm1, FP x) {
 RKC1::RKC1(Hash<ParamValue>& params, BaseIVP* ivp) : RKC2(params, ivp) {
 }
 
-void RKC1::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
-	const Vec<FP>& K0 = yn;
-	Vec<FP>& Km = ynew;
+void RKC1::ComputeTable(long m, StageTable& table) const {
+	table.k0.assign(m+1, 0);
+	table.mu.assign(m+1, 0);
+	table.nu.assign(m+1, 0);
+	table.kappa.assign(m+1, 0);
+	table.gamma.assign(m+1, 0);
+	table.c.assign(m+1, 0);
 
-	Vec<FP> Kjm1(yn.Size());
-	Vec<FP> Kjm2(yn.Size());
-	Vec<FP> Fjm1(yn.Size());
+	FP w0 = 1 + _eta/(m*m);
+	FP w1 = Cheb1(m, w0) / Cheb1p(m, w0);
+	table.kappa[1] = w1/w0;
 
-	// Begin steps
-	FP w0 = 1 + _eta/(_m*_m);
-	FP w1 = Cheb1(_m, w0) / Cheb1p(_m, w0);
-	
 	// Set up Chebyshev polynomials
 	FP Tjm1 = 1;    // T0(w0) = 1
 	FP Tj   = w0;   // T1(w0) = w0
@@ -256,12 +365,7 @@ void RKC1::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	FP Uj   = 2*w0; // U1(w0) = w0
 	FP Tjm2, Ujm2;
 
-	// Calculate K1
-	Kjm1 = K0;
-	Km   = K0 + w1/w0*dt*_F0;
-	
-	for( long j = 2; j < _m+1; j++ ) {
-		// Update chebyshev polynomials
+	for( long j = 2; j < m+1; j++ ) {
 		Tjm2 = Tjm1;
 		Tjm1 = Tj;
 		Tj = 2*w0*Tjm1-Tjm2;
@@ -269,27 +373,35 @@ void RKC1::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 		Ujm1 = Uj;
 		Uj = 2*w0*Ujm1-Ujm2;
 
-		// Update past stages
-		Kjm2 = Kjm1;
-		Kjm1 = Km;
-
-		// Set up constants
 		FP bjm2 = 1/Tjm2;
 		FP bjm1 = 1/Tjm1;
 		FP bj   = 1/Tj;
-		FP muj = 2*bj*w0/bjm1;
-		FP nuj = -bj/bjm2;
-		FP kj = 2*bj*w1/bjm1;
+		table.mu[j] = 2*bj*w0/bjm1;
+		table.nu[j] = -bj/bjm2;
+		table.kappa[j] = 2*bj*w1/bjm1;
+		table.c[j-1] = w1*Cheb1pRecursive(j-1,Ujm2)/Tjm1;
+	}
+}
 
-		// Update function evaluations
-		FP cjm1 = w1*Cheb1pRecursive(j-1,Ujm2)/Tjm1;
-		(*_ivp)(tn+cjm1*dt, Kjm1, Fjm1);
+// The first order stages have no K_0 or F_0 terms
+void RKC1::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	const StageTable& table = Table(_m);
+	Vec<FP>* K[3];
+	StageBuffers(_m, ynew, K);
 
-		// Update stage
-		Km.Zero();
-		Km.AddScaled(muj,Kjm1);
-		Km.AddScaled(nuj,Kjm2);
-		Km.AddScaled(kj*dt,Fjm1);
+	// Calculate K1
+	FP a[2] = { 1, table.kappa[1]*dt };
+	const Vec<FP>* v[2] = { &yn, &_F0 };
+	K[1]->Combine<2>(a, v);
+
+	for( long j = 2; j < _m+1; j++ ) {
+		const Vec<FP>& Kjm1 = *K[(j-1) % 3];
+		const Vec<FP>& Kjm2 = j == 2 ? yn : *K[(j-2) % 3];
+		(*_ivp)(tn+table.c[j-1]*dt, Kjm1, _Fj);
+
+		FP b[3] = { table.mu[j], table.nu[j], table.kappa[j]*dt };
+		const Vec<FP>* u[3] = { &Kjm1, &Kjm2, &_Fj };
+		K[j % 3]->Combine<3>(b, u);
 	}
 }
 
@@ -319,11 +431,12 @@ void PRKC::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
 	}
 
 	// Estimate spectral radius of the Jacobian
+	CheckRejection(tn);
 	(*_ivp)(tn, yn, _F0, 1);
-	FP spRadF = EstimateJacobianSpectralRadius(tn, yn, _spRadGuess, _F0, 1);
+	FP spRadF = SpectralRadius(tn, yn, _F0, 1);
 
 	(*_ivp)(tn, yn, _Gm1, 2);	
-	FP spRadG = _ivp->JacobianSplitting() ? 0 : EstimateJacobianSpectralRadius(tn, yn, _spRadGuessG, _Gm1, 2);
+	FP spRadG = _ivp->JacobianSplitting() ? 0 : SpectralRadius(tn, yn, _Gm1, 2);
 	if( spRadG*dt > 1.7 ) dt = 1.7/spRadG;
 
 	// Calculate the number of stages
@@ -352,73 +465,30 @@ void PRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 
 	// Calculate K0 right away
 	FP alpha0 = 1./2;
-	_K0 = yn + alpha0*dt*_Gm1;
-
-	// Memory to store function evaluations and stages
-	Vec<FP> Kjm1(yn.Size());
-	Vec<FP> Kjm2(yn.Size());
-	Vec<FP> Fjm1(yn.Size());
-
-	// Begin steps
-	FP w0 = 1 + _eta/(_m*_m);
-	FP w1 = Cheb1p(_m, w0) / Cheb1pp(_m, w0);
-
-	// Start setting up constants
-	FP bj = Cheb1ppRecursive(2, 2*w0*w0-1, 2*w0, w0) / sqr(Cheb1pRecursive(2,2*w0));
-	FP bjm1 = bj;
-	FP bjm2 = bj;
+	FP a0[2] = { 1, alpha0*dt };
+	const Vec<FP>* v0[2] = { &yn, &_Gm1 };
+	_K0.Combine<2>(a0, v0);
 
 	// Recalculate F0 from prestep because it isn't the same for PRKC
 	(*_ivp)(tn, _K0, _F0, 1);
 
-	// Calculate K1
-	FP kj   = bjm1*w1;
-	Kjm1 = _K0;
-	_Kf  = _K0 + kj*dt*_F0;
+	const StageTable& table = Table(_m);
+	Vec<FP>* K[3];
+	StageBuffers(_m, _Kf, K);
 
-	// Set up Chebyshev polynomials
-	FP Tjm1 = 1;    // T0(w0) = 1
-	FP Tj   = w0;   // T1(w0) = w0
-	FP Ujm1 = 1;    // U0(w0) = 1
-	FP Uj   = 2*w0; // U1(w0) = w0
-	FP Tjm2, Ujm2;
+	// Calculate K1
+	FP a[2] = { 1, table.kappa[1]*dt };
+	const Vec<FP>* v[2] = { &_K0, &_F0 };
+	K[1]->Combine<2>(a, v);
 
 	for( long j = 2; j < _m+1; j++ ) {
-		// update chebyshev polynomials
-		Tjm2 = Tjm1;
-		Tjm1 = Tj;
-		Tj = 2*w0*Tjm1-Tjm2;
-		Ujm2 = Ujm1;
-		Ujm1 = Uj;
-		Uj = 2*w0*Ujm1-Ujm2;
-		
-		// Update past stages
-		Kjm2 = Kjm1;
-		Kjm1 = _Kf;
-		
-		// Set up constants
-		bjm2 = bjm1;
-		bjm1 = bj;
-		bj = Cheb1ppRecursive(j,Tj,Ujm1,w0) / sqr(Cheb1pRecursive(j,Ujm1));
-		FP ajm1 = 1 - bjm1*Tjm1;
-		FP muj = 2*bj*w0/bjm1;
-		FP nuj = -bj/bjm2;
-		kj = 2*bj*w1/bjm1;
-
-		// Update function evaluations
-		if( j == 2 )
-			_cmm1 = w1*bjm1;
-		else
-			_cmm1 = w1*Cheb1ppRecursive(j-1,Tjm1,Ujm2,w0)/Cheb1pRecursive(j-1,Ujm2);
-		(*_ivp)(tn+_cmm1*dt, Kjm1, Fjm1, 1);
-	
-		// Update stage
-		_Kf = (1-muj-nuj)*_K0;
-		_Kf.AddScaled(muj,Kjm1);
-		_Kf.AddScaled(nuj,Kjm2);
-		_Kf.AddScaled(kj*dt,Fjm1);
-		_Kf.AddScaled(-ajm1*kj*dt,_F0);
+		const Vec<FP>& Kjm1 = *K[(j-1) % 3];
+		const Vec<FP>& Kjm2 = j == 2 ? _K0 : *K[(j-2) % 3];
+		(*_ivp)(tn+table.c[j-1]*dt, Kjm1, _Fj, 1);
+		ChebyshevStage(table, j, dt, _K0, Kjm1, Kjm2, _F0, *K[j % 3]);
 	}
+	_cmm1 = table.c[_m-1];
+	const Vec<FP>& Kjm1 = *K[(_m-1) % 3];
 
 	// mth stage
 	FP alpha1 = -1.5;
@@ -428,10 +498,9 @@ void PRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	(*_ivp)(tn+alpha0*dt, _K0, _G0, 2);
 	(*_ivp)(tn+alpha0*dt, Kjm1, _Gmm1, 2);
 	
-	_Km = _Kf;
-	_Km.AddScaled(alpha1*dt, _Gm1);
-	_Km.AddScaled(alpha2*dt, _G0);
-	_Km.AddScaled(alpha3*dt, _Gmm1);
+	FP am[4] = { 1, alpha1*dt, alpha2*dt, alpha3*dt };
+	const Vec<FP>* vm[4] = { &_Kf, &_Gm1, &_G0, &_Gmm1 };
+	_Km.Combine<4>(am, vm);
 	
 	// m+1th stage
 	FP alpha4 = -1./3;
@@ -440,11 +509,9 @@ void PRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	FP alpha7 = 1./6;
 	(*_ivp)(tn+dt, _Km, _Gm, 2);
 
-	ynew = _Kf;
-	ynew.AddScaled(alpha4*dt, _Gm1);
-	ynew.AddScaled(alpha5*dt, _G0);
-	ynew.AddScaled(alpha6*dt, _Gmm1);
-	ynew.AddScaled(alpha7*dt, _Gm);
+	FP an[5] = { 1, alpha4*dt, alpha5*dt, alpha6*dt, alpha7*dt };
+	const Vec<FP>* vn[5] = { &_Kf, &_Gm1, &_G0, &_Gmm1, &_Gm };
+	ynew.Combine<5>(an, vn);
 
 	if( _ivp->JacobianSplitting() )
 		_ivp->FreezeJacobian(false);
@@ -481,34 +548,53 @@ const char* PRKC::GetName() const {
 
 // ----------------------------------------------------------------------------
 
-IRKC::IRKC(Hash<ParamValue>& params, BaseIVP* ivp) : RKC2(params, ivp) {
+IRKC::IRKC(Hash<ParamValue>& params, BaseIVP* ivp) : RKC2(params, ivp), _newton(params, 20) {
+	_jac = 0;
+	_E = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+	_statFactorizations = 0;
+
+	if( ivp ) {
+		_G0.Resize(ivp->Size());
+		_G[0].Resize(ivp->Size());
+		_G[1].Resize(ivp->Size());
+		_stage.Resize(ivp->Size());
+		_dk.Resize(ivp->Size());
+	}
 }
 
-void IRKC::NewtonSolve(const Mat<FP>& LU, const Mat<FP>& P, const Vec<FP>& constant, FP t, FP dt, FP k1, Vec<FP>& k, Vec<FP>& Gj) {
-    Vec<FP> f(k.Size());
-    for( long i = 0; i < 20; i++ ) {
-        (*_ivp)(t, k, Gj, 2);
+IRKC::~IRKC() {
+	delete _E;
+}
+
+void IRKC::NewtonSolve(const Vec<FP>& constant, FP t, FP dt, FP k1, Vec<FP>& k, Vec<FP>& Gj) {
+	Vec<FP> f(k.Size());
+	_newton.Start(k, _solverATol, _solverRTol);
+	for( ;; ) {
+		(*_ivp)(t, k, Gj, 2);
 		f  = -k1*dt*Gj;
 		f -= constant;
-        f += k;
-        
-		k -= Mat<FP>::SolveLU(LU,P,f);
-
-        FP norm = f.InfNorm();
-        if( norm > _newtonFail )
-            break;
-        else if( norm < _newtonTol )
-            return;
-    }       
-
-    // Method did not reach tolerence, so reject
-    _accept = false;    
+		f += k;
+
+		_E->Solve(f, _dk);
+		k -= _dk;
+
+		switch( _newton.Check(_dk) ) {
+		case NewtonControl::CONVERGED:
+			return;
+		case NewtonControl::FAILED:
+			_accept = false;
+			return;
+		default:
+			break;
+		}
+	}
 }
 
 void IRKC::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
 	// Estimate spectral radius of the Jacobian
+	CheckRejection(tn);
 	(*_ivp)(tn, yn, _F0, 1);
-	FP spRad = EstimateJacobianSpectralRadius(tn, yn, _spRadGuess, _F0, 1);
+	FP spRad = SpectralRadius(tn, yn, _F0, 1);
 
 	// Calculate the number of stages
 	_m = 1 + (long)sqrt(dt*spRad/0.65 + 1);
@@ -527,23 +613,21 @@ void IRKC::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
 	_statSteps++;
 }
 
-void IRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
-	const Vec<FP>& K0 = yn;
-	Vec<FP>& Km = ynew;
-
-	Vec<FP> Kjm1(yn.Size());
-	Vec<FP> Kjm2(yn.Size());
-	Vec<FP> Fjm1(yn.Size());
-	Vec<FP> Gj(yn.Size());
-	Vec<FP> Gjm1(yn.Size());
-	Vec<FP> Gjm2(yn.Size());
-
-	// Begin steps
-	FP w0 = 1 + _eta/(_m*_m);
+void IRKC::ComputeTable(long m, StageTable& table) const {
+	table.k0.assign(m+1, 0);
+	table.mu.assign(m+1, 0);
+	table.nu.assign(m+1, 0);
+	table.kappa.assign(m+1, 0);
+	table.gamma.assign(m+1, 0);
+	table.c.assign(m+1, 0);
+	table.g0.assign(m+1, 0);
+	table.g2.assign(m+1, 0);
+
+	FP w0 = 1 + _eta/(m*m);
 	FP temp1 = w0*w0 - 1;
 	FP temp2 = sqrt(temp1);
-	FP arg = _m*log(w0 + temp2);
-	FP w1 = sinh(arg) * temp1 / (cosh(arg)*_m*temp2 - w0*sinh(arg)); 
+	FP arg = m*log(w0 + temp2);
+	FP w1 = sinh(arg) * temp1 / (cosh(arg)*m*temp2 - w0*sinh(arg)); 
 
 	// Start setting up constants
 	FP bj   = 1/w0;
@@ -554,23 +638,9 @@ void IRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	FP cjm2 = 0;
 	FP aj   = 0;
 	FP ajm1 = 0;
-	FP kj   = bj*w1;
-	_k1 = kj;
-
-	// Calculate Jacobian at t0
-	_jac = (Mat<FP>*)_ivp->Jac(tn, yn, 2);
-    Mat<FP> LU, P;
-    (Mat<FP>::Eye(yn.Size()) - (_k1*dt)**_jac).CalcLU(LU,P);
-
-	// Calculate FO and G0
-	Vec<FP> G0(yn.Size());
-	(*_ivp)(tn, yn, G0, 2);
-	Gjm1 = G0;
-
-	// Calculate K1
-	Kjm1 = K0;
-	Km   = K0; // Guess
-	NewtonSolve(LU, P, K0 + _k1*dt*_F0, tn + cj*dt, dt, _k1, Km, Gj);
+	FP k1   = bj*w1;
+	table.kappa[1] = k1;
+	table.c[1] = cj;
 
 	// Set up Chebyshev polynomials
 	FP Tjm1 = 1;    // T0(w0) = 1
@@ -579,8 +649,7 @@ void IRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 	FP Uj   = 2*w0; // U1(w0) = w0
 	FP Tjm2, Ujm2;
 
-	for( long j = 2; j < _m+1; j++ ) {
-		// Update chebyshev polynomials
+	for( long j = 2; j < m+1; j++ ) {
 		Tjm2 = Tjm1;
 		Tjm1 = Tj;
 		Tj = 2*w0*Tjm1-Tjm2;
@@ -588,41 +657,79 @@ void IRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
 		Ujm1 = Uj;
 		Uj = 2*w0*Ujm1-Ujm2;
 
-		// Update past stages and G evaluations
-		Kjm2 = Kjm1;
-		Kjm1 = Km;
-		Gjm2 = Gjm1;
-		Gjm1 = Gj;
-
-		// Set up constants
 		bjm2 = bjm1; bjm1 = bj;
 		bj = Cheb1ppRecursive(j,Tj,Ujm1,w0) / sqr(Cheb1pRecursive(j,Ujm1));
 		FP muj = 2*bj*w0/bjm1;
 		FP nuj = -bj/bjm2;
-		kj = 2*bj*w1/bjm1;
+		FP kj = 2*bj*w1/bjm1;
 		ajm1 = aj;
 		aj = 1 - bj*Tj;
 		cjm2 = cjm1; cjm1 = cj;
 		cj = muj*cjm1 + nuj*cjm2 + aj*(1+kj);
 
+		table.k0[j] = 1-muj-nuj;
+		table.mu[j] = muj;
+		table.nu[j] = nuj;
+		table.kappa[j] = kj;
+		table.gamma[j] = -ajm1*kj;
+		table.g0[j] = -(ajm1*kj+(1-muj-nuj)*k1);
+		table.g2[j] = -nuj*k1;
+		table.c[j] = cj;
+	}
+}
+
+void IRKC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	const StageTable& table = Table(_m);
+	_k1 = table.kappa[1];
+
+	Vec<FP>* K[3];
+	StageBuffers(_m, ynew, K);
+
+	// Calculate Jacobian at t0 and factor I - k1 dt J for every stage
+	long n = yn.Size();
+	if( _sparse ) {
+		_jac = _ivp->JacSparse(tn, yn, 2);
+		*(CSRMat<FP>*)_E = CSRMat<FP>::Eye(n) - (_k1*dt)**(const CSRMat<FP>*)_jac;
+	} else {
+		_jac = _ivp->Jac(tn, yn, 2);
+		*(Mat<FP>*)_E = Mat<FP>::Eye(n) - (_k1*dt)**(const Mat<FP>*)_jac;
+	}
+	_E->Factor();
+	_statFactorizations++;
+
+	// Calculate G0
+	(*_ivp)(tn, yn, _G0, 2);
+
+	// Calculate K1, starting Newton from K0. G_j only replaces G_j-2 once
+	// stage j is set up, so both share _G[j % 2].
+	FP a[2] = { 1, _k1*dt };
+	const Vec<FP>* v[2] = { &yn, &_F0 };
+	_stage.Combine<2>(a, v);
+	*K[1] = yn;
+	NewtonSolve(_stage, tn + table.c[1]*dt, dt, _k1, *K[1], _G[1]);
+
+	for( long j = 2; j < _m+1; j++ ) {
+		const Vec<FP>& Kjm1 = *K[(j-1) % 3];
+		const Vec<FP>& Kjm2 = j == 2 ? yn : *K[(j-2) % 3];
+		const Vec<FP>& Gjm2 = j == 2 ? _G0 : _G[j % 2];
+
 		// Update function evaluations
-		(*_ivp)(tn+cjm1*dt, Kjm1, Fjm1, 1);
+		(*_ivp)(tn+table.c[j-1]*dt, Kjm1, _Fj, 1);
+
 		// Update stage
-		Vec<FP> stage = (1-muj-nuj)*K0;
-		stage.AddScaled(muj,Kjm1);
-		stage.AddScaled(nuj,Kjm2);
-		stage.AddScaled(kj*dt,Fjm1);
-		stage.AddScaled(-ajm1*kj*dt,_F0);
-		stage.AddScaled(-(ajm1*kj+(1-muj-nuj)*_k1)*dt,G0);
-		stage.AddScaled(-nuj*_k1*dt,Gjm2);
-		NewtonSolve(LU, P, stage, tn + cj*dt, dt, _k1, Km, Gj);
+		FP b[7] = { table.k0[j], table.mu[j], table.nu[j], table.kappa[j]*dt, table.gamma[j]*dt, table.g0[j]*dt, table.g2[j]*dt };
+		const Vec<FP>* u[7] = { &yn, &Kjm1, &Kjm2, &_Fj, &_F0, &_G0, &Gjm2 };
+		_stage.Combine<7>(b, u);
+
+		// Start Newton from the previous stage
+		*K[j % 3] = Kjm1;
+		NewtonSolve(_stage, tn + table.c[j]*dt, dt, _k1, *K[j % 3], _G[j % 2]);
 	}
 }
 
+// The estimate is filtered by the stage matrix of the step. With the two
+// stages IRKC takes, k1 = 1 and that is I - dt J.
 FP IRKC::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
-	Mat<FP> LU, P;
-    (Mat<FP>::Eye(yn.Size()) - dt**_jac).CalcLU(LU,P);
-
 	Vec<FP> fn1(yn.Size()), fn2(yn.Size());
 	(*_ivp)(tn+dt, ynew, fn1);
 	(*_ivp)(tn, yn, fn2);
@@ -633,11 +740,17 @@ FP IRKC::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP at
 	(*_ivp)(tn, yn, fn2, 2);
 	rhs += dt*_k1*(fn1 - fn2);
 
-	Vec<FP> err = Mat<FP>::SolveLU(LU, P, rhs); 
+	Vec<FP> err(yn.Size());
+	_E->Solve(rhs, err);
 	err /= StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
 	return err.RMS();
 }
 
+void IRKC::GetStats(Hash<ParamValue>& params) const {
+	RKC2::GetStats(params);
+	params["factorizations"].SetLong(_statFactorizations);
+	_newton.GetStats(params);
+}
 
 const char* IRKC::GetName() const {
 	return "IMEX Runge-Kutta-Chebyshev";
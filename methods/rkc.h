@@ -2,23 +2,76 @@
 #define RKC_H
 
 #include <methods/basemethod.h>
+#include <methods/newton.h>
+
+#include <vector>
 
 class RKC2 : public BaseMethod {
 protected:
+	// Stage j = 2..m of the Chebyshev recursions is
+	//
+	//	K_j = k0_j K_0 + mu_j K_j-1 + nu_j K_j-2 + kappa_j dt F_j-1 + gamma_j dt F_0
+	//
+	// with K_1 = K_0 + kappa_1 dt F_0 and F_j evaluated at t + c_j dt. IRKC also
+	// adds g0_j dt G_0 + g2_j dt G_j-2. Each method computes the table of a stage
+	// count the first time it takes that many stages.
+	struct StageTable {
+		bool computed;
+		std::vector<FP> k0;
+		std::vector<FP> mu;
+		std::vector<FP> nu;
+		std::vector<FP> kappa;
+		std::vector<FP> gamma;
+		std::vector<FP> c;
+		std::vector<FP> g0;
+		std::vector<FP> g2;
+	};
+
 	Vec<FP> _F0;
+	Vec<FP> _Fj;
+	Vec<FP> _K[2];
+	std::vector<StageTable> _tables;
+
+	enum SpRadType {
+		SR_POWER = 0,
+		SR_GERSHGORIN = 1,
+		SR_BOUND = 2
+	};
 
 	FP _eta;
 	long _m;
 	long _maxStages;
-	Vec<FP> _spRadGuess;
+
+	// Spectral radius estimates of the whole right hand side (0) and of each
+	// split, with the number of steps each one has been used for
+	SpRadType _spRadType;
+	long _spRadReuse;
+	long _powerIters;
+	long _warmPowerIters;
+	FP _lastT;
+	FP _spRad[3];
+	long _spRadAge[3];
+	Vec<FP> _spRadGuess[3];
 
 	// Stats
 	long _statMaxStages;
 	long _statMinStages;
 	long _statSteps;
 	long _statStages;
+	long _statSpRadEstimates;
+	long _statSpRadEvals;
 
-	FP EstimateJacobianSpectralRadius(FP t, const Vec<FP>& y, Vec<FP>& guess, const Vec<FP>& yp, long split = 0);
+	const StageTable& Table(long m);
+	virtual void ComputeTable(long m, StageTable& table) const;
+
+	// Stage j is kept in K[j % 3] so that stage m ends in last
+	void StageBuffers(long m, Vec<FP>& last, Vec<FP>** K);
+	void ChebyshevStage(const StageTable& table, long j, FP dt, const Vec<FP>& K0, const Vec<FP>& Kjm1, const Vec<FP>& Kjm2, const Vec<FP>& F0, Vec<FP>& Kj) const;
+
+	void CheckRejection(FP tn);
+	FP SpectralRadius(FP t, const Vec<FP>& y, const Vec<FP>& yp, long split = 0);
+	FP GershgorinBound(FP t, const Vec<FP>& y, long split);
+	FP EstimateJacobianSpectralRadius(FP t, const Vec<FP>& y, Vec<FP>& guess, const Vec<FP>& yp, long split, long iters);
 
 public:
 	RKC2(Hash<ParamValue>& params, BaseIVP* ivp);
@@ -43,6 +96,9 @@ public:
 };
 
 class RKC1 : public RKC2 {
+protected:
+	virtual void ComputeTable(long m, StageTable& table) const;
+
 public:
 	RKC1(Hash<ParamValue>& params, BaseIVP* ivp);
 
@@ -62,7 +118,6 @@ protected:
 	Vec<FP> _Kf;
 
 	FP _cmm1;
-	Vec<FP> _spRadGuessG;
 		
 public:
 	PRKC(Hash<ParamValue>& params, BaseIVP* ivp);
@@ -74,19 +129,35 @@ public:
 	virtual const char* GetName() const;
 };
 
+// The implicit stages of IRKC all solve with I - k1 dt J, which is factored
+// once per step, dense or with -sparse 1 sparse, and also filters the error
+// estimate.
 class IRKC : public RKC2 {
 protected:
 	FP _k1;
-	Mat<FP>* _jac;
+	const BaseMat<FP>* _jac;
+	BaseMat<FP>* _E;
+	Vec<FP> _G0;
+	Vec<FP> _G[2];
+	Vec<FP> _stage;
+	Vec<FP> _dk;
+	NewtonControl _newton;
+
+	long _statFactorizations;
 
-	void NewtonSolve(const Mat<FP>& LU, const Mat<FP>& P, const Vec<FP>& constant, FP t, FP dt, FP k1, Vec<FP>& k, Vec<FP>& Gj);
+	virtual void ComputeTable(long m, StageTable& table) const;
+
+	void NewtonSolve(const Vec<FP>& constant, FP t, FP dt, FP k1, Vec<FP>& k, Vec<FP>& Gj);
 
 public:
 	IRKC(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~IRKC();
 
 	virtual void PreStep(const FP tn, FP& dt, Vec<FP>& yn);
 	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
 	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
 	
 	virtual const char* GetName() const;
 };
@@ -0,0 +1,706 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/rock.h>
+
+#include <algorithm>
+
+// Gaussian elimination with partial pivoting of the n by n system a x = b
+static bool SolveSmall(std::vector<double> a, std::vector<double> b, long n, std::vector<double>& x) {
+	for( long i = 0; i < n; i++ ) {
+		long p = i;
+		for( long r = i+1; r < n; r++ )
+			if( fabs(a[r*n+i]) > fabs(a[p*n+i]) )
+				p = r;
+		if( a[p*n+i] == 0 )
+			return false;
+		for( long c = 0; c < n; c++ )
+			std::swap(a[i*n+c], a[p*n+c]);
+		std::swap(b[i], b[p]);
+
+		for( long r = i+1; r < n; r++ ) {
+			double m = a[r*n+i]/a[i*n+i];
+			for( long c = i; c < n; c++ )
+				a[r*n+c] -= m*a[i*n+c];
+			b[r] -= m*b[i];
+		}
+	}
+
+	x.assign(n, 0);
+	for( long i = n-1; i >= 0; i-- ) {
+		double sum = b[i];
+		for( long c = i+1; c < n; c++ )
+			sum -= a[i*n+c]*x[c];
+		x[i] = sum/a[i*n+i];
+	}
+	return true;
+}
+
+static double Factorial(long n) {
+	double f = 1;
+	for( long i = 2; i <= n; i++ )
+		f *= i;
+	return f;
+}
+
+// R(x) = w(x) P_n(x) with w = prod_i ((x - a_i)^2 + b_i^2) and the monic P_n
+// orthogonal for w^2/sqrt(1 - x^2), p_j+1 = (x - alpha_j) p_j - beta_j p_j-1
+struct OrthogonalPolynomial {
+	long n;
+	long pairs;
+	double a[2];
+	double b[2];
+	std::vector<double> alpha;
+	std::vector<double> beta;
+
+	OrthogonalPolynomial(long degree, long p) : n(degree), pairs(p) {
+	}
+
+	double W(double x) const {
+		double w = 1;
+		for( long i = 0; i < pairs; i++ )
+			w *= sqr(x - a[i]) + sqr(b[i]);
+		return w;
+	}
+
+	// The recurrence by the Stieltjes procedure on enough Gauss-Chebyshev
+	// nodes to integrate every inner product exactly
+	void Set(const double* scaled) {
+		for( long i = 0; i < pairs; i++ ) {
+			a[i] = 1 - scaled[2*i]/sqr(double(n));
+			b[i] = fabs(scaled[2*i+1])/sqr(double(n));
+		}
+
+		long N = n + 2*pairs + 2;
+		std::vector<double> x(N), w(N), pm(N, 0), p0(N, 1);
+		for( long k = 0; k < N; k++ ) {
+			x[k] = cos((2*k+1)*M_PI/(2*N));
+			w[k] = sqr(W(x[k]));
+		}
+
+		alpha.assign(n+1, 0);
+		beta.assign(n+1, 0);
+		double normPrev = 1;
+		for( long j = 0; j <= n; j++ ) {
+			double norm = 0, xnorm = 0;
+			for( long k = 0; k < N; k++ ) {
+				norm += w[k]*p0[k]*p0[k];
+				xnorm += w[k]*x[k]*p0[k]*p0[k];
+			}
+			alpha[j] = xnorm/norm;
+			beta[j] = j ? norm/normPrev : 0;
+			normPrev = norm;
+
+			for( long k = 0; k < N; k++ ) {
+				double p1 = (x[k] - alpha[j])*p0[k] - beta[j]*pm[k];
+				pm[k] = p0[k];
+				p0[k] = p1;
+			}
+		}
+	}
+
+	// R(1 + z/l)/R(1) = 1 + z + r_2 z^2 + ... + r_K z^K + ...
+	void Series(long K, std::vector<double>& r, double& l) const {
+		std::vector<double> pm(K+1, 0), p0(K+1, 0), p1(K+1);
+		p0[0] = 1;
+		for( long j = 0; j < n; j++ ) {
+			for( long k = 0; k <= K; k++ )
+				p1[k] = (1 - alpha[j])*p0[k] + (k ? p0[k-1] : 0) - (j ? beta[j]*pm[k] : 0);
+			double scale = fabs(p1[0]);
+			for( long k = 0; k <= K; k++ ) {
+				p1[k] /= scale;
+				p0[k] /= scale;
+			}
+			pm = p0;
+			p0 = p1;
+		}
+
+		std::vector<double> w(K+1, 0);
+		w[0] = 1;
+		for( long i = 0; i < pairs; i++ ) {
+			double d = 1 - a[i];
+			std::vector<double> t(K+1, 0);
+			for( long k = 0; k <= K; k++ ) {
+				t[k] += (d*d + b[i]*b[i])*w[k];
+				if( k+1 <= K )
+					t[k+1] += 2*d*w[k];
+				if( k+2 <= K )
+					t[k+2] += w[k];
+			}
+			w = t;
+		}
+
+		r.assign(K+1, 0);
+		for( long i = 0; i <= K; i++ )
+			for( long j = 0; i+j <= K; j++ )
+				r[i+j] += p0[i]*w[j];
+		double r0 = r[0];
+		l = r[1]/r0;
+		double scale = r0;
+		for( long k = 0; k <= K; k++ ) {
+			r[k] /= scale;
+			scale *= l;
+		}
+	}
+
+	// R(x)/R(1), with the recurrence divided by p_j(1) to stay bounded
+	double Ratio(double x) const {
+		double pm = 0, p0 = 1, qm = 0, q0 = 1;
+		for( long j = 0; j < n; j++ ) {
+			double p = (x - alpha[j])*p0 - (j ? beta[j]*pm : 0);
+			double q = (1 - alpha[j])*q0 - (j ? beta[j]*qm : 0);
+			pm = p0/q;
+			p0 = p/q;
+			qm = q0/q;
+			q0 = 1;
+		}
+		return p0*W(x)/W(1);
+	}
+
+	// The largest |R| on [-1, 1] past the first minimum from x = 1
+	double Damping() const {
+		long M = 16*n + 64;
+		double prev = 1, damping = 0;
+		bool past = false;
+		for( long k = 1; k <= M; k++ ) {
+			double r = Ratio(cos(M_PI*k/M));
+			if( !past ) {
+				if( r < prev ) {
+					prev = r;
+					continue;
+				}
+				past = true;
+			}
+			damping = std::max(damping, fabs(r));
+		}
+		return damping;
+	}
+};
+
+// r_k k! - 1 for k = 2..order and l/target - 1
+static void OrderConditions(OrthogonalPolynomial& P, long order, double target, const std::vector<double>& v, std::vector<double>& F) {
+	P.Set(&v[0]);
+	std::vector<double> r;
+	double l;
+	P.Series(order, r, l);
+	F.clear();
+	for( long k = 2; k <= order; k++ )
+		F.push_back(r[k]*Factorial(k) - 1);
+	F.push_back(l/target - 1);
+}
+
+// Newton with a difference Jacobian for the roots of w that give order p and l
+static bool SolveRoots(OrthogonalPolynomial& P, long order, double l, std::vector<double>& v) {
+	long m = v.size();
+	double last = HUGE_VAL;
+	for( long it = 0; it < 30; it++ ) {
+		std::vector<double> F;
+		OrderConditions(P, order, l, v, F);
+		double res = 0;
+		for( long i = 0; i < m; i++ )
+			res = std::max(res, fabs(F[i]));
+		if( res < 1e-12 || (res < 1e-9 && res > 0.5*last) )
+			return true;
+		if( it > 5 && res > last )
+			return false;
+		last = res;
+
+		std::vector<double> J(m*m), G;
+		for( long j = 0; j < m; j++ ) {
+			std::vector<double> w(v);
+			double h = 1e-7*std::max(1., fabs(v[j]));
+			w[j] += h;
+			OrderConditions(P, order, l, w, G);
+			for( long i = 0; i < m; i++ )
+				J[i*m+j] = (G[i] - F[i])/h;
+		}
+
+		std::vector<double> dx;
+		for( long i = 0; i < m; i++ )
+			F[i] = -F[i];
+		if( !SolveSmall(J, F, m, dx) )
+			return false;
+
+		// At most half of each unknown at a time
+		double change = 0;
+		for( long j = 0; j < m; j++ )
+			change = std::max(change, fabs(dx[j])/std::max(1., fabs(v[j])));
+		double damp = change > 0.5 ? 0.5/change : 1;
+		for( long j = 0; j < m; j++ )
+			v[j] += damp*dx[j];
+	}
+	return false;
+}
+
+static bool DampingAt(OrthogonalPolynomial& P, long order, double l, std::vector<double>& v, double& f) {
+	if( !SolveRoots(P, order, l, v) )
+		return false;
+	P.Set(&v[0]);
+	f = P.Damping() - 0.95;
+	return true;
+}
+
+static void Bracket(double x, double f, const std::vector<double>& v, double& lo, std::vector<double>& vlo, bool& haveLo, double& hi, bool& haveHi) {
+	if( f <= 0 ) {
+		if( !haveLo || x > lo ) {
+			lo = x;
+			vlo = v;
+			haveLo = true;
+		}
+	} else if( !haveHi || x < hi ) {
+		hi = x;
+		haveHi = true;
+	}
+}
+
+// The largest l with a damping of 0.95, by a secant iteration on l that keeps
+// the largest l known to be damped enough
+bool ROCK::Compute(long s, const Coefficients& from) {
+	long n = s - _order;
+	OrthogonalPolynomial P(n, _order/2);
+	std::vector<double> v(from.scaled, from.scaled + _order);
+
+	double l0 = from.ratio*s*s, f0;
+	std::vector<double> v0(v);
+	for( long tries = 0; !DampingAt(P, _order, l0, v, f0); tries++ ) {
+		if( tries == 5 )
+			return false;
+		v = v0;
+		l0 *= 0.9;
+	}
+
+	double lo = 0, hi = 0;
+	std::vector<double> vlo;
+	bool haveLo = false, haveHi = false;
+	Bracket(l0, f0, v, lo, vlo, haveLo, hi, haveHi);
+
+	if( fabs(f0) < 1e-6 ) {
+		lo = l0;
+		vlo = v;
+		haveLo = true;
+	} else {
+		double xa = l0, fa = f0, xb = l0*(f0 > 0 ? 0.98 : 1.02), fb;
+		std::vector<double> vb(v);
+		if( !DampingAt(P, _order, xb, vb, fb) )
+			return false;
+		Bracket(xb, fb, vb, lo, vlo, haveLo, hi, haveHi);
+
+		for( long it = 0; it < 40 && fabs(fb) >= 1e-6; it++ ) {
+			bool bracketed = haveLo && haveHi;
+			if( bracketed && hi - lo < 1e-5*hi )
+				break;
+
+			double x = fb != fa ? xb - fb*(xb - xa)/(fb - fa) : 1.02*xb;
+			if( bracketed && (x <= lo || x >= hi) )
+				x = (lo + hi)/2;
+			if( !bracketed )
+				x = std::min(std::max(x, xb/1.2), 1.2*xb);
+
+			std::vector<double> w(haveLo ? vlo : vb);
+			double f;
+			if( !DampingAt(P, _order, x, w, f) ) {
+				if( !bracketed )
+					return false;
+				x = (lo + hi)/2;
+				w = vlo;
+				if( !DampingAt(P, _order, x, w, f) )
+					return false;
+			}
+			Bracket(x, f, w, lo, vlo, haveLo, hi, haveHi);
+			if( fabs(f) < 1e-6 ) {
+				lo = x;
+				vlo = w;
+				haveLo = true;
+			}
+
+			xa = xb;
+			fa = fb;
+			xb = x;
+			fb = f;
+			vb = w;
+		}
+	}
+	if( !haveLo )
+		return false;
+
+	Coefficients& coef = _coef[s];
+	for( long i = 0; i < _order; i++ )
+		coef.scaled[i] = vlo[i];
+	coef.ratio = lo/(double(s)*s);
+	coef.l = lo;
+	P.Set(&vlo[0]);
+
+	// r_j = p_j(1)/p_j-1(1) turns the recurrence of P into one of R(1 + z/l)
+	coef.mu.resize(n);
+	coef.nu.resize(n);
+	coef.kappa.resize(n);
+	coef.c.resize(n+1);
+	std::vector<double> c(n+1, 0);
+	double r = 1;
+	for( long j = 0; j < n; j++ ) {
+		double r1 = (1 - P.alpha[j]) - (j ? P.beta[j]/r : 0);
+		double mu = 1/(lo*r1);
+		double nu = (1 - P.alpha[j])/r1;
+		double kappa = j ? -P.beta[j]/(r*r1) : 0;
+		c[j+1] = nu*c[j] + (j ? kappa*c[j-1] : 0) + mu;
+		coef.mu[j] = mu;
+		coef.nu[j] = nu;
+		coef.kappa[j] = kappa;
+		r = r1;
+	}
+	for( long j = 0; j <= n; j++ )
+		coef.c[j] = c[j];
+
+	if( !Finish(P.a, P.b, coef) )
+		return false;
+	coef.computed = true;
+	return true;
+}
+
+// Continues from the nearest computed stage count, through the midpoint
+// when the step is too large
+void ROCK::Continue(long s, long from) {
+	if( Compute(s, _coef[from]) )
+		return;
+	if( labs(s - from) <= 1 )
+		throw Exception() << "The coefficients of " << GetName() << " with " << s << " stages did not converge.";
+
+	long mid = (s + from)/2;
+	Continue(mid, from);
+	Continue(s, mid);
+}
+
+const ROCK::Coefficients& ROCK::Coeffs(long s) {
+	if( _coef[s].computed )
+		return _coef[s];
+
+	if( !_coef[_guessStages].computed && !Compute(_guessStages, _guess) )
+		throw Exception() << "The coefficients of " << GetName() << " with " << _guessStages << " stages did not converge.";
+
+	long from = _guessStages;
+	for( long i = _order + 1; i < (long)_coef.size(); i++ )
+		if( _coef[i].computed && labs(i - s) < labs(from - s) )
+			from = i;
+	Continue(s, from);
+	return _coef[s];
+}
+
+ROCK::ROCK(Hash<ParamValue>& params, BaseIVP* ivp, long order, double limit) : RKC2(params, ivp), _order(order), _limit(limit) {
+	if( _maxStages <= _order )
+		throw Exception() << "ROCK" << _order << " needs at least " << _order + 1 << " stages.";
+
+	_guessStages = 0;
+	_guess.computed = false;
+	_coef.resize(std::max(_maxStages, 20L) + 1);
+	for( size_t i = 0; i < _coef.size(); i++ )
+		_coef[i].computed = false;
+
+	if( ivp ) {
+		for( long i = 0; i < 4; i++ )
+			_f[i].Resize(ivp->Size());
+		_err.Resize(ivp->Size());
+	}
+}
+
+// The fewest stages whose stability interval [-2l, 0] covers dt times the
+// spectral radius
+void ROCK::PreStep(const FP tn, FP& dt, Vec<FP>& yn) {
+	CheckRejection(tn);
+	(*_ivp)(tn, yn, _F0);
+	FP spRad = SpectralRadius(tn, yn, _F0);
+
+	double guess = std::min(double(_maxStages + 1), ceil(sqrt(double(dt*spRad)/(2*_limit))));
+	_m = std::max(_order + 1, (long)guess);
+	while( _m <= _maxStages && 2*Coeffs(_m).l < dt*spRad )
+		_m++;
+
+	if( _m > _maxStages ) {
+		_m = _maxStages;
+		dt = 2*Coeffs(_m).l/spRad;
+	}
+
+	if( _m < _statMinStages )
+		_statMinStages = _m;
+	if( _m > _statMaxStages )
+		_statMaxStages = _m;
+	_statStages += _m;
+	_statSteps++;
+}
+
+void ROCK::Internal(FP tn, FP dt, const Vec<FP>& yn, const Coefficients& coef, Vec<FP>& Kn, const Vec<FP>*& last) {
+	long n = coef.mu.size();
+	Vec<FP>* K[3];
+	StageBuffers(n, Kn, K);
+
+	FP a[2] = { 1, coef.mu[0]*dt };
+	const Vec<FP>* v[2] = { &yn, &_F0 };
+	K[1]->Combine<2>(a, v);
+	last = &_F0;
+
+	for( long j = 1; j < n; j++ ) {
+		const Vec<FP>& Kj = *K[j % 3];
+		const Vec<FP>& Kjm1 = j == 1 ? yn : *K[(j-1) % 3];
+		(*_ivp)(tn + coef.c[j]*dt, Kj, _Fj);
+		last = &_Fj;
+
+		FP b[3] = { coef.nu[j], coef.kappa[j], coef.mu[j]*dt };
+		const Vec<FP>* u[3] = { &Kj, &Kjm1, &_Fj };
+		K[(j+1) % 3]->Combine<3>(b, u);
+	}
+}
+
+// The difference to the embedded method, left in _err by Step
+FP ROCK::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	Vec<FP> tol = StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
+	return (_err/tol).RMS();
+}
+
+// ----------------------------------------------------------------------------
+
+ROCK2::ROCK2(Hash<ParamValue>& params, BaseIVP* ivp) : ROCK(params, ivp, 2, 0.4013) {
+	_guessStages = 10;
+	_guess.scaled[0] = 2.13;
+	_guess.scaled[1] = 2.19;
+	_guess.ratio = 0.396;
+}
+
+// w(1 + z/l)/w(1) = 1 + 2 sigma z + tau z^2
+bool ROCK2::Finish(const double* a, const double* b, Coefficients& coef) const {
+	double d = 1 - a[0];
+	double sigma = d/(coef.l*(d*d + b[0]*b[0]));
+	double tau = 1/(sqr(coef.l)*(d*d + b[0]*b[0]));
+
+	coef.finish.resize(2);
+	coef.finish[0] = sigma;
+	coef.finish[1] = sigma - tau/sigma;
+	return true;
+}
+
+// K_n+1 = K_n + sigma dt f(K_n)
+// K*    = K_n+1 + sigma dt f(K_n+1)
+// y1    = K* - sigma (1 - tau/sigma^2) dt (f(K_n+1) - f(K_n))
+void ROCK2::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	const Coefficients& coef = Coeffs(_m);
+	const Vec<FP>* last;
+	Internal(tn, dt, yn, coef, ynew, last);
+
+	FP cn = coef.c.back();
+	FP sigma = coef.finish[0];
+	(*_ivp)(tn + cn*dt, ynew, _f[0]);
+	ynew.AddScaled(sigma*dt, _f[0]);
+	(*_ivp)(tn + (cn + sigma)*dt, ynew, _f[1]);
+
+	FP a[2] = { coef.finish[1]*dt, -coef.finish[1]*dt };
+	const Vec<FP>* v[2] = { &_f[1], &_f[0] };
+	_err.Combine<2>(a, v);
+
+	FP b[3] = { 1, sigma*dt, -1 };
+	const Vec<FP>* u[3] = { &ynew, &_f[1], &_err };
+	ynew.Combine<3>(b, u);
+}
+
+const char* ROCK2::GetName() const {
+	return "ROCK2";
+}
+
+long ROCK2::GetOrder() const {
+	return 2;
+}
+
+long ROCK2::GetAuxOrder() const {
+	return 1;
+}
+
+// ----------------------------------------------------------------------------
+
+ROCK4::ROCK4(Hash<ParamValue>& params, BaseIVP* ivp) : ROCK(params, ivp, 4, 0.1757) {
+	_guessStages = 20;
+	_guess.scaled[0] = 1.08;
+	_guess.scaled[1] = 13.0;
+	_guess.scaled[2] = 9.08;
+	_guess.scaled[3] = 4.80;
+	_guess.ratio = 0.1734;
+}
+
+// The composite tableau has the internal stages K_0..K_n-1, then the finishing
+// stages F_1 = K_n..F_4, and x = (a21, a31, a32, a41, a42, a43, b1..b4)
+static void CompositeTableau(const std::vector<double>& internal, long n, const double* x, long size, std::vector<double>& A) {
+	A.assign(size*size, 0);
+	for( long i = 0; i <= n && i < size; i++ )
+		for( long k = 0; k < n; k++ )
+			A[i*size+k] = internal[i*n+k];
+
+	const double alpha[4][3] = { { 0, 0, 0 }, { x[0], 0, 0 }, { x[1], x[2], 0 }, { x[3], x[4], x[5] } };
+	for( long r = 1; r < 4; r++ ) {
+		for( long k = 0; k < n; k++ )
+			A[(n+r)*size+k] = internal[n*n+k];
+		for( long k = 0; k < 3; k++ )
+			A[(n+r)*size+n+k] = alpha[r][k];
+	}
+}
+
+// c, A c, A c^2 and A A c of the composite tableau
+static void TableauProducts(const std::vector<double>& A, long size, std::vector<double>* v) {
+	for( long k = 0; k < 4; k++ )
+		v[k].assign(size, 0);
+	for( long i = 0; i < size; i++ )
+		for( long k = 0; k < size; k++ )
+			v[0][i] += A[i*size+k];
+	for( long i = 0; i < size; i++ )
+		for( long k = 0; k < size; k++ ) {
+			v[1][i] += A[i*size+k]*v[0][k];
+			v[2][i] += A[i*size+k]*sqr(v[0][k]);
+		}
+	for( long i = 0; i < size; i++ )
+		for( long k = 0; k < size; k++ )
+			v[3][i] += A[i*size+k]*v[1][k];
+}
+
+// The eight conditions of order 4 on the composite method, whose weights are
+// the last internal row followed by b1..b4
+static void CompositeConditions(const std::vector<double>& internal, long n, const double* x, double* g) {
+	long size = n + 4;
+	std::vector<double> A, v[4];
+	CompositeTableau(internal, n, x, size, A);
+	TableauProducts(A, size, v);
+
+	const double rhs[8] = { 1, 1./2, 1./3, 1./6, 1./4, 1./8, 1./12, 1./24 };
+	for( long k = 0; k < 8; k++ )
+		g[k] = -rhs[k];
+	for( long i = 0; i < size; i++ ) {
+		double bi = i < n ? internal[n*n+i] : x[6+i-n];
+		double c = v[0][i];
+		double terms[8] = { 1, c, c*c, v[1][i], c*c*c, c*v[1][i], v[2][i], v[3][i] };
+		for( long k = 0; k < 8; k++ )
+			g[k] += bi*terms[k];
+	}
+}
+
+// The finishing stages solve the composite conditions by a minimum norm
+// Gauss-Newton iteration from the classical method on the remaining
+// 1 - c_n. The embedded weights of order 3 add f(K_n-1) and keep b A A c = 0.
+bool ROCK4::Finish(const double* a, const double* b, Coefficients& coef) const {
+	long n = coef.mu.size();
+
+	// The rows of K_0..K_n in terms of the internal evaluations
+	std::vector<double> internal((n+1)*n, 0);
+	for( long j = 0; j < n; j++ ) {
+		double nu = double(coef.nu[j]), kappa = double(coef.kappa[j]);
+		for( long k = 0; k < n; k++ )
+			internal[(j+1)*n+k] = nu*internal[j*n+k] + (j ? kappa*internal[(j-1)*n+k] : 0);
+		internal[(j+1)*n+j] += double(coef.mu[j]);
+	}
+
+	double w = 1 - double(coef.c[n]);
+	double x[10] = { w/2, 0, w/2, 0, 0, w, w/6, w/3, w/3, w/6 };
+	bool converged = false;
+	for( long it = 0; it < 50 && !converged; it++ ) {
+		double g[8];
+		CompositeConditions(internal, n, x, g);
+		double res = 0;
+		for( long i = 0; i < 8; i++ )
+			res = std::max(res, fabs(g[i]));
+		if( res < 1e-13 ) {
+			converged = true;
+			break;
+		}
+
+		double J[8][10];
+		for( long j = 0; j < 10; j++ ) {
+			double y[10], gh[8];
+			std::copy(x, x + 10, y);
+			y[j] += 1e-7;
+			CompositeConditions(internal, n, y, gh);
+			for( long i = 0; i < 8; i++ )
+				J[i][j] = (gh[i] - g[i])/1e-7;
+		}
+
+		// dx = -J^T (J J^T)^-1 g
+		std::vector<double> M(64, 0), rhs(g, g + 8), y;
+		for( long i = 0; i < 8; i++ )
+			for( long k = 0; k < 8; k++ )
+				for( long j = 0; j < 10; j++ )
+					M[i*8+k] += J[i][j]*J[k][j];
+		if( !SolveSmall(M, rhs, 8, y) )
+			return false;
+		for( long j = 0; j < 10; j++ )
+			for( long i = 0; i < 8; i++ )
+				x[j] -= J[i][j]*y[i];
+	}
+	if( !converged )
+		return false;
+
+	// Embedded weights of F_1..F_4 and of K_n-1 from e, c, c^2, A c and A A c
+	long size = n + 4;
+	std::vector<double> A, v[4];
+	CompositeTableau(internal, n, x, size, A);
+	TableauProducts(A, size, v);
+
+	const double rhs[5] = { 1, 1./2, 1./3, 1./6, 0 };
+	std::vector<double> M(25), F(5), bh;
+	for( long i = 0; i < 5; i++ ) {
+		double fixed = 0;
+		for( long k = 0; k < size; k++ ) {
+			double c = v[0][k];
+			double rows[5] = { 1, c, c*c, v[1][k], v[3][k] };
+			if( k < n )
+				fixed += internal[n*n+k]*rows[i];
+			else
+				M[i*5+k-n] = rows[i];
+			if( k == n-1 )
+				M[i*5+4] = rows[i];
+		}
+		F[i] = rhs[i] - fixed;
+	}
+	if( !SolveSmall(M, F, 5, bh) )
+		return false;
+
+	coef.finish.resize(15);
+	std::copy(x, x + 10, coef.finish.begin());
+	for( long i = 0; i < 4; i++ )
+		coef.finish[10+i] = x[6+i] - bh[i];
+	coef.finish[14] = -bh[4];
+	return true;
+}
+
+// F_1 = K_n and F_i = K_n + dt sum_j a_ij f(F_j), then y1 = K_n + dt sum_i b_i f(F_i)
+void ROCK4::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	const Coefficients& coef = Coeffs(_m);
+	const Vec<FP>* last;
+	Internal(tn, dt, yn, coef, ynew, last);
+
+	const std::vector<FP>& x = coef.finish;
+	const Vec<FP>* v[5] = { &ynew, &_f[0], &_f[1], &_f[2], &_f[3] };
+	FP cn = coef.c.back();
+	(*_ivp)(tn + cn*dt, ynew, _f[0]);
+
+	FP a2[2] = { 1, x[0]*dt };
+	_K[0].Combine<2>(a2, v);
+	(*_ivp)(tn + (cn + x[0])*dt, _K[0], _f[1]);
+
+	FP a3[3] = { 1, x[1]*dt, x[2]*dt };
+	_K[0].Combine<3>(a3, v);
+	(*_ivp)(tn + (cn + x[1] + x[2])*dt, _K[0], _f[2]);
+
+	FP a4[4] = { 1, x[3]*dt, x[4]*dt, x[5]*dt };
+	_K[0].Combine<4>(a4, v);
+	(*_ivp)(tn + (cn + x[3] + x[4] + x[5])*dt, _K[0], _f[3]);
+
+	FP e[5] = { x[14]*dt, x[10]*dt, x[11]*dt, x[12]*dt, x[13]*dt };
+	const Vec<FP>* u[5] = { last, &_f[0], &_f[1], &_f[2], &_f[3] };
+	_err.Combine<5>(e, u);
+
+	FP b[5] = { 1, x[6]*dt, x[7]*dt, x[8]*dt, x[9]*dt };
+	ynew.Combine<5>(b, v);
+}
+
+const char* ROCK4::GetName() const {
+	return "ROCK4";
+}
+
+long ROCK4::GetOrder() const {
+	return 4;
+}
+
+long ROCK4::GetAuxOrder() const {
+	return 3;
+}
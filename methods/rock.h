@@ -0,0 +1,101 @@
+#ifndef ROCK_H
+#define ROCK_H
+
+#include <methods/rkc.h>
+
+#include <vector>
+
+// The orthogonal Runge-Kutta-Chebyshev methods of Abdulle and Medovikov. The
+// stability polynomial is R_s(z) = w(x) P_{s-p}(x) with x = 1 + z/l, where w
+// has p/2 pairs of complex roots and P_{s-p} is orthogonal for the weight
+// w^2/sqrt(1-x^2) on [-1, 1]. The three term recurrence of P gives s-p internal
+// stages that stay stable for any s, and w becomes a finishing procedure of p
+// stages. The roots of w and l make R_s of order p with a damping of 0.95 past
+// its first minimum, for a stability interval of 2l, about 0.80 s^2 for ROCK2
+// and 0.35 s^2 for ROCK4.
+//
+// Rather than reading the published tables, the coefficients of a stage count
+// are computed the first time it is used, continuing from the nearest one
+// already known. They are computed in double precision whatever FP is.
+class ROCK : public RKC2 {
+protected:
+	struct Coefficients {
+		bool computed;
+
+		// The roots of w scaled by (s-p)^2, ((1-a) (s-p)^2, b (s-p)^2) for
+		// each pair, and l/s^2, which change slowly with s
+		double scaled[4];
+		double ratio;
+		double l;
+
+		// K_j+1 = nu_j K_j + kappa_j K_j-1 + mu_j dt f(t + c_j dt, K_j)
+		std::vector<FP> mu;
+		std::vector<FP> nu;
+		std::vector<FP> kappa;
+		std::vector<FP> c;
+
+		std::vector<FP> finish;
+	};
+
+	long _order;
+	double _limit;
+	long _guessStages;
+	Coefficients _guess;
+	std::vector<Coefficients> _coef;
+
+	Vec<FP> _f[4];
+	Vec<FP> _err;
+
+	const Coefficients& Coeffs(long s);
+	void Continue(long s, long from);
+	bool Compute(long s, const Coefficients& from);
+
+	// Runs the internal stages up to K_s-p in Kn, with last pointing to the
+	// last internal evaluation
+	void Internal(FP tn, FP dt, const Vec<FP>& yn, const Coefficients& coef, Vec<FP>& Kn, const Vec<FP>*& last);
+
+	// The finishing procedure from the unscaled roots a_i + b_i i of w
+	virtual bool Finish(const double* a, const double* b, Coefficients& coef) const = 0;
+
+public:
+	ROCK(Hash<ParamValue>& params, BaseIVP* ivp, long order, double limit);
+
+	virtual void PreStep(const FP tn, FP& dt, Vec<FP>& yn);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+};
+
+// The finishing procedure of ROCK2 applies 1 + 2 sigma z + tau z^2 in two
+// stages, and the embedded method of order 1 stops before its correction.
+class ROCK2 : public ROCK {
+protected:
+	virtual bool Finish(const double* a, const double* b, Coefficients& coef) const;
+
+public:
+	ROCK2(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// The finishing procedure of ROCK4 is an explicit four stage method whose
+// coefficients depend on s, so that together with the internal stages it has
+// order 4 for nonlinear problems and not only linear ones. The embedded
+// method of order 3 also uses the last internal evaluation.
+class ROCK4 : public ROCK {
+protected:
+	virtual bool Finish(const double* a, const double* b, Coefficients& coef) const;
+
+public:
+	ROCK4(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+#endif
@@ -0,0 +1,314 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/sdc.h>
+
+SDC::SDC(Hash<ParamValue>& params, BaseIVP* ivp, bool implicit, bool explic, unsigned short splitI, unsigned short splitE) : BaseMethod(params, ivp), _newton(SDC_MAX_NODES, NewtonControl(params, 20)) {
+	_nodes = GetDefaultLong(params, "sdc nodes", 3);
+	if( _nodes < 2 || _nodes > SDC_MAX_NODES )
+		throw Exception() << "sdc nodes must be between 2 and " << SDC_MAX_NODES << ".";
+	_sweeps = GetDefaultLong(params, "sdc sweeps", 2*_nodes - 2);
+	if( _sweeps < 1 )
+		throw Exception() << "sdc sweeps must be at least one.";
+	_parallel = GetDefaultLong(params, "sdc parallel", 0);
+
+	_implicit = implicit;
+	_explicit = explic;
+	_splitI = splitI;
+	_splitE = splitE;
+
+	_threads = GetDefaultLong(params, "threads", 1);
+	_pool = new ThreadPool(_threads);
+	_threads = _pool->Size();
+	if( _threads > 1 && ivp && !ivp->ThreadSafeRHS() )
+		throw Exception() << ivp->GetName() << " does not declare a thread-safe right hand side.";
+
+	// Gauss-Lobatto points are the ends and the roots of P'_M-1, found by
+	// Newton's method on x P_N - P_N-1 from the Chebyshev points
+	long n = _nodes - 1;
+	FP pi = acos(FP(-1));
+	for( long i = 0; i <= n; i++ ) {
+		FP x = -cos(pi*i/n);
+		for( long it = 0; it < 100 && i > 0 && i < n; it++ ) {
+			FP p0 = 1, p1 = x;
+			for( long k = 2; k <= n; k++ ) {
+				FP p2 = ((2*k-1)*x*p1 - (k-1)*p0)/k;
+				p0 = p1;
+				p1 = p2;
+			}
+			FP dx = (x*p1 - p0)/((n+1)*p1);
+			x -= dx;
+			if( fabs(dx) <= 4*std::numeric_limits<FP>::epsilon() )
+				break;
+		}
+		_tau[i] = (1 + x)/2;
+	}
+
+	// Monomial coefficients of each Lagrange basis polynomial, integrated
+	// exactly up to every node
+	for( long j = 0; j < _nodes; j++ ) {
+		FP c[SDC_MAX_NODES] = { 1 };
+		long deg = 0;
+		for( long i = 0; i < _nodes; i++ ) {
+			if( i == j )
+				continue;
+			deg++;
+			for( long k = deg; k >= 0; k-- )
+				c[k] = ((k > 0 ? c[k-1] : 0) - _tau[i]*c[k])/(_tau[j] - _tau[i]);
+		}
+		for( long m = 0; m < _nodes; m++ ) {
+			FP sum = 0, power = _tau[m];
+			for( long k = 0; k <= deg; k++ ) {
+				sum += c[k]*power/(k+1);
+				power *= _tau[m];
+			}
+			_q[m][j] = sum;
+			_s[m][j] = m > 0 ? sum - _q[m-1][j] : 0;
+		}
+	}
+
+	_jac = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+	for( long m = 0; m < SDC_MAX_NODES; m++ ) {
+		_mats[m] = 0;
+		_evals[m] = 0;
+	}
+
+	for( long m = 0; m < _nodes; m++ ) {
+		if( _implicit )
+			_mats[m] = _sparse ? (BaseMat<FP>*)new CSRMat<FP> : (BaseMat<FP>*)new Mat<FP>;
+		if( ivp ) {
+			_u[m].Resize(ivp->Size());
+			_fi[m].Resize(ivp->Size());
+			_fe[m].Resize(ivp->Size());
+			_fiOld[m].Resize(ivp->Size());
+			_feOld[m].Resize(ivp->Size());
+			_rhs[m].Resize(ivp->Size());
+			_res[m].Resize(ivp->Size());
+			_delta[m].Resize(ivp->Size());
+		}
+	}
+	if( ivp )
+		_uPrev.Resize(ivp->Size());
+
+	_rhsEvals = 0;
+	_statSweeps = 0;
+	_statJacobians = 0;
+	_statFactorizations = 0;
+}
+
+SDC::~SDC() {
+	delete _jac;
+	for( long m = 0; m < SDC_MAX_NODES; m++ )
+		delete _mats[m];
+	delete _pool;
+}
+
+void SDC::Evaluate(long m, FP t, bool implicit) {
+	if( _implicit && implicit ) {
+		(*_ivp)(t, _u[m], _fi[m], _splitI);
+		_evals[m]++;
+	}
+	if( _explicit ) {
+		(*_ivp)(t, _u[m], _fe[m], _splitE);
+		_evals[m]++;
+	}
+}
+
+// _rhs[m] = dt sum_j w_mj f(U_j^old)
+void SDC::Integrate(long m, FP dt, const FP w[SDC_MAX_NODES][SDC_MAX_NODES]) {
+	_rhs[m].Zero();
+	for( long j = 0; j < _nodes; j++ ) {
+		if( _implicit )
+			_rhs[m].AddScaled(dt*w[m][j], _fiOld[j]);
+		if( _explicit )
+			_rhs[m].AddScaled(dt*w[m][j], _feOld[j]);
+	}
+}
+
+void SDC::Factor(long m, FP a) {
+	if( _sparse )
+		*(CSRMat<FP>*)_mats[m] = CSRMat<FP>::Eye(_u[m].Size()) - a**(CSRMat<FP>*)_jac;
+	else
+		*(Mat<FP>*)_mats[m] = Mat<FP>::Eye(_u[m].Size()) - a**(Mat<FP>*)_jac;
+	_mats[m]->Factor();
+}
+
+// Simplified Newton for U_m = _rhs[m] + a f_I(t, U_m), starting from the last
+// sweep, with a control of its own so that the parallel sweep can solve the
+// nodes on different threads. _fi[m] is left evaluated at the solution.
+bool SDC::Solve(long m, FP t, FP a) {
+	_newton[m].Start(_u[m], _solverATol, _solverRTol);
+	for( ;; ) {
+		(*_ivp)(t, _u[m], _fi[m], _splitI);
+		_evals[m]++;
+
+		_res[m] = _rhs[m];
+		_res[m].AddScaled(a, _fi[m]);
+		_res[m] -= _u[m];
+
+		_mats[m]->Solve(_res[m], _delta[m]);
+		_u[m] += _delta[m];
+
+		switch( _newton[m].Check(_delta[m]) ) {
+		case NewtonControl::CONVERGED:
+			(*_ivp)(t, _u[m], _fi[m], _splitI);
+			_evals[m]++;
+			return true;
+		case NewtonControl::FAILED:
+			return false;
+		default:
+			break;
+		}
+	}
+}
+
+bool SDC::Sweep(FP tn, FP dt, const Vec<FP>& yn) {
+	for( long m = 1; m < _nodes; m++ ) {
+		FP t = tn + dt*_tau[m];
+		FP a = dt*(_tau[m] - _tau[m-1]);
+
+		Integrate(m, dt, _s);
+		_rhs[m] += _u[m-1];
+		if( _explicit ) {
+			_rhs[m].AddScaled(a, _fe[m-1]);
+			_rhs[m].AddScaled(-a, _feOld[m-1]);
+		}
+
+		if( _implicit ) {
+			_rhs[m].AddScaled(-a, _fiOld[m]);
+			if( !Solve(m, t, a) )
+				return false;
+		} else {
+			_u[m] = _rhs[m];
+		}
+		Evaluate(m, t, false);
+	}
+
+	return true;
+}
+
+bool SDC::ParallelSweep(FP tn, FP dt, const Vec<FP>& yn) {
+	bool converged[SDC_MAX_NODES];
+	_pool->ParallelFor(_nodes-1, [&](long i) {
+		long m = i+1;
+		FP t = tn + dt*_tau[m];
+		FP a = dt*_tau[m];
+
+		Integrate(m, dt, _q);
+		_rhs[m] += yn;
+
+		converged[m] = true;
+		if( _implicit ) {
+			_rhs[m].AddScaled(-a, _fiOld[m]);
+			converged[m] = Solve(m, t, a);
+		} else {
+			_u[m] = _rhs[m];
+		}
+		Evaluate(m, t, false);
+	});
+
+	for( long m = 1; m < _nodes; m++ )
+		if( !converged[m] )
+			return false;
+	return true;
+}
+
+void SDC::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	if( _implicit ) {
+		if( _sparse )
+			*(CSRMat<FP>*)_jac = *(const CSRMat<FP>*)_ivp->JacSparse(tn, yn, _splitI);
+		else
+			*(Mat<FP>*)_jac = *(const Mat<FP>*)_ivp->Jac(tn, yn, _splitI);
+		_ivp->FreezeJacobian(true);
+		_statJacobians++;
+
+		// The sweeps use dt dtau_m and the parallel one dt tau_m on the diagonal
+		_pool->ParallelFor(_nodes-1, [&](long i) {
+			long m = i+1;
+			Factor(m, dt*(_parallel ? _tau[m] : _tau[m] - _tau[m-1]));
+		});
+		_statFactorizations += _nodes-1;
+	}
+
+	for( long m = 0; m < _nodes; m++ ) {
+		_u[m] = yn;
+		_evals[m] = 0;
+	}
+	Evaluate(0, tn, true);
+	for( long m = 1; m < _nodes; m++ ) {
+		_fi[m] = _fi[0];
+		_fe[m] = _fe[0];
+	}
+
+	bool converged = true;
+	for( long k = 0; k < _sweeps && converged; k++ ) {
+		for( long m = 0; m < _nodes; m++ ) {
+			_fiOld[m] = _fi[m];
+			_feOld[m] = _fe[m];
+		}
+		_uPrev = _u[_nodes-1];
+
+		converged = _parallel ? ParallelSweep(tn, dt, yn) : Sweep(tn, dt, yn);
+		_statSweeps++;
+	}
+
+	// Newton failed to converge, so reject
+	if( !converged )
+		_accept = false;
+
+	for( long m = 0; m < _nodes; m++ )
+		_rhsEvals += _evals[m];
+
+	ynew = _u[_nodes-1];
+	if( _implicit )
+		_ivp->FreezeJacobian(false);
+}
+
+// The change made by the last sweep
+FP SDC::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	Vec<FP> tol = StepControlSolver::GetTolerances(yn, ynew, atol, rtol);
+	return ((ynew - _uPrev)/tol).RMS();
+}
+
+void SDC::GetStats(Hash<ParamValue>& params) const {
+	params["rhs evaluations"].SetLong(_rhsEvals);
+	params["sweeps"].SetLong(_statSweeps);
+	params["threads"].SetLong(_threads);
+	if( _implicit ) {
+		params["jacobian evaluations"].SetLong(_statJacobians);
+		params["factorizations"].SetLong(_statFactorizations);
+
+		NewtonControl newton(_newton[0]);
+		for( long m = 1; m < SDC_MAX_NODES; m++ )
+			newton.Merge(_newton[m]);
+		newton.GetStats(params);
+	}
+}
+
+long SDC::GetOrder() const {
+	return std::min(_sweeps, 2*_nodes - 2);
+}
+
+long SDC::GetAuxOrder() const {
+	return std::min(_sweeps - 1, 2*_nodes - 2);
+}
+
+ExplicitSDC::ExplicitSDC(Hash<ParamValue>& params, BaseIVP* ivp) : SDC(params, ivp, false, true, 0, 0) {
+}
+
+const char* ExplicitSDC::GetName() const {
+	return "ExplicitSDC";
+}
+
+ImplicitSDC::ImplicitSDC(Hash<ParamValue>& params, BaseIVP* ivp) : SDC(params, ivp, true, false, 0, 0) {
+}
+
+const char* ImplicitSDC::GetName() const {
+	return "ImplicitSDC";
+}
+
+IMEXSDC::IMEXSDC(Hash<ParamValue>& params, BaseIVP* ivp) : SDC(params, ivp, true, true, 1, 2) {
+}
+
+const char* IMEXSDC::GetName() const {
+	return "IMEXSDC";
+}
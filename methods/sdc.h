@@ -0,0 +1,115 @@
+#ifndef SDC_H
+#define SDC_H
+
+#include <core/common.h>
+#include <core/csrmat.h>
+#include <core/threadpool.h>
+#include <methods/basemethod.h>
+#include <methods/newton.h>
+
+#include <vector>
+
+#define SDC_MAX_NODES 9
+
+// Spectral deferred correction on M Gauss-Lobatto nodes 0 = tau_0 < ... <
+// tau_M-1 = 1. The step starts from yn spread over all nodes, and every sweep
+// corrects the node values with a low order method applied to the error of the
+// collocation equations
+//
+//	U_m+1 = U_m + dt dtau_m (f(U_m) - f(U_m^old)) + dt S_m+1 f(U^old)
+//
+// where S integrates the interpolant of the node derivatives between adjacent
+// nodes. Each sweep raises the order by one, up to the 2M-2 of the collocation
+// solution, and the change made by the last sweep estimates the error.
+//
+// The parallel variant replaces the sweep through the nodes by a Jacobi
+// iteration, U_m = yn + dt Q_m f(U^old) with the implicit terms taken on the
+// diagonal, so every node is corrected at the same time on a thread pool.
+class SDC : public BaseMethod {
+protected:
+	ThreadPool* _pool;
+	long _threads;
+	bool _parallel;
+
+	long _nodes;
+	long _sweeps;
+	FP _tau[SDC_MAX_NODES];
+
+	// Integrals of the Lagrange basis from 0 to tau_m and from tau_m-1 to tau_m
+	FP _q[SDC_MAX_NODES][SDC_MAX_NODES];
+	FP _s[SDC_MAX_NODES][SDC_MAX_NODES];
+
+	// Splits of the right hand side treated implicitly and explicitly, none
+	// when the method has no such part
+	bool _implicit;
+	bool _explicit;
+	unsigned short _splitI;
+	unsigned short _splitE;
+
+	Vec<FP> _u[SDC_MAX_NODES];
+	Vec<FP> _fi[SDC_MAX_NODES];
+	Vec<FP> _fe[SDC_MAX_NODES];
+	Vec<FP> _fiOld[SDC_MAX_NODES];
+	Vec<FP> _feOld[SDC_MAX_NODES];
+	Vec<FP> _rhs[SDC_MAX_NODES];
+	Vec<FP> _res[SDC_MAX_NODES];
+	Vec<FP> _delta[SDC_MAX_NODES];
+	Vec<FP> _uPrev;
+
+	BaseMat<FP>* _jac;
+	BaseMat<FP>* _mats[SDC_MAX_NODES];
+	long _evals[SDC_MAX_NODES];
+	std::vector<NewtonControl> _newton;
+
+	long _rhsEvals;
+	long _statSweeps;
+	long _statJacobians;
+	long _statFactorizations;
+
+	void Evaluate(long m, FP t, bool implicit);
+	void Integrate(long m, FP dt, const FP w[SDC_MAX_NODES][SDC_MAX_NODES]);
+	void Factor(long m, FP a);
+	bool Solve(long m, FP t, FP a);
+
+	bool Sweep(FP tn, FP dt, const Vec<FP>& yn);
+	bool ParallelSweep(FP tn, FP dt, const Vec<FP>& yn);
+
+public:
+	SDC(Hash<ParamValue>& params, BaseIVP* ivp, bool implicit, bool explic, unsigned short splitI, unsigned short splitE);
+	virtual ~SDC();
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+
+	virtual void GetStats(Hash<ParamValue>& params) const;
+
+	virtual long GetOrder() const;
+	virtual long GetAuxOrder() const;
+};
+
+// Forward Euler sweeps of the whole right hand side
+class ExplicitSDC : public SDC {
+public:
+	ExplicitSDC(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+// Backward Euler sweeps of the whole right hand side
+class ImplicitSDC : public SDC {
+public:
+	ImplicitSDC(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+// Forward-backward Euler sweeps, implicit in split 1 and explicit in split 2
+// of a splitting IVP, as with the IMEX Runge-Kutta methods
+class IMEXSDC : public SDC {
+public:
+	IMEXSDC(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+};
+
+#endif
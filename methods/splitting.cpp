@@ -0,0 +1,181 @@
+#include <core/exception.h>
+#include <solvers/basesolver.h>
+#include <methods/splitting.h>
+
+#include <sstream>
+
+BaseMethod* AllocMethod(Hash<ParamValue>& params, BaseIVP* ivp);
+BaseSolver* AllocSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+
+SubflowIVP::SubflowIVP(Hash<ParamValue>& params, BaseIVP* outer, unsigned short split) : BaseIVP(params), _outer(outer), _split(split), _t0(0), _backward(false) {
+	_initialCondition.Resize(outer->Size());
+}
+
+void SubflowIVP::RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp) {
+	if( !_backward ) {
+		(*_outer)(t, y, yp, _split);
+		return;
+	}
+
+	(*_outer)(2*_t0 - t, y, yp, _split);
+	yp *= -1;
+}
+
+void SubflowIVP::SetDirection(FP t0, bool backward) {
+	_t0 = t0;
+	_backward = backward;
+}
+
+const char* SubflowIVP::GetName() {
+	return "Splitting subflow";
+}
+
+// -----------------------------------------------------------------------------------
+
+OperatorSplitting::Part::Part(Hash<ParamValue>& base, BaseIVP* outer, unsigned short split, FP dt) : params(base), ivp(0), method(0), solver(0), steps(0) {
+	std::ostringstream prefix;
+	prefix << "split" << split << " ";
+	std::string p = prefix.str();
+
+	std::string methodName = GetDefaultString(base, (p + "method").c_str(), split == 1 ? "Radau5" : "DOPR54");
+	std::string solverName = GetDefaultString(base, (p + "solver").c_str(), "EmbeddedSolver");
+	if( methodName.find("Splitting") != std::string::npos )
+		throw Exception() << "The splits of an operator splitting cannot themselves be split.";
+	if( solverName == "PararealSolver" )
+		throw Exception() << "The splits of an operator splitting cannot use Parareal solvers.";
+
+	params["method"].SetString(methodName.c_str());
+	params["solver"].SetString(solverName.c_str());
+	params["dt"].SetFP(GetDefaultFP(base, (p + "dt").c_str(), dt));
+	if( base.Get((p + "rtol").c_str()) )
+		params["rtol"].SetFP(base[(p + "rtol").c_str()].GetFP());
+	if( base.Get((p + "atol").c_str()) )
+		params["atol"].SetFP(base[(p + "atol").c_str()].GetFP());
+	params.Remove("output dt");
+
+	Hash<ParamValue> ivpParams;
+	ivp = new SubflowIVP(ivpParams, outer, split);
+	method = AllocMethod(params, ivp);
+	solver = AllocSolver(params, method, ivp);
+}
+
+OperatorSplitting::Part::~Part() {
+	delete solver;
+	delete method;
+	delete ivp;
+}
+
+OperatorSplitting::OperatorSplitting(Hash<ParamValue>& params, BaseIVP* ivp) : BaseMethod(params, ivp) {
+	_first = (unsigned short)GetDefaultLong(params, "first split", 1);
+	if( _first != 1 && _first != 2 )
+		throw Exception() << "first split must be 1 or 2.";
+
+	_parts[0] = _parts[1] = 0;
+	if( !ivp )
+		return;
+
+	FP dt = GetDefaultFP(params, "dt", 1e-3);
+	_parts[0] = new Part(params, ivp, 1, dt);
+	_parts[1] = new Part(params, ivp, 2, dt);
+	_yhat.Resize(ivp->Size());
+}
+
+OperatorSplitting::~OperatorSplitting() {
+	delete _parts[0];
+	delete _parts[1];
+}
+
+void OperatorSplitting::Append(int role, FP fraction) {
+	if( _composition.size() && _composition.back().role == role ) {
+		_composition.back().fraction += fraction;
+		return;
+	}
+
+	Flow flow = { role, fraction };
+	_composition.push_back(flow);
+}
+
+void OperatorSplitting::Strang(FP fraction) {
+	Append(0, fraction/2);
+	Append(1, fraction);
+	Append(0, fraction/2);
+}
+
+void OperatorSplitting::Compose(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew, bool swap) {
+	// Each split keeps its own clock through the step
+	FP elapsed[2] = { 0, 0 };
+
+	ynew = yn;
+	for( size_t i = 0; i < _composition.size(); i++ ) {
+		const Flow& flow = _composition[i];
+		unsigned short split = (flow.role == 0) != swap ? _first : 3 - _first;
+		Part* part = _parts[split-1];
+
+		FP t0 = tn + elapsed[split-1]*dt;
+		FP h = flow.fraction*dt;
+		part->ivp->SetDirection(t0, h < 0);
+		part->method->Restart();
+		part->steps += part->solver->Propagate(t0, t0 + fabs(h), ynew, ynew);
+		elapsed[split-1] += flow.fraction;
+	}
+}
+
+void OperatorSplitting::Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+	Compose(tn, dt, yn, ynew, false);
+}
+
+FP OperatorSplitting::CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+	Compose(tn, dt, yn, _yhat, true);
+	return ((ynew-_yhat)/StepControlSolver::GetTolerances(yn, ynew, atol, rtol)).RMS();
+}
+
+void OperatorSplitting::GetStats(Hash<ParamValue>& params) const {
+	BaseMethod::GetStats(params);
+	if( !_parts[0] )
+		return;
+	params["split1 steps"].SetLong(_parts[0]->steps);
+	params["split2 steps"].SetLong(_parts[1]->steps);
+}
+
+// -----------------------------------------------------------------------------------
+
+LieSplitting::LieSplitting(Hash<ParamValue>& params, BaseIVP* ivp) : OperatorSplitting(params, ivp) {
+	Append(0, 1);
+	Append(1, 1);
+}
+
+const char* LieSplitting::GetName() const {
+	return "Lie Splitting";
+}
+
+long LieSplitting::GetOrder() const {
+	return 1;
+}
+
+StrangSplitting::StrangSplitting(Hash<ParamValue>& params, BaseIVP* ivp) : OperatorSplitting(params, ivp) {
+	Strang(1);
+}
+
+const char* StrangSplitting::GetName() const {
+	return "Strang Splitting";
+}
+
+long StrangSplitting::GetOrder() const {
+	return 2;
+}
+
+YoshidaSplitting::YoshidaSplitting(Hash<ParamValue>& params, BaseIVP* ivp) : OperatorSplitting(params, ivp) {
+	FP w1 = 1/(2 - pow(FP(2), FP(1)/3));
+	FP w0 = 1 - 2*w1;
+	Strang(w1);
+	Strang(w0);
+	Strang(w1);
+}
+
+const char* YoshidaSplitting::GetName() const {
+	return "Yoshida Splitting";
+}
+
+long YoshidaSplitting::GetOrder() const {
+	return 4;
+}
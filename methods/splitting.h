@@ -0,0 +1,112 @@
+#ifndef SPLITTING_H
+#define SPLITTING_H
+
+#include <methods/basemethod.h>
+
+#include <vector>
+
+class BaseSolver;
+
+// One split of another IVP on its own. Backwards from t0 it is run forwards
+// in s = 2 t0 - t, so that solvers only ever step forwards.
+class SubflowIVP : public BaseIVP {
+protected:
+	BaseIVP* _outer;
+	unsigned short _split;
+	FP _t0;
+	bool _backward;
+
+	virtual void RHS(const FP t, const Vec<FP>& y, Vec<FP>& yp);
+
+public:
+	SubflowIVP(Hash<ParamValue>& params, BaseIVP* outer, unsigned short split);
+
+	void SetDirection(FP t0, bool backward);
+
+	virtual const char* GetName();
+};
+
+// Operator splitting of a two-splitting IVP: a step composes the exact flows
+// of the splits, each approximated by its own method and solver over its part
+// of the step,
+//
+//	y_n+1 = phi^B_{b_m dt} o phi^A_{a_m dt} o ... o phi^B_{b_1 dt} o phi^A_{a_1 dt} (y_n)
+//
+// with A the -first\ split (1 by default) and B the other one. Split k is run
+// by -split{k}\ method with -split{k}\ solver, starting every subflow from
+// -split{k}\ dt (the step size by default) and using -split{k}\ rtol and
+// -split{k}\ atol when they are adaptive. Split 1 defaults to Radau5, as it is
+// the stiff split of the IVPs here, and split 2 to DOPR54, both with the
+// EmbeddedSolver. The sub-methods see Jacobians by differences only.
+//
+// The error estimate is the difference from the same composition with the
+// roles of A and B swapped, which doubles the cost of a step. It is of the
+// order of the local error, though it vanishes where the splits commute.
+class OperatorSplitting : public BaseMethod {
+protected:
+	struct Part {
+		Hash<ParamValue> params;
+		SubflowIVP* ivp;
+		BaseMethod* method;
+		BaseSolver* solver;
+		long steps;
+
+		Part(Hash<ParamValue>& base, BaseIVP* outer, unsigned short split, FP dt);
+		~Part();
+	};
+
+	// Fraction of the step for the flow of A (0) or B (1)
+	struct Flow {
+		int role;
+		FP fraction;
+	};
+
+	std::vector<Flow> _composition;
+	unsigned short _first;
+	Part* _parts[2];
+	Vec<FP> _yhat;
+
+	void Append(int role, FP fraction);
+	void Strang(FP fraction);
+	void Compose(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew, bool swap);
+
+public:
+	OperatorSplitting(Hash<ParamValue>& params, BaseIVP* ivp);
+	virtual ~OperatorSplitting();
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew);
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol);
+	virtual void GetStats(Hash<ParamValue>& params) const;
+};
+
+// A then B, of order 1
+class LieSplitting : public OperatorSplitting {
+public:
+	LieSplitting(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+};
+
+// Half a step of A, a step of B and half a step of A, of order 2
+class StrangSplitting : public OperatorSplitting {
+public:
+	StrangSplitting(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+};
+
+// Yoshida's triple jump of Strang steps of w1 dt, w0 dt and w1 dt, with
+// w1 = 1/(2 - 2^(1/3)) and w0 = 1 - 2 w1, of order 4. As any splitting of
+// order above two, it steps backwards in both splits (w0 < 0), so it only
+// suits splits that are well posed backwards over a short time.
+class YoshidaSplitting : public OperatorSplitting {
+public:
+	YoshidaSplitting(Hash<ParamValue>& params, BaseIVP* ivp);
+
+	virtual const char* GetName() const;
+	virtual long GetOrder() const;
+};
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef TABLEAU_H
+#define TABLEAU_H
+
+#include <utility>
+#include <core/common.h>
+#include <core/timer.h>
+#include <core/csrmat.h>
+#include <solvers/basesolver.h>
+#include <methods/rk.h>
+
+// Butcher tableaux known at compile time. A tableau is a struct providing
+//
+//	static constexpr long Stages;
+//	static constexpr FP A[Stages][Stages], B[Stages], BAux[Stages];
+//
+// (plus A2, B2 and BAux2 for the explicit part of an IMEX pair, where A is the
+// implicit part). The step kernels below are unrolled over the stages and drop
+// every term whose coefficient is zero before the code is generated. The
+// coefficients are still copied into the RKMethod matrices, so GetA() and
+// friends, dumptableau and the solvers that read the tableau keep working.
+
+template <class Tab>
+constexpr FP TableauNode(long i) {
+	FP c = 0;
+	for( long j = 0; j < Tab::Stages; j++ )
+		c += Tab::A[i][j];
+	return c;
+}
+
+template <class Tab>
+constexpr FP TableauNode2(long i) {
+	FP c = 0;
+	for( long j = 0; j < Tab::Stages; j++ )
+		c += Tab::A2[i][j];
+	return c;
+}
+
+template <class Tab>
+constexpr bool TableauRowEmpty(long i) {
+	for( long j = 0; j < Tab::Stages; j++ )
+		if( Tab::A[i][j] != 0 )
+			return false;
+	return true;
+}
+
+// The Newton matrix of the previous stage can be reused when the diagonal
+// entry is repeated, as in SDIRK type tableaux.
+template <class Tab>
+constexpr bool TableauRepeatedDiag(long i) {
+	return i > 0 && Tab::A[i][i] == Tab::A[i-1][i-1];
+}
+
+// First same as last: the last row of A is b, so the last stage is evaluated
+// at (tn+dt, ynew) and its derivative can be reused as the first stage of the
+// next step. The node is one by consistency, but the rounded row sum need not
+// be, so FSAL kernels evaluate that stage at exactly tn+dt.
+template <class Tab>
+constexpr bool TableauFSAL() {
+	const long s = Tab::Stages;
+	if( s < 2 || Tab::B[s-1] != 0 )
+		return false;
+	for( long j = 0; j < s; j++ )
+		if( Tab::A[s-1][j] != Tab::B[j] )
+			return false;
+	return TableauRowEmpty<Tab>(0);
+}
+
+template <class Tab>
+class TableauERK : public ERK {
+	typedef std::make_integer_sequence<long, Tab::Stages> StageSeq;
+
+	Vec<FP> _arg;
+
+	template <long I, long J>
+	inline void StageTerm() {
+		if constexpr( Tab::A[I][J] != 0 )
+			_arg.AddScaled(Tab::A[I][J], _k[J]);
+	}
+
+	template <long I, long... J>
+	inline void StageSum(std::integer_sequence<long, J...>) {
+		_arg.Zero();
+		(StageTerm<I,J>(), ...);
+	}
+
+	template <long I>
+	inline void Stage(FP tn, FP dt, const Vec<FP>& yn, bool reused) {
+		if constexpr( I == 0 )
+			if( reused )
+				return;
+
+		_rhsEvals++;
+		if constexpr( TableauRowEmpty<Tab>(I) ) {
+			(*_ivp)(tn, yn, _k[I]);
+		} else {
+			StageSum<I>(std::make_integer_sequence<long, I>());
+			_arg *= dt;
+			_arg += yn;
+			if constexpr( FSAL && I == S-1 )
+				(*_ivp)(tn + dt, _arg, _k[I]);
+			else
+				(*_ivp)(tn + dt*TableauNode<Tab>(I), _arg, _k[I]);
+		}
+	}
+
+	template <long... I>
+	inline void Stages(FP tn, FP dt, const Vec<FP>& yn, bool reused, std::integer_sequence<long, I...>) {
+		(Stage<I>(tn, dt, yn, reused), ...);
+	}
+
+	template <long I>
+	inline void WeightTerm(Vec<FP>& v) {
+		if constexpr( Tab::B[I] != 0 )
+			v.AddScaled(Tab::B[I], _k[I]);
+	}
+
+	template <long I>
+	inline void AuxTerm(Vec<FP>& v) {
+		if constexpr( Tab::BAux[I] != 0 )
+			v.AddScaled(Tab::BAux[I], _k[I]);
+	}
+
+	template <long... I>
+	inline void WeightSum(Vec<FP>& v, std::integer_sequence<long, I...>) {
+		v.Zero();
+		(WeightTerm<I>(v), ...);
+	}
+
+	template <long... I>
+	inline void AuxSum(Vec<FP>& v, std::integer_sequence<long, I...>) {
+		v.Zero();
+		(AuxTerm<I>(v), ...);
+	}
+
+public:
+	static constexpr long S = Tab::Stages;
+	static constexpr bool FSAL = TableauFSAL<Tab>();
+
+	TableauERK(Hash<ParamValue>& params, BaseIVP* ivp) : ERK(params, ivp, Tab::Stages) {
+		for( long i = 0; i < S; i++ ) {
+			for( long j = 0; j < S; j++ )
+				_a(i,j) = Tab::A[i][j];
+			_b(i) = Tab::B[i];
+			_baux(i) = Tab::BAux[i];
+		}
+		FillC();
+		_fsal = FSAL;
+
+		if( ivp )
+			_arg.Resize(ivp->Size());
+	}
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+		if( _arg.Size() != yn.Size() )
+			_arg.Resize(yn.Size());
+
+		bool reused = ReuseFirstStage(tn, yn);
+		Stages(tn, dt, yn, reused, StageSeq());
+
+		WeightSum(ynew, StageSeq());
+		ynew *= dt;
+		ynew += yn;
+
+		StoreFirstStage(tn, dt, yn, ynew);
+	}
+
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+		AuxSum(_arg, StageSeq());
+		_arg *= dt;
+		_arg += yn;
+
+		return ((ynew-_arg)/StepControlSolver::GetTolerances(yn,ynew,atol,rtol)).RMS();
+	}
+};
+
+template <class Tab>
+class TableauIMEX : public IMEX {
+	typedef std::make_integer_sequence<long, Tab::Stages> StageSeq;
+
+	Vec<FP> _arg;
+
+	template <long I, long J>
+	inline void StageTerm() {
+		if constexpr( Tab::A[I][J] != 0 )
+			_arg.AddScaled(Tab::A[I][J], _k[J]);
+		if constexpr( Tab::A2[I][J] != 0 )
+			_arg.AddScaled(Tab::A2[I][J], _k2[J]);
+	}
+
+	template <long I, long... J>
+	inline void StageSum(std::integer_sequence<long, J...>) {
+		_arg.Zero();
+		(StageTerm<I,J>(), ...);
+	}
+
+	template <long I>
+	inline void Stage(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew, const Vec<FP>& guess,
+					  const BaseMat<FP>* jac, BaseMat<FP>*& mat) {
+		StageSum<I>(std::make_integer_sequence<long, I>());
+		_arg *= dt;
+		_arg += yn;
+
+		// Solve the implicit part
+		_k[I] = guess;
+
+		if constexpr( Tab::A[I][I] == 0 ) {
+			(*_ivp)(tn + dt*TableauNode<Tab>(I), _arg, _k[I], 1);
+		} else if constexpr( TableauRepeatedDiag<Tab>(I) ) {
+			NewtonSolve(tn, dt, I, _arg, mat, _k[I], 1);
+		} else {
+			if( mat )
+				delete mat;
+
+			if( _sparse )
+				mat = new CSRMat<FP>(CSRMat<FP>::Eye(yn.Size()) - dt*Tab::A[I][I]**(CSRMat<FP>*)jac);
+			else
+				mat = new Mat<FP>(Mat<FP>::Eye(yn.Size()) - dt*Tab::A[I][I]**(Mat<FP>*)jac);
+
+			mat->Factor();
+			NewtonSolve(tn, dt, I, _arg, mat, _k[I], 1);
+		}
+
+		if constexpr( Tab::A[I][I] != 0 )
+			_arg.AddScaled(dt*Tab::A[I][I], _k[I]);
+		(*_ivp)(tn + dt*TableauNode2<Tab>(I), _arg, _k2[I], 2);
+
+		if constexpr( Tab::B[I] != 0 )
+			ynew.AddScaled(Tab::B[I], _k[I]);
+		if constexpr( Tab::B2[I] != 0 )
+			ynew.AddScaled(Tab::B2[I], _k2[I]);
+	}
+
+	template <long... I>
+	inline void Stages(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew, const Vec<FP>& guess,
+					   const BaseMat<FP>* jac, BaseMat<FP>*& mat, std::integer_sequence<long, I...>) {
+		(Stage<I>(tn, dt, yn, ynew, guess, jac, mat), ...);
+	}
+
+	template <long I>
+	inline void AuxTerm(Vec<FP>& f, Vec<FP>& g) {
+		if constexpr( Tab::BAux[I] != 0 )
+			f.AddScaled(Tab::BAux[I], _k[I]);
+		if constexpr( Tab::BAux2[I] != 0 )
+			g.AddScaled(Tab::BAux2[I], _k2[I]);
+	}
+
+	template <long... I>
+	inline void AuxSum(Vec<FP>& f, Vec<FP>& g, std::integer_sequence<long, I...>) {
+		(AuxTerm<I>(f, g), ...);
+	}
+
+public:
+	static constexpr long S = Tab::Stages;
+
+	TableauIMEX(Hash<ParamValue>& params, BaseIVP* ivp) : IMEX(params, ivp, Tab::Stages) {
+		for( long i = 0; i < S; i++ ) {
+			for( long j = 0; j < S; j++ ) {
+				_a(i,j) = Tab::A[i][j];
+				_a2(i,j) = Tab::A2[i][j];
+			}
+			_b(i) = Tab::B[i];
+			_b2(i) = Tab::B2[i];
+			_baux(i) = Tab::BAux[i];
+			_baux2(i) = Tab::BAux2[i];
+		}
+		FillC();
+		FillC2();
+
+		if( ivp )
+			_arg.Resize(ivp->Size());
+	}
+
+	virtual void Step(FP tn, FP dt, const Vec<FP>& yn, Vec<FP>& ynew) {
+		if( _arg.Size() != yn.Size() )
+			_arg.Resize(yn.Size());
+		ynew.Zero();
+
+		Timer jactimer;
+		const BaseMat<FP>* jac = _sparse ? _ivp->JacSparse(tn,yn,1) : _ivp->Jac(tn,yn,1);
+		if( _benchmark )
+			printf("jac time: %dms\n", (int)jactimer.msec());
+		_ivp->FreezeJacobian(true);
+
+		BaseMat<FP>* mat = 0;
+		Vec<FP> guess(yn.Size());
+		(*_ivp)(tn, yn, guess, 1);
+
+		Timer stagetimer;
+		Stages(tn, dt, yn, ynew, guess, jac, mat, StageSeq());
+		if( _benchmark )
+			printf("stages: %dms\n", (int)stagetimer.msec());
+
+		if( mat )
+			delete mat;
+
+		ynew *= dt;
+		ynew += yn;
+		_ivp->FreezeJacobian(false);
+	}
+
+	virtual FP CalcEpsilon(FP tn, FP dt, const Vec<FP>& yn, const Vec<FP>& ynew, FP atol, FP rtol) {
+		Vec<FP> auxG(yn.Size());
+		_arg.Zero();
+		auxG.Zero();
+		AuxSum(_arg, auxG, StageSeq());
+		_arg += auxG;
+		_arg *= dt;
+		_arg += yn;
+		return ((ynew-_arg)/StepControlSolver::GetTolerances(yn,ynew,atol,rtol)).RMS();
+	}
+};
+
+#endif
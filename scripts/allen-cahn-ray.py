@@ -20,7 +20,7 @@ lambdas = (0.1,1.)
 gammas = (0.1,1.)
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[0]*1e-2 } for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for N, l, g, m, ivp in itertools.product(unknowns, lambdas, gammas, methods, ivps):
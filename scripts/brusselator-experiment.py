@@ -35,7 +35,7 @@ tolerances = [(t,t) for t in [1e-4, 1e-5, 1e-6, 1e-7, 1e-8 ]]
 alphas = (2e-2,2e-3,)
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[0]*1e-2} for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for m, ivp, alpha in itertools.product(methods, ivps, alphas):
@@ -28,7 +28,7 @@ diffusions = (1e-1, 1e-2, 1e-3)
 unknowns = (1000,)
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[0]*1e-2 } for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for N, m, ivp, tol, d in itertools.product(unknowns, methods, ivps, tolArgs, diffusions):
@@ -30,7 +30,7 @@ unknowns = (500,1000)
 deltas = (1.,1e-3)
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[0]*1e-2} for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for N, d, m, ivp, tol in itertools.product(unknowns, deltas, methods, ivps, tolArgs):
@@ -32,7 +32,7 @@ tolerances = [(10**-t,10**-t) for t in range(4,9)]
 unknowns = (1600,)
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[0]*1e-2 } for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for N, m, ivp, U0, r in itertools.product(unknowns, methods, ivps, uvalues, reactions):
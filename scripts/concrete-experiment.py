@@ -31,7 +31,7 @@ isos = (0,)
  
 def GenerateRunList():
 	stepArgs = [ {"dt": s} for s in stepsizes ]
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[1]*1e-2} for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	# concrete rewetting problem
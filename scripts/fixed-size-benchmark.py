@@ -0,0 +1,43 @@
+#!/usr/bin/env python
+# Compares the throughput of the generic solver path against FixedSolver,
+# which is instantiated for the size of each IVP. Output is suppressed with a
+# large minimum write time so that only the integration is measured.
+import sys
+import os
+import shutil
+import subprocess
+
+binary = '../pythODE++'
+runpath = os.path.join(os.getenv('HOME'), 'tmp', 'fixed-size-benchmark')
+
+def RunInfo(args):
+	if os.path.exists(runpath):
+		shutil.rmtree(runpath)
+	os.makedirs(runpath)
+
+	command = [binary, '-phase', 'runner', '-path', runpath, '-min write time', '1e9', '-max steps', '100000000'] + args
+	p = subprocess.Popen(command)
+	p.wait()
+
+	info = {}
+	for line in open(os.path.join(runpath, '.runinfo')):
+		key, value = line.strip().split(':', 1)
+		info[key] = value
+
+	shutil.rmtree(runpath)
+	return info
+
+ivps = [('NonstiffA2', 200), ('NonstiffB5', 200), ('NonstiffC3', 200), ('NonstiffC5', 20),
+		('NonstiffD5', 200), ('NonstiffE2', 200), ('VanDerPol', 20), ('CellModel', 20)]
+method = sys.argv[1] if len(sys.argv) > 1 else 'DOPR54'
+
+print '%-12s %8s %14s %14s %8s' % ('ivp', 'steps', 'generic st/s', 'fixed st/s', 'speedup')
+for ivp, tf in ivps:
+	rates = []
+	for solver in ['EmbeddedSolver', 'FixedSolver']:
+		info = RunInfo(['-ivp', ivp, '-method', method, '-solver', solver, '-tf', str(tf),
+						'-rtol', '1e-10', '-atol', '1e-10'])
+		steps = float(info['steps'])
+		rates.append(steps / (float(info['time'])/1e3))
+
+	print '%-12s %8d %14.0f %14.0f %8.2f' % (ivp, steps, rates[0], rates[1], rates[1]/rates[0])
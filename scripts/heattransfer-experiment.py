@@ -23,7 +23,7 @@ unknowns = ((70,10),(140,20),(210,30),(280,40))
 #unknowns = ((70,10),(350,50),(700,100))
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[0]*1e-2 } for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for N, d, m, ivp in itertools.product(unknowns, diffusivities, methods, ivps):
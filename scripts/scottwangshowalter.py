@@ -33,7 +33,7 @@ problemTimes = { 'Problem1': (0.011, 0.033, 0.059),
 				 'Problem3': (0.008, 0.020, 0.039, 0.057) }
  
 def GenerateRunList():
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton sol": t[0]*1e-2} for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 	for N, m, ivp, p in itertools.product(unknowns, methods, ivps, problems):
@@ -52,7 +52,7 @@ for js in ('0','1'):
 							    '-method', 'ARK5',
 							    '-atol', tol,
 							    '-rtol', tol,
-								'-newton tol', str(float(tol)*1e-2),
+								'-newton kappa', '1e-2',
 								'-sparse', '1',
 								'-print stats', '1',
 								'-N', N,
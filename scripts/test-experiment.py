@@ -122,7 +122,7 @@ tolerances = [(t,t) for t in [1e-4, 1e-5, 1e-6, 1e-7, 1e-8]]
 
 def GenerateRunList():
 	stepArgs = [ {"dt": s} for s in stepsizes ]
-	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton tol": t[1]*1e-2} for t in tolerances ]
+	tolArgs = [ {"dt": 0.01, "atol": t[0], "rtol": t[1], "newton kappa": 1e-2} for t in tolerances ]
 
 	runlist = []
 
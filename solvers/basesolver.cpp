@@ -8,7 +8,28 @@ void BaseSolver::CheckMaxSteps() {
 		throw Exception() << "Minimum timestep reached.";
 }
 
+// Whether the step from _tn reaches tf. The step is clipped to land on tf
+// unless dense output is on, in which case it may run past tf.
+bool BaseSolver::FinalStep() {
+	if( _outputDt > 0 )
+		return _tn + _dt >= _tf;
+
+	if( _tn + _dt*_stretch >= _tf ) {
+		_dt = _tf - _tn;
+		return true;
+	}
+	return false;
+}
+
 void BaseSolver::WriteFile(long f) {
+	if( _quiet )
+		return;
+
+	if( _outputDt > 0 ) {
+		WriteDense();
+		return;
+	}
+
 	if( _lastWriteTime + _minWriteTime > _tn && !_complete && f )
 		return;
 
@@ -16,24 +37,141 @@ void BaseSolver::WriteFile(long f) {
 	
 	std::ostringstream strs;
 	strs << std::setfill('0') << std::setw(6) << f;
-	std::string filename = _outPath + "/" + strs.str();
-	
+	WriteSolution(_outPath + "/" + strs.str(), _tn, _yn);
+}
+
+void BaseSolver::WriteDense() {
+	Vec<FP> y(_yn.Size());
+
+	while( _outputIndex <= _outputCount ) {
+		FP t = _outputIndex == _outputCount ? _tf : _t0 + _outputIndex*_outputDt;
+		if( t > _tn )
+			break;
+
+		std::ostringstream strs;
+		strs << std::setfill('0') << std::setw(6) << _outputIndex++;
+		if( t == _tn ) {
+			WriteSolution(_outPath + "/" + strs.str(), _tn, _yn);
+		} else {
+			_method->Interpolate(t, y);
+			WriteSolution(_outPath + "/" + strs.str(), t, y);
+		}
+	}
+
+	// The last step may have passed tf, so finish on the interpolated state
+	if( _complete && _tn > _tf ) {
+		_method->Interpolate(_tf, y);
+		_yn = y;
+		_tn = _tf;
+	}
+}
+
+// Illinois variant of regula falsi on the interpolant over [a,b]
+FP BaseSolver::LocateEvent(long e, FP a, FP ga, FP b, FP gb) {
+	Vec<FP> y(_yn.Size());
+	Vec<FP> g(_eventCount);
+	FP tol = _eventTol*std::max(FP(1), fabs(b));
+	FP t = b;
+	int side = 0;
+
+	for( long i = 0; i < 100 && b - a > tol; i++ ) {
+		t = (ga*b - gb*a)/(ga - gb);
+		_method->Interpolate(t, y);
+		_ivp->Events(t, y, g);
+
+		if( g(e)*gb > 0 ) {
+			b = t;
+			gb = g(e);
+			if( side == -1 )
+				ga /= 2;
+			side = -1;
+		} else if( g(e)*ga > 0 ) {
+			a = t;
+			ga = g(e);
+			if( side == 1 )
+				gb /= 2;
+			side = 1;
+		} else {
+			break;
+		}
+	}
+	return t;
+}
+
+void BaseSolver::CheckEvents(FP told) {
+	// With dense output the last step may run past tf, and only the part of
+	// it up to tf is searched
+	FP tend = std::min(_tn, _tf);
+	Vec<FP> yend(_yn);
+	if( tend < _tn )
+		_method->Interpolate(tend, yend);
+
+	Vec<FP> g(_eventCount);
+	_ivp->Events(tend, yend, g);
+
+	std::vector< std::pair<FP,long> > found;
+	long stop = -1;
+	FP tstop = tend;
+	for( long e = 0; e < _eventCount; e++ ) {
+		if( _gOld(e) == 0 || _gOld(e)*g(e) > 0 || _ivp->EventDirection(e)*_gOld(e) > 0 )
+			continue;
+
+		FP t = LocateEvent(e, told, _gOld(e), tend, g(e));
+		found.push_back(std::make_pair(t, e));
+		if( _ivp->EventStop(e) && (stop < 0 || t < tstop) ) {
+			stop = e;
+			tstop = t;
+		}
+	}
+	std::sort(found.begin(), found.end());
+
+	for( size_t i = 0; i < found.size(); i++ ) {
+		if( stop >= 0 && found[i].first > tstop )
+			break;
+
+		EventRecord er;
+		er.e = found[i].second;
+		er.t = found[i].first;
+		_method->Interpolate(er.t, er.y);
+		_events.push_back(er);
+	}
+
+	if( stop >= 0 ) {
+		_method->Interpolate(tstop, _yn);
+		_tn = tstop;
+		_complete = true;
+		_ivp->Events(_tn, _yn, g);
+	}
+	_gOld = g;
+}
+
+void BaseSolver::WriteSolution(const std::string& filename, FP t, const Vec<FP>& y) {
 	std::ofstream file;
 	file.open(filename.c_str(), std::ios::binary);
 	
 	if( !file.is_open() )
 		throw Exception() << "Unable to open " << filename << ".";
 
-	file.write((char*)&_tn, sizeof(_tn));    
-	file << _yn;
+	char tag = ElementTag<FP>::Value();
+	file.write(SOLUTION_MAGIC, SOLUTION_MAGIC_LENGTH);
+	file.write(&tag, sizeof(tag));
+	file.write((char*)&t, sizeof(t));
+	file << y;
 	file.close();
 }
 
 void BaseSolver::UpdateTimestep() {
+	if( _outputDt > 0 || _eventCount )
+		_method->DenseStep(_tn, _dt, _yn, _ynew);
+
+	FP told = _tn;
 	_yn = _ynew;
 	_tn += _dt;
 
 	_method->UpdateTimestep();
+
+	if( _eventCount )
+		CheckEvents(told);
 }
 
 BaseSolver::BaseSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : _ivp(ivp), _method(method) {
@@ -62,15 +200,28 @@ BaseSolver::BaseSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* iv
 	
 	_tn = params["tn"].GetFP();
 	_dt = params["dt"].GetFP();
+	_dtInitial = _dt;
 	_tf = params["tf"].GetFP();
 
 	_printTime = (bool)params["print time"].GetLong();
 
 	_complete = false;
+	_quiet = false;
 	_lastWriteTime = _tn;
 	_minWriteTime = 0;
 	if( params.Get("min write time") )
 		_minWriteTime = params["min write time"].GetFP();
+
+	_t0 = _tn;
+	_outputDt = 0;
+	_outputIndex = 0;
+	_outputCount = 0;
+	if( params.Get("output dt") ) {
+		_outputDt = params["output dt"].GetFP();
+		if( _outputDt <= 0 )
+			throw Exception() << "output dt must be greater than zero.";
+		_outputCount = (long)ceil((_tf - _t0)/_outputDt - 1e-9);
+	}
 		
 	if( params.Get("timing group") && params["timing group"].GetFP() < 0 )
 		throw Exception() << "timing group must be greater than or equal to zero.";
@@ -81,6 +232,13 @@ BaseSolver::BaseSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* iv
 	_ivp->GetInitialCondition(_yn);
 	_ynew.Resize(_yn.Size());
 
+	_eventCount = _ivp->EventCount();
+	_eventTol = GetDefaultFP(params, "event tol", 1e-12);
+	if( _eventCount ) {
+		_gOld.Resize(_eventCount);
+		_ivp->Events(_tn, _yn, _gOld);
+	}
+
 	_steps = 0;
 	_acceptedSteps = 0;
 	_rejectedSteps = 0;
@@ -90,6 +248,27 @@ BaseSolver::BaseSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* iv
 BaseSolver::~BaseSolver() {
 }
 
+// Every interval starts as a fresh run would, from the initial step size and
+// with the counters at zero so that max steps applies to each interval
+long BaseSolver::Propagate(FP t0, FP t1, const Vec<FP>& y0, Vec<FP>& y1) {
+	if( _outputDt > 0 || _eventCount )
+		throw Exception() << GetName() << " cannot propagate with dense output or events.";
+
+	_quiet = true;
+	_complete = false;
+	_tn = t0;
+	_tf = t1;
+	_yn = y0;
+	_dt = _dtInitial;
+	_steps = 0;
+	_acceptedSteps = 0;
+	_rejectedSteps = 0;
+
+	RunSimulation();
+	y1 = _yn;
+	return _steps;
+}
+
 void BaseSolver::DumpRunInfo(Hash<ParamValue>& params) {
 	// Set naming keys
 	params["ivp name"].SetString(_ivp->GetName());
@@ -104,6 +283,26 @@ void BaseSolver::DumpRunInfo(Hash<ParamValue>& params) {
 	_method->GetStats(params);
 	_ivp->GetStats(params);
 
+	if( _eventCount ) {
+		params["events"].SetLong(_events.size());
+		if( _events.size() )
+			params["event time"].SetFP(_events[0].t);
+
+		// One line per event: index, time and state
+		std::string eventname = _outPath + "/.events";
+		std::ofstream events(eventname.c_str());
+		if( !events.is_open() )
+			throw Exception() << "Unable to write events to file " << eventname << ".";
+
+		events << std::setprecision(std::numeric_limits<FP>::max_digits10);
+		for( size_t i = 0; i < _events.size(); i++ ) {
+			events << _events[i].e << " " << _events[i].t;
+			for( long j = 0; j < _events[i].y.Size(); j++ )
+				events << " " << _events[i].y[j];
+			events << std::endl;
+		}
+	}
+
 	std::string filename = _outPath + "/.runinfo";
 	std::ofstream file;
 	file.open(filename.c_str());
@@ -201,6 +400,9 @@ StepControlSolver::StepControlSolver(Hash<ParamValue>& params, BaseMethod* metho
 	_maxChange = GetDefaultFP(params,"maxchange",5.);
 	_maxRejectedChange = GetDefaultFP(params,"maxrejchange",1.);
 	_restrictReject = (bool)GetDefaultLong(params,"restrict reject",1);
+
+	if( _method )
+		_method->SetTolerances(_aTol, _rTol);
 	
 	ParamValue* pv = params.Get("step control");
 	_scType = STANDARD;
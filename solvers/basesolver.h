@@ -12,6 +12,7 @@
 class BaseSolver {
 protected:
 	FP _dt;
+	FP _dtInitial;
 	FP _tn;
 	FP _tf;
 	FP _stretch;
@@ -19,8 +20,28 @@ protected:
 
 	bool _printTime;
 	bool _complete;
+	bool _quiet;
 	FP _lastWriteTime;
 	FP _minWriteTime;
+
+	// Dense output: solutions are written at t0 + k*_outputDt and tf,
+	// interpolated by the method, instead of at the step points
+	FP _t0;
+	FP _outputDt;
+	long _outputIndex;
+	long _outputCount;
+
+	// Events located on the continuous solution
+	struct EventRecord {
+		long e;
+		FP t;
+		Vec<FP> y;
+	};
+
+	long _eventCount;
+	FP _eventTol;
+	Vec<FP> _gOld;
+	std::vector<EventRecord> _events;
 	
 	Vec<FP> _yn;
 	Vec<FP> _ynew;
@@ -36,7 +57,12 @@ protected:
 	Timer _timer;
 	
 	void CheckMaxSteps();
+	bool FinalStep();
 	void WriteFile(long f);
+	void WriteDense();
+	void CheckEvents(FP told);
+	FP LocateEvent(long e, FP a, FP ga, FP b, FP gb);
+	static void WriteSolution(const std::string& filename, FP t, const Vec<FP>& y);
 
 	virtual void UpdateTimestep();
 
@@ -50,6 +76,10 @@ public:
 	virtual void DumpRunInfo(Hash<ParamValue>& params);
 	virtual void RunSimulation() = 0;
 	virtual const char* GetName() const = 0;
+
+	// Integrates from (t0, y0) to t1 without writing any output, for drivers
+	// that run a solver over many intervals. Returns the steps taken.
+	long Propagate(FP t0, FP t1, const Vec<FP>& y0, Vec<FP>& y1);
 };
 
 class StepControlSolver : public BaseSolver {
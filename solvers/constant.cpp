@@ -11,13 +11,11 @@ void ConstantSolver::RunSimulation() {
 		CheckMaxSteps();
 		_method->PreStep(_tn, _dt, _yn);
 		
-		if( _tn + _dt*_stretch >= _tf ) {
+		if( FinalStep() )
 			_complete = true;
-			_dt = _tf - _tn;
-		}
 
 		if( _printTime )
-			printf("tn = %g, dt = %g\n", _tn, _dt);
+			printf("tn = %g, dt = %g\n", (double)_tn, (double)_dt);
 
 		_method->Step(_tn, _dt, _yn, _ynew);
 		_method->PostStep(_tn, _dt, _yn);
@@ -13,10 +13,8 @@ void EmbeddedSolver::RunSimulation() {
 			
 			_method->SetAccept(true);
 			_method->PreStep(_tn, _dt, _yn);
-			if( _tn + _dt*_stretch >= _tf ) {
+			if( FinalStep() )
 				_complete = true;
-				_dt = _tf - _tn;
-			}
 
 			if( _printTime )
 				std::cout << "tn = " << _tn << " dt = " << _dt << std::endl;
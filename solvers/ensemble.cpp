@@ -0,0 +1,245 @@
+#include <core/threadpool.h>
+#include <methods/rk.h>
+#include <solvers/ensemble.h>
+
+#include <random>
+
+EnsembleSolver::EnsembleSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : StepControlSolver(params, method, ivp) {
+	ERK* erk = dynamic_cast<ERK*>(method);
+	if( !erk )
+		throw Exception() << "Ensemble solver requires an explicit Runge-Kutta method.";
+
+	if( _scType != STANDARD )
+		throw Exception() << "Ensemble solver only supports standard step control.";
+
+	if( _outputDt > 0 )
+		throw Exception() << "Ensemble solver does not support dense output.";
+	if( _eventCount )
+		throw Exception() << "Ensemble solver does not support events.";
+
+	// Keep a private copy of the tableau, with the error weights b - baux
+	_a = erk->GetA();
+	_b = erk->GetB();
+	_c = erk->GetC();
+	_e = erk->GetB() - erk->GetBAux();
+	_m = _b.Size();
+	_q = std::min(method->GetOrder(), method->GetAuxOrder());
+	_embedded = erk->GetBAux().InfNorm() != 0;
+
+	_threads = GetDefaultLong(params, "threads", 0);
+	_writeMembers = (bool)GetDefaultLong(params, "ensemble write", 1);
+
+	// Initial conditions are either listed one member per line, or are random
+	// relative perturbations of the IVP's own initial condition.
+	ParamValue* pv;
+	if( (pv = params.Get("ensemble file")) ) {
+		std::ifstream file(pv->GetString());
+		if( !file.is_open() )
+			throw Exception() << "Unable to open ensemble file " << pv->GetString() << ".";
+
+		std::string line;
+		while( std::getline(file, line) ) {
+			std::istringstream values(line);
+			Vec<FP> y(_yn.Size());
+			long i = 0;
+			for( FP v; i < y.Size() && values >> v; i++ )
+				y[i] = v;
+
+			if( i == 0 )
+				continue;
+			if( i != y.Size() )
+				throw Exception() << "Ensemble member " << _members.size() << " has " << i << " values, expected " << y.Size() << ".";
+			_members.push_back(y);
+		}
+	} else {
+		long size = GetDefaultLong(params, "ensemble size", ENSEMBLE_WIDTH);
+		FP perturbation = GetDefaultFP(params, "ensemble perturbation", 0);
+		std::mt19937 generator(GetDefaultLong(params, "ensemble seed", 0));
+		std::uniform_real_distribution<double> uniform(-1, 1);
+
+		for( long m = 0; m < size; m++ ) {
+			Vec<FP> y(_yn);
+			for( long i = 0; m && i < y.Size(); i++ )
+				y[i] *= 1 + perturbation*(FP)uniform(generator);
+			_members.push_back(y);
+		}
+	}
+
+	if( _members.empty() )
+		throw Exception() << "Ensemble is empty.";
+
+	long blocks = (_members.size() + ENSEMBLE_WIDTH - 1)/ENSEMBLE_WIDTH;
+	_blockSteps.assign(blocks, 0);
+	_blockLaneSteps.assign(blocks, 0);
+	_memberAccepted.assign(_members.size(), 0);
+	_memberRejected.assign(_members.size(), 0);
+}
+
+FP EnsembleSolver::LaneFactor(FP eps, bool reject) const {
+	FP factor = pow(eps, FP(1)/(_q+1));
+	if( !_restrictReject && reject )
+		return factor/_safety;
+
+	return std::max(1/_maxChange, std::min(1/_minChange, factor/_safety));
+}
+
+void EnsembleSolver::WriteMember(long member, long f, FP t, const Vec<FP>& y) {
+	if( !_writeMembers )
+		return;
+
+	std::ostringstream strs;
+	strs << _outPath << "/member-" << std::setfill('0') << std::setw(6) << member;
+	std::string path = strs.str();
+	IOObject::MakePath(&path[0]);
+
+	strs << "/" << std::setw(6) << f;
+	WriteSolution(strs.str(), t, y);
+}
+
+void EnsembleSolver::IntegrateBlock(long block) {
+	const int W = ENSEMBLE_WIDTH;
+	const long n = _yn.Size();
+	const long first = block*W;
+
+	Vec<LFP> y(n), ynew(n), err(n), arg(n);
+	std::vector< Vec<LFP> > k(_m, Vec<LFP>(n));
+
+	// Unused lanes of the last block integrate a copy of the first member and
+	// are masked out from the start.
+	LFP t(_tn), dt(_dt);
+	LFP::Mask done(false), last(false);
+	for( int l = 0; l < W; l++ ) {
+		long member = first + l;
+		done[l] = member >= (long)_members.size();
+		const Vec<FP>& y0 = _members[done[l] ? first : member];
+		for( long i = 0; i < n; i++ )
+			y[i][l] = y0[i];
+		if( !done[l] )
+			WriteMember(member, 0, _tn, y0);
+	}
+
+	long steps = 0;
+	while( !AllOf(done) ) {
+		if( steps >= _maxSteps )
+			throw Exception() << "Maximum number of steps reached (" << _maxSteps << ") in ensemble block " << block << ".";
+		steps++;
+
+		for( int l = 0; l < W; l++ ) {
+			if( done[l] ) {
+				dt[l] = 0;
+				continue;
+			}
+
+			_blockLaneSteps[block]++;
+			last[l] = t[l] + dt[l]*_stretch >= _tf;
+			if( last[l] )
+				dt[l] = _tf - t[l];
+		}
+
+		// Stages are shared by all lanes
+		ynew = y;
+		err.Zero();
+		for( long s = 0; s < _m; s++ ) {
+			arg = y;
+			for( long j = 0; j < s; j++ )
+				if( _a(s,j) != 0 )
+					arg.AddScaled(dt*_a(s,j), k[j]);
+
+			(*_ivp)(t + dt*_c(s), arg, k[s]);
+
+			if( _b(s) != 0 )
+				ynew.AddScaled(dt*_b(s), k[s]);
+			if( _e(s) != 0 )
+				err.AddScaled(dt*_e(s), k[s]);
+		}
+
+		// Weighted RMS norm of the error in every lane
+		LFP sum(0);
+		for( long i = 0; i < n; i++ )
+			sum += sqr(err[i]/(_aTol + _rTol*fmax(fabs(y[i]), fabs(ynew[i]))));
+		LFP eps = sqrt(sum/(FP)n);
+
+		LFP::Mask accept;
+		for( int l = 0; l < W; l++ ) {
+			accept[l] = false;
+			if( done[l] )
+				continue;
+
+			long member = first + l;
+			bool nan = eps[l] != eps[l];
+			for( long i = 0; i < n && !nan; i++ )
+				nan = ynew[i][l] != ynew[i][l];
+
+			// Methods without an embedded pair take constant steps
+			if( nan ) {
+				_memberRejected[member]++;
+				dt[l] *= _minChange;
+			} else if( !_embedded || eps[l] <= 1 ) {
+				accept[l] = true;
+				_memberAccepted[member]++;
+				t[l] += dt[l];
+				if( _embedded )
+					dt[l] /= LaneFactor(eps[l], false);
+			} else {
+				_memberRejected[member]++;
+				dt[l] /= std::max(LaneFactor(eps[l], true), 1/_maxRejectedChange);
+			}
+
+			if( !(accept[l] && last[l]) && dt[l] < 1e-10 )
+				throw Exception() << "Minimum timestep reached for ensemble member " << member << ".";
+		}
+
+		for( long i = 0; i < n; i++ )
+			y[i] = Select(accept, ynew[i], y[i]);
+
+		for( int l = 0; l < W; l++ ) {
+			if( !accept[l] || !last[l] )
+				continue;
+
+			done[l] = true;
+			long member = first + l;
+			Vec<FP> yl(n);
+			for( long i = 0; i < n; i++ )
+				yl[i] = y[i][l];
+			WriteMember(member, _memberAccepted[member], t[l], yl);
+		}
+	}
+
+	_blockSteps[block] = steps;
+}
+
+void EnsembleSolver::RunSimulation() {
+	ThreadPool pool(_threads);
+	_threads = pool.Size();
+
+	_timer.Start();
+	pool.ParallelFor(_blockSteps.size(), [this](long block) { IntegrateBlock(block); });
+	_timer.End();
+
+	_steps = _acceptedSteps = _rejectedSteps = 0;
+	for( size_t b = 0; b < _blockSteps.size(); b++ )
+		_steps += _blockSteps[b];
+	for( size_t m = 0; m < _members.size(); m++ ) {
+		_acceptedSteps += _memberAccepted[m];
+		_rejectedSteps += _memberRejected[m];
+	}
+	_complete = true;
+}
+
+void EnsembleSolver::DumpRunInfo(Hash<ParamValue>& params) {
+	long laneSteps = 0;
+	for( size_t b = 0; b < _blockSteps.size(); b++ )
+		laneSteps += _blockLaneSteps[b];
+
+	params["ensemble size"].SetLong(_members.size());
+	params["ensemble width"].SetLong(ENSEMBLE_WIDTH);
+	params["threads"].SetLong(_threads);
+	params["rhs evaluations"].SetLong(_steps*_m);
+	params["lane utilization"].SetFP(_steps ? FP(laneSteps)/(_steps*ENSEMBLE_WIDTH) : 0);
+
+	BaseSolver::DumpRunInfo(params);
+}
+
+const char* EnsembleSolver::GetName() const {
+	return "Ensemble Solver";
+}
@@ -0,0 +1,45 @@
+#ifndef ENSEMBLE_SOLVER_H
+#define ENSEMBLE_SOLVER_H
+
+#include <core/common.h>
+#include <core/lanes.h>
+#include <solvers/basesolver.h>
+
+// Integrates many instances of the same IVP, differing in their initial
+// conditions, with an explicit Runge-Kutta method. ENSEMBLE_WIDTH instances
+// are packed into the lanes of one state vector so that every stage needs a
+// single RHS call for all of them; each lane keeps its own time and step size
+// and lanes that are finished or rejected are masked out of the update. Blocks
+// of lanes are independent and are distributed over a thread pool.
+class EnsembleSolver : public StepControlSolver {
+protected:
+	Mat<FP> _a;
+	Vec<FP> _b;
+	Vec<FP> _e;
+	Vec<FP> _c;
+	long _m;
+	long _q;
+	bool _embedded;
+
+	long _threads;
+	bool _writeMembers;
+	std::vector< Vec<FP> > _members;
+
+	std::vector<long> _blockSteps;
+	std::vector<long> _blockLaneSteps;
+	std::vector<long> _memberAccepted;
+	std::vector<long> _memberRejected;
+
+	FP LaneFactor(FP eps, bool reject) const;
+	void WriteMember(long member, long f, FP t, const Vec<FP>& y);
+	void IntegrateBlock(long block);
+
+public:
+	EnsembleSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+
+	virtual void DumpRunInfo(Hash<ParamValue>& params);
+	virtual void RunSimulation();
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include <solvers/extrapolation.h>
+
+ExtrapolationSolver::ExtrapolationSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : StepControlSolver(params, method, ivp) {
+	_extrapolation = dynamic_cast<Extrapolation*>(method);
+	if( !_extrapolation )
+		throw Exception() << "Extrapolation solver requires an extrapolation method (GBS or LIEuler).";
+
+	_lastRejected = false;
+}
+
+void ExtrapolationSolver::AcceptExtrapolationStep() {
+	if( CheckMethodReject() )
+		return;
+
+	_rejectStep = false;
+	UpdateTimestep();
+	_epsLast = _eps;
+	_dtOld = _dt;
+	_acceptedSteps++;
+
+	// Neither the step size nor the number of columns grows right after a
+	// rejection
+	FP factor;
+	_extrapolation->SetColumns(_extrapolation->SelectColumns(factor, _lastRejected));
+	if( _lastRejected )
+		factor = std::max(factor, FP(1));
+	_lastRejected = false;
+	_dt /= std::min(1/_minChange, std::max(factor, 1/_maxChange));
+}
+
+void ExtrapolationSolver::RejectExtrapolationStep() {
+	if( CheckMethodReject() )
+		return;
+
+	_rejectStep = true;
+	_lastRejected = true;
+	_complete = false;
+	_rejectedSteps++;
+
+	FP factor;
+	_extrapolation->SetColumns(_extrapolation->SelectColumns(factor, true));
+	_dt /= std::min(1/_minChange, std::max(factor, 1/_maxRejectedChange));
+}
+
+void ExtrapolationSolver::RunSimulation() {
+	WriteFile(0);
+
+	_timer.Start();
+	while( !_complete ) {
+		do {
+			CheckMaxSteps();
+
+			_method->SetAccept(true);
+			_method->PreStep(_tn, _dt, _yn);
+			if( FinalStep() )
+				_complete = true;
+
+			if( _printTime )
+				std::cout << "tn = " << _tn << " dt = " << _dt << " k = " << _extrapolation->GetColumns() << std::endl;
+
+			_method->Step(_tn, _dt, _yn, _ynew);
+			_method->PostStep(_tn, _dt, _yn);
+			_eps = _method->CalcEpsilon(_tn, _dt, _yn, _ynew, _aTol, _rTol);
+			_eps <= 1 ? AcceptExtrapolationStep() : RejectExtrapolationStep();
+			_steps++;
+		} while( _rejectStep );
+
+		WriteFile(_acceptedSteps);
+	}
+	_timer.End();
+}
+
+const char* ExtrapolationSolver::GetName() const {
+	return "Extrapolation Solver";
+}
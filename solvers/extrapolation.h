@@ -0,0 +1,26 @@
+#ifndef EXTRAPOLATION_SOLVER_H
+#define EXTRAPOLATION_SOLVER_H
+
+#include <core/common.h>
+#include <methods/extrapolation.h>
+#include <solvers/basesolver.h>
+
+// Step size and order control for the extrapolation methods (GBS and
+// LIEuler). After every step the number of columns with the least work per
+// unit step is chosen, and the step size follows from its error estimate.
+class ExtrapolationSolver : public StepControlSolver {
+protected:
+	Extrapolation* _extrapolation;
+	bool _lastRejected;
+
+	void AcceptExtrapolationStep();
+	void RejectExtrapolationStep();
+
+public:
+	ExtrapolationSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+
+	virtual void RunSimulation();
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include <methods/rk.h>
+#include <solvers/fixed.h>
+
+FixedSizeSolver::FixedSizeSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp, long n) : StepControlSolver(params, method, ivp), _newtonIterations(0), _jacobians(0) {
+	RKMethod* rk = dynamic_cast<RKMethod*>(method);
+	if( !rk || dynamic_cast<IMEX*>(method) )
+		throw Exception() << "Fixed size solver requires an explicit or diagonally implicit Runge-Kutta method.";
+
+	if( ivp->Size() != n )
+		throw Exception() << "Fixed size solver was built for " << n << " unknowns but " << ivp->GetName() << " has " << ivp->Size() << ".";
+
+	if( _outputDt > 0 )
+		throw Exception() << "Fixed size solver does not support dense output.";
+	if( _eventCount )
+		throw Exception() << "Fixed size solver does not support events.";
+
+	_a = rk->GetA();
+	_b = rk->GetB();
+	_c = rk->GetC();
+	_e = rk->GetB() - rk->GetBAux();
+	_m = _b.Size();
+	_embedded = rk->GetBAux().InfNorm() != 0;
+
+	if( _m > FIXED_MAX_STAGES )
+		throw Exception() << "Fixed size solver supports at most " << FIXED_MAX_STAGES << " stages.";
+
+	_implicit = false;
+	for( long i = 0; i < _m; i++ ) {
+		for( long j = i+1; j < _m; j++ )
+			if( _a(i,j) != 0 )
+				throw Exception() << "Fixed size solver requires a lower triangular tableau.";
+		if( _a(i,i) != 0 )
+			_implicit = true;
+	}
+
+	_newtonFail = GetDefaultFP(params, "newton fail", 1e20);
+	_newtonTol = GetDefaultFP(params, "newton tol", 1e-8);
+	_jacDelta = GetDefaultFP(params, "jac delta", 1e-5);
+}
+
+void FixedSizeSolver::Accept() {
+	_rejectStep = false;
+	_tn += _dt;
+	FP factor = _embedded ? CalculateFactor() : 1;
+	_epsLast = _eps;
+	_dtOld = _dt;
+	_dt /= factor;
+	_acceptedSteps++;
+}
+
+void FixedSizeSolver::Reject(bool failed) {
+	_rejectStep = true;
+	_complete = false;
+	_rejectedSteps++;
+	if( failed )
+		_dt *= _minChange;
+	else
+		_dt /= std::max(CalculateFactor(), 1/_maxRejectedChange);
+}
+
+void FixedSizeSolver::DumpRunInfo(Hash<ParamValue>& params) {
+	if( _implicit ) {
+		params["newton iterations"].SetLong(_newtonIterations);
+		params["jacobian evaluations"].SetLong(_jacobians);
+	}
+	params["steps per second"].SetFP(_timer.msec() > 0 ? 1e3*_steps/_timer.msec() : 0);
+
+	BaseSolver::DumpRunInfo(params);
+}
+
+const char* FixedSizeSolver::GetName() const {
+	return "Fixed Size Solver";
+}
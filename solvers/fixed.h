@@ -0,0 +1,192 @@
+#ifndef FIXED_SOLVER_H
+#define FIXED_SOLVER_H
+
+#include <core/common.h>
+#include <core/fixedmat.h>
+#include <core/fixedvec.h>
+#include <solvers/basesolver.h>
+
+#define FIXED_MAX_STAGES 16
+
+// Runs an explicit or diagonally implicit RK tableau on IVPs whose size is a
+// compile-time constant. The state lives in FixedVecs on the stack and the RHS
+// is the IVP's templated kernel called without virtual dispatch, so a step
+// performs no allocation. Step size control follows EmbeddedSolver (or
+// ConstantSolver for methods without an embedded pair) step for step.
+class FixedSizeSolver : public StepControlSolver {
+protected:
+	Mat<FP> _a;
+	Vec<FP> _b;
+	Vec<FP> _e;
+	Vec<FP> _c;
+	long _m;
+	bool _embedded;
+	bool _implicit;
+
+	FP _newtonTol;
+	FP _newtonFail;
+	FP _jacDelta;
+	long _newtonIterations;
+	long _jacobians;
+
+	void Accept();
+	void Reject(bool failed);
+
+public:
+	FixedSizeSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp, long n);
+
+	virtual void DumpRunInfo(Hash<ParamValue>& params);
+	virtual const char* GetName() const;
+};
+
+template <class I, long N>
+class FixedSolver : public FixedSizeSolver {
+	typedef FixedVec<FP,N> V;
+
+	I* _fixedIvp;
+
+	inline void F(FP t, const V& y, V& yp) {
+		_fixedIvp->RHSInternal(t, y, yp);
+	}
+
+	// Forward difference Jacobian, as in BaseIVP::JacForward
+	void Jacobian(FP t, const V& y, const V& f, FixedMat<FP,N>& jac) {
+		FP eps = std::numeric_limits<FP>().epsilon();
+		V offset = y;
+		V f2;
+		for( long j = 0; j < N; j++ ) {
+			FP delta = sqrt(eps*std::max<FP>(_jacDelta, fabs(y[j])));
+			offset[j] += delta;
+			F(t, offset, f2);
+			for( long i = 0; i < N; i++ )
+				jac(i,j) = (f2[i]-f[i]) / delta;
+			offset[j] = y[j];
+		}
+		_jacobians++;
+	}
+
+	// Simplified Newton iteration for k = f(t, yn + dt*a*k), as in DIRK::NewtonSolve
+	bool NewtonSolve(FP t, FP dta, const V& yn, const FixedMat<FP,N>& lu, V& k) {
+		V argy, f, delta;
+		for( long i = 0; i < 20; i++ ) {
+			_newtonIterations++;
+			argy = yn;
+			argy.AddScaled(dta, k);
+			F(t, argy, f);
+			f -= k;
+
+			lu.Solve(f, delta);
+			k += delta;
+
+			FP norm = f.InfNorm();
+			if( norm > _newtonFail )
+				break;
+			if( norm < _newtonTol )
+				return true;
+		}
+		return false;
+	}
+
+	// Returns false if a Newton iteration failed
+	bool Step(FP tn, FP dt, const V& yn, V* k, V& ynew, V& err) {
+		FixedMat<FP,N> jac, lu;
+		V f0;
+		if( _implicit ) {
+			F(tn, yn, f0);
+			Jacobian(tn, yn, f0, jac);
+		} else {
+			f0.Zero();
+			jac.Zero();
+		}
+		lu.Zero();
+
+		ynew = yn;
+		err.Zero();
+		FP factored = 0;
+		for( long s = 0; s < _m; s++ ) {
+			V arg = yn;
+			for( long j = 0; j < s; j++ )
+				if( _a(s,j) != 0 )
+					arg.AddScaled(dt*_a(s,j), k[j]);
+
+			FP ass = _a(s,s);
+			if( ass == 0 ) {
+				F(tn + dt*_c(s), arg, k[s]);
+			} else {
+				if( ass != factored ) {
+					for( long i = 0; i < N; i++ )
+						for( long j = 0; j < N; j++ )
+							lu(i,j) = (i == j) - dt*ass*jac(i,j);
+					lu.Factor();
+					factored = ass;
+				}
+
+				k[s] = f0;
+				if( !NewtonSolve(tn + dt*_c(s), dt*ass, arg, lu, k[s]) )
+					return false;
+			}
+
+			if( _b(s) != 0 )
+				ynew.AddScaled(dt*_b(s), k[s]);
+			if( _e(s) != 0 )
+				err.AddScaled(dt*_e(s), k[s]);
+		}
+		return true;
+	}
+
+	FP Epsilon(const V& yn, const V& ynew, const V& err) const {
+		FP sum = 0;
+		for( long i = 0; i < N; i++ )
+			sum += sqr(err[i]/(std::max(fabs(yn[i]), fabs(ynew[i]))*_rTol + _aTol));
+		return sqrt(sum/N);
+	}
+
+public:
+	FixedSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : FixedSizeSolver(params, method, ivp, N) {
+		_fixedIvp = static_cast<I*>(ivp);
+	}
+
+	virtual void RunSimulation() {
+		V y(_yn), ynew, err;
+		V k[FIXED_MAX_STAGES];
+
+		WriteFile(0);
+
+		_timer.Start();
+		while( !_complete ) {
+			do {
+				CheckMaxSteps();
+
+				if( _tn + _dt*_stretch >= _tf ) {
+					_complete = true;
+					_dt = _tf - _tn;
+				}
+
+				if( _printTime )
+					std::cout << "tn = " << _tn << " dt = " << _dt << std::endl;
+
+				bool converged = Step(_tn, _dt, y, k, ynew, err);
+				_steps++;
+
+				if( !converged || ynew.IsNan() ) {
+					Reject(true);
+					continue;
+				}
+
+				_eps = _embedded ? Epsilon(y, ynew, err) : 0;
+				if( _eps <= 1 ) {
+					y = ynew;
+					Accept();
+				} else {
+					Reject(false);
+				}
+			} while( _rejectStep );
+
+			y.CopyTo(_yn);
+			WriteFile(_acceptedSteps);
+		}
+		_timer.End();
+	}
+};
+
+#endif
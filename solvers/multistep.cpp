@@ -0,0 +1,104 @@
+#include <solvers/multistep.h>
+
+MultistepSolver::MultistepSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : StepControlSolver(params, method, ivp) {
+	_multistep = dynamic_cast<NordsieckMethod*>(method);
+	if( !_multistep )
+		throw Exception() << "Multistep solver requires a multistep method (BDF or Adams).";
+
+	_multistep->SetAutoOrder(false);
+	_failures = 0;
+}
+
+void MultistepSolver::Failure() {
+	// Start again from order one after repeated failures
+	if( ++_failures >= 3 )
+		_multistep->ForceRestart();
+}
+
+void MultistepSolver::AcceptMultistepStep() {
+	if( CheckMethodReject() ) {
+		Failure();
+		return;
+	}
+
+	_rejectStep = false;
+	_failures = 0;
+	UpdateTimestep();
+	_epsLast = _eps;
+	_dtOld = _dt;
+	_acceptedSteps++;
+
+	if( _multistep->ConstantSteps() <= _multistep->GetOrder() )
+		return;
+
+	FP factor;
+	long order = _multistep->SelectOrder(factor);
+
+	// Not worth disturbing the history for less than a 10% larger step
+	if( factor > 1/FP(1.1) )
+		return;
+
+	_multistep->SetOrder(order);
+	_dt /= std::max(factor, 1/_maxChange);
+}
+
+void MultistepSolver::RejectMultistepStep() {
+	if( CheckMethodReject() ) {
+		Failure();
+		return;
+	}
+
+	_rejectStep = true;
+	_complete = false;
+	_rejectedSteps++;
+
+	long q = _multistep->GetOrder();
+	FP factor = 1.2*pow(_eps, FP(1)/(q+1));
+
+	// A lower order is considered on every failure, as the top columns of the
+	// history can be left holding noise that no smaller step gets rid of
+	Failure();
+	if( _failures >= 3 ) {
+		factor = 1/_minChange;
+	} else if( q > 1 ) {
+		FP down = 1.3*pow(_multistep->ErrorEstimate(q-1), FP(1)/q) + 1e-6;
+		if( down < factor ) {
+			factor = down;
+			_multistep->SetOrder(q-1);
+		}
+	}
+
+	_dt /= std::min(1/_minChange, std::max(factor, 1/_maxRejectedChange));
+}
+
+void MultistepSolver::RunSimulation() {
+	WriteFile(0);
+
+	_timer.Start();
+	while( !_complete ) {
+		do {
+			CheckMaxSteps();
+
+			_method->SetAccept(true);
+			_method->PreStep(_tn, _dt, _yn);
+			if( FinalStep() )
+				_complete = true;
+
+			if( _printTime )
+				std::cout << "tn = " << _tn << " dt = " << _dt << " q = " << _multistep->GetOrder() << std::endl;
+
+			_method->Step(_tn, _dt, _yn, _ynew);
+			_method->PostStep(_tn, _dt, _yn);
+			_eps = _method->CalcEpsilon(_tn, _dt, _yn, _ynew, _aTol, _rTol);
+			_eps <= 1 ? AcceptMultistepStep() : RejectMultistepStep();
+			_steps++;
+		} while( _rejectStep );
+
+		WriteFile(_acceptedSteps);
+	}
+	_timer.End();
+}
+
+const char* MultistepSolver::GetName() const {
+	return "Multistep Solver";
+}
@@ -0,0 +1,28 @@
+#ifndef MULTISTEP_SOLVER_H
+#define MULTISTEP_SOLVER_H
+
+#include <core/common.h>
+#include <methods/nordsieck.h>
+#include <solvers/basesolver.h>
+
+// Step size and order control for the Nordsieck multistep methods (BDF and
+// Adams). Once q+1 steps have been taken with the same step size and order,
+// the step that the error estimates at orders q-1, q and q+1 allow is compared
+// and the largest one is taken.
+class MultistepSolver : public StepControlSolver {
+protected:
+	NordsieckMethod* _multistep;
+	long _failures;
+
+	void Failure();
+	void AcceptMultistepStep();
+	void RejectMultistepStep();
+
+public:
+	MultistepSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+
+	virtual void RunSimulation();
+	virtual const char* GetName() const;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include <solvers/parareal.h>
+#include <limits>
+
+BaseMethod* AllocMethod(Hash<ParamValue>& params, BaseIVP* ivp);
+BaseIVP* AllocIVP(Hash<ParamValue>& params);
+BaseSolver* AllocSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+
+PararealSolver::Propagator::Propagator(Hash<ParamValue>& base, const char* methodName, const char* solverName, FP dt) : params(base) {
+	if( std::string(solverName) == "PararealSolver" )
+		throw Exception() << "Parareal propagators cannot themselves be Parareal solvers.";
+
+	params["method"].SetString(methodName);
+	params["solver"].SetString(solverName);
+	params["dt"].SetFP(dt);
+
+	if( !(ivp = AllocIVP(params)) )
+		throw Exception() << "IVP class " << params["ivp"].GetString() << " is not defined.";
+	ivp->InitializeDerivatives();
+	method = AllocMethod(params, ivp);
+	solver = AllocSolver(params, method, ivp);
+}
+
+PararealSolver::Propagator::~Propagator() {
+	delete solver;
+	delete method;
+	delete ivp;
+}
+
+PararealSolver::PararealSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : BaseSolver(params, method, ivp) {
+	if( _outputDt > 0 )
+		throw Exception() << "Parareal solver does not support dense output.";
+	if( _eventCount )
+		throw Exception() << "Parareal solver does not support events.";
+
+	_pool = new ThreadPool(GetDefaultLong(params, "threads", 0));
+	_slices = GetDefaultLong(params, "parareal slices", _pool->Size());
+	_maxIterations = GetDefaultLong(params, "parareal iterations", _slices);
+	_tol = GetDefaultFP(params, "parareal tol", GetDefaultFP(params, "rtol", 1e-5));
+	if( _slices < 1 )
+		throw Exception() << "parareal slices must be at least one.";
+
+	FP slice = (_tf - _tn)/_slices;
+	std::string fineMethod = params["method"].GetString();
+	std::string fineSolver = GetDefaultString(params, "fine solver", "EmbeddedSolver");
+	std::string coarseMethod = GetDefaultString(params, "coarse method", "BackwardEuler");
+	std::string coarseSolver = GetDefaultString(params, "coarse solver", "ConstantSolver");
+
+	// An adaptive coarse solver is given its own, looser tolerances
+	Hash<ParamValue> coarseParams(params);
+	if( params.Get("coarse rtol") )
+		coarseParams["rtol"].SetFP(params["coarse rtol"].GetFP());
+	if( params.Get("coarse atol") )
+		coarseParams["atol"].SetFP(params["coarse atol"].GetFP());
+
+	// A single coarse step per slice is too inaccurate for the correction to
+	// converge on most problems, so the default takes ten
+	_coarse = new Propagator(coarseParams, coarseMethod.c_str(), coarseSolver.c_str(), GetDefaultFP(params, "coarse dt", slice/PARAREAL_COARSE_STEPS));
+	for( long w = 0; w < std::min(_pool->Size(), _slices); w++ )
+		_fine.push_back(new Propagator(params, fineMethod.c_str(), fineSolver.c_str(), _dt));
+
+	_iterations = 0;
+	_coarseSteps = 0;
+	_fineSteps = 0;
+	_sliceTime.assign(_slices, 0);
+}
+
+PararealSolver::~PararealSolver() {
+	delete _coarse;
+	for( size_t w = 0; w < _fine.size(); w++ )
+		delete _fine[w];
+	delete _pool;
+}
+
+void PararealSolver::RunSimulation() {
+	long n = _yn.Size();
+	long workers = _fine.size();
+	std::vector<FP> t(_slices+1);
+	std::vector< Vec<FP> > u(_slices+1, Vec<FP>(n));
+	std::vector< Vec<FP> > g(_slices, Vec<FP>(n));
+	std::vector< Vec<FP> > f(_slices, Vec<FP>(n));
+	std::vector<long> fineSteps(_slices, 0);
+	Vec<FP> gnew(n), unew(n);
+	FP lastChange = 0;
+	long growing = 0;
+
+	for( long i = 0; i <= _slices; i++ )
+		t[i] = i == _slices ? _tf : _tn + i*(_tf - _tn)/_slices;
+
+	_timer.Start();
+
+	// The initial guess is a coarse integration
+	u[0] = _yn;
+	for( long i = 0; i < _slices; i++ ) {
+		_coarseSteps += _coarse->solver->Propagate(t[i], t[i+1], u[i], g[i]);
+		u[i+1] = g[i];
+		if( !(u[i+1].Norm() < std::numeric_limits<FP>::infinity()) )
+			throw Exception() << "The coarse propagator produced non-finite values on slice " << i << "; choose another -coarse method or a smaller -coarse dt.";
+	}
+
+	for( long k = 1; k <= _maxIterations; k++ ) {
+		// Slices before k-1 start from exact values and are not run again
+		long first = k-1;
+		try {
+			_pool->ParallelFor(workers, [&](long w) {
+				for( long i = first + w; i < _slices; i += workers ) {
+					Timer timer;
+					fineSteps[i] = _fine[w]->solver->Propagate(t[i], t[i+1], u[i], f[i]);
+					_sliceTime[i] = timer.msec();
+				}
+			});
+		} catch(Exception e) {
+			// Usually the coarse corrections have diverged and handed the
+			// fine propagator slice boundary values it cannot integrate from
+			throw Exception() << "Parareal iteration " << k << " failed in the fine propagator (" << e.operator std::string() << "); reduce -coarse dt if the iteration diverged.";
+		}
+		for( long i = first; i < _slices; i++ )
+			_fineSteps += fineSteps[i];
+		_iterations = k;
+
+		FP change = 0;
+		for( long i = first; i < _slices; i++ ) {
+			_coarseSteps += _coarse->solver->Propagate(t[i], t[i+1], u[i], gnew);
+			unew = gnew;
+			unew += f[i];
+			unew -= g[i];
+			g[i] = gnew;
+
+			// The correction diverges when the coarse propagator is too poor
+			// an approximation of the fine one, and the fine propagations of
+			// the next iteration would then start from meaningless values
+			FP sliceChange = ((unew - u[i+1])/StepControlSolver::GetTolerances(u[i+1], unew, _tol, _tol)).RMS();
+			if( !(sliceChange < std::numeric_limits<FP>::infinity()) )
+				throw Exception() << "Parareal iteration " << k << " produced non-finite values on slice " << i << "; reduce -coarse dt.";
+			change = std::max(change, sliceChange);
+			u[i+1] = unew;
+		}
+
+		if( change <= 1 )
+			break;
+
+		growing = k > 1 && change > lastChange ? growing + 1 : 0;
+		if( growing >= PARAREAL_MAX_GROWTH )
+			throw Exception() << "Parareal iteration diverged: the slice boundary values changed more in each of the last " << growing << " iterations; reduce -coarse dt.";
+		lastChange = change;
+	}
+
+	_timer.End();
+
+	for( long i = 0; i <= _slices; i++ ) {
+		_tn = t[i];
+		_yn = u[i];
+		_complete = i == _slices;
+		WriteFile(i);
+	}
+	_steps = _fineSteps;
+	_acceptedSteps = _slices;
+}
+
+void PararealSolver::DumpRunInfo(Hash<ParamValue>& params) {
+	FP serial = 0;
+	for( long i = 0; i < _slices; i++ )
+		serial += _sliceTime[i];
+
+	params["parareal slices"].SetLong(_slices);
+	params["parareal iterations"].SetLong(_iterations);
+	params["threads"].SetLong(_fine.size());
+	params["coarse steps"].SetLong(_coarseSteps);
+	params["fine steps"].SetLong(_fineSteps);
+	params["serial fine time"].SetFP(serial);
+	params["parareal speedup"].SetFP(_timer.msec() > 0 ? serial/_timer.msec() : 0);
+
+	BaseSolver::DumpRunInfo(params);
+}
+
+const char* PararealSolver::GetName() const {
+	return "Parareal Solver";
+}
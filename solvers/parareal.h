@@ -0,0 +1,59 @@
+#ifndef PARAREAL_SOLVER_H
+#define PARAREAL_SOLVER_H
+
+#include <core/common.h>
+#include <core/threadpool.h>
+#include <solvers/basesolver.h>
+
+#define PARAREAL_COARSE_STEPS 10
+#define PARAREAL_MAX_GROWTH 2
+
+// Parallel in time integration. [tn, tf] is split into slices, and every
+// iteration propagates the current slice boundary values with the fine method
+// on all slices at once, then sweeps the cheap coarse propagator through them
+//
+//	U_i+1 = G(U_i) + F(U_i^old) - G(U_i^old)
+//
+// until the boundary values stop changing. After k iterations the first k
+// slices are exact, so at most as many iterations as slices are taken. Every
+// thread owns its own IVP, method and solver, so nothing is shared between
+// the fine propagations.
+class PararealSolver : public BaseSolver {
+protected:
+	struct Propagator {
+		Hash<ParamValue> params;
+		BaseIVP* ivp;
+		BaseMethod* method;
+		BaseSolver* solver;
+
+		Propagator(Hash<ParamValue>& base, const char* method, const char* solver, FP dt);
+		~Propagator();
+	};
+
+	long _slices;
+	long _maxIterations;
+	FP _tol;
+	ThreadPool* _pool;
+
+	Propagator* _coarse;
+	std::vector<Propagator*> _fine;
+
+	// Stats
+	long _iterations;
+	long _coarseSteps;
+	long _fineSteps;
+
+	// Time of the latest fine propagation of every slice, which add up to
+	// the time of a serial fine integration
+	std::vector<FP> _sliceTime;
+
+public:
+	PararealSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp);
+	virtual ~PararealSolver();
+
+	virtual void DumpRunInfo(Hash<ParamValue>& params);
+	virtual void RunSimulation();
+	virtual const char* GetName() const;
+};
+
+#endif
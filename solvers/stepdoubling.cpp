@@ -1,6 +1,11 @@
 #include <solvers/stepdoubling.h>
 
 StepDoublingSolver::StepDoublingSolver(Hash<ParamValue>& params, BaseMethod* method, BaseIVP* ivp) : StepControlSolver(params, method, ivp) {
+	if( _outputDt > 0 )
+		throw Exception() << "Step doubling solver does not support dense output.";
+	if( _eventCount )
+		throw Exception() << "Step doubling solver does not support events.";
+
 	_ystep2.Resize(_yn.Size());
 }
 